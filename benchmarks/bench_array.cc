@@ -0,0 +1,98 @@
+#include <sp/array.h>
+
+#include <array>
+#include <cstdint>
+
+#include "bench_helpers.h"
+
+// Array has no size changing operations, so whole-array ones are measured
+//  instead. Size is part of array type, items processed are its elements
+
+template <typename Array>
+Array make_array() {
+  using value_type = typename Array::value_type;
+  Array result;
+  for (int64_t i = 0; i < static_cast<int64_t>(result.size()); ++i) {
+    result[i] = make_value<value_type>(i);
+  }
+  return result;
+}
+
+template <typename Array>
+void BM_array_copy(benchmark::State& state) {
+  const Array source = make_array<Array>();
+  for (auto _ : state) {
+    Array copy(source);
+    benchmark::DoNotOptimize(&copy);
+  }
+  state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+// Compares every element with a value, so that each one is read
+template <typename Array>
+void BM_array_iterate(benchmark::State& state) {
+  using value_type = typename Array::value_type;
+  const Array arr = make_array<Array>();
+  const value_type sample = make_value<value_type>(-1);
+  for (auto _ : state) {
+    for (const auto& value : arr) {
+      benchmark::DoNotOptimize(value == sample);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * arr.size());
+}
+
+template <typename Array>
+void BM_array_fill(benchmark::State& state) {
+  using value_type = typename Array::value_type;
+  Array arr;
+  const value_type value = make_value<value_type>(7);
+  for (auto _ : state) {
+    arr.fill(value);
+    benchmark::DoNotOptimize(&arr);
+  }
+  state.SetItemsProcessed(state.iterations() * arr.size());
+}
+
+template <typename Array>
+void BM_array_swap(benchmark::State& state) {
+  Array lhs = make_array<Array>();
+  Array rhs = make_array<Array>();
+  for (auto _ : state) {
+    lhs.swap(rhs);
+    benchmark::DoNotOptimize(&lhs);
+    benchmark::DoNotOptimize(&rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * lhs.size());
+}
+
+template <typename Array>
+void BM_array_equal(benchmark::State& state) {
+  const Array lhs = make_array<Array>();
+  const Array rhs = make_array<Array>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+  state.SetItemsProcessed(state.iterations() * lhs.size());
+}
+
+// Registers benchmark bm for std:: and sp:: arrays of every copyable element
+//  type, see SP_BENCHMARK_COPYABLE
+#define SP_BENCHMARK_ARRAYS(bm, size)                      \
+  BENCHMARK_TEMPLATE(bm, std::array<int, size>);           \
+  BENCHMARK_TEMPLATE(bm, sp::array<int, size>);            \
+  BENCHMARK_TEMPLATE(bm, std::array<full, size>);          \
+  BENCHMARK_TEMPLATE(bm, sp::array<full, size>);           \
+  BENCHMARK_TEMPLATE(bm, std::array<copy_only, size>);     \
+  BENCHMARK_TEMPLATE(bm, sp::array<copy_only, size>);
+
+SP_BENCHMARK_ARRAYS(BM_array_copy, 64)
+SP_BENCHMARK_ARRAYS(BM_array_copy, 4096)
+SP_BENCHMARK_ARRAYS(BM_array_iterate, 64)
+SP_BENCHMARK_ARRAYS(BM_array_iterate, 4096)
+SP_BENCHMARK_ARRAYS(BM_array_fill, 64)
+SP_BENCHMARK_ARRAYS(BM_array_fill, 4096)
+SP_BENCHMARK_ARRAYS(BM_array_swap, 64)
+SP_BENCHMARK_ARRAYS(BM_array_swap, 4096)
+SP_BENCHMARK_ARRAYS(BM_array_equal, 64)
+SP_BENCHMARK_ARRAYS(BM_array_equal, 4096)
@@ -0,0 +1,58 @@
+#ifndef SP_BENCHMARKS_BENCH_HELPERS_H_
+#define SP_BENCHMARKS_BENCH_HELPERS_H_
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "test_helpers.h"  // tclass, traits
+
+// Element types benchmarked besides int, taken from tclass trait matrix of
+//  tests/standart/test_helpers.h
+using full = tclass<traits::Full>;
+using copy_only = tclass<traits::DefaultInsertable |
+                         traits::CopyInsertable | traits::CopyAssignable>;
+using move_only = tclass<traits::DefaultInsertable |
+                         traits::MoveInsertable | traits::MoveAssignable>;
+
+// Distinct value for index, short enough for tclass names to stay in SSO
+template <typename T>
+T make_value(int64_t index) {
+  if constexpr (std::is_arithmetic<T>::value) {
+    return static_cast<T>(index);
+  } else {
+    return T(std::to_string(index % 1000));
+  }
+}
+
+// Container of count distinct values built by push_back
+template <typename Container>
+Container make_container(int64_t count) {
+  using value_type = typename Container::value_type;
+  Container result;
+  for (int64_t i = 0; i < count; ++i) {
+    result.push_back(make_value<value_type>(i));
+  }
+  return result;
+}
+
+// Registers benchmark bm for std:: and sp:: container of every element type,
+//  so that they are reported side by side. Args are appended to each
+//  registration, e.g. ->Range(8, 4096)
+#define SP_BENCHMARK_CONTAINERS(bm, container, args)        \
+  SP_BENCHMARK_COPYABLE(bm, container, args)                \
+  BENCHMARK_TEMPLATE(bm, std::container<move_only>) args;   \
+  BENCHMARK_TEMPLATE(bm, sp::container<move_only>) args;
+
+// Same as SP_BENCHMARK_CONTAINERS for copyable element types only
+#define SP_BENCHMARK_COPYABLE(bm, container, args)          \
+  BENCHMARK_TEMPLATE(bm, std::container<int>) args;         \
+  BENCHMARK_TEMPLATE(bm, sp::container<int>) args;          \
+  BENCHMARK_TEMPLATE(bm, std::container<full>) args;        \
+  BENCHMARK_TEMPLATE(bm, sp::container<full>) args;         \
+  BENCHMARK_TEMPLATE(bm, std::container<copy_only>) args;   \
+  BENCHMARK_TEMPLATE(bm, sp::container<copy_only>) args;
+
+#endif  // SP_BENCHMARKS_BENCH_HELPERS_H_
@@ -0,0 +1,12 @@
+#include <sp/list.h>
+
+#include <list>
+
+#include "sequence_benchmarks.h"
+
+SP_BENCHMARK_CONTAINERS(BM_push_back, list, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_insert, list, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_erase, list, ->Range(8, 1 << 16))
+SP_BENCHMARK_COPYABLE(BM_copy, list, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_iterate, list, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_clear, list, ->Range(8, 1 << 16))
@@ -0,0 +1,13 @@
+#include <sp/vector.h>
+
+#include <vector>
+
+#include "sequence_benchmarks.h"
+
+// Middle insertion and erasure shift half of vector, so sizes are kept small
+SP_BENCHMARK_CONTAINERS(BM_push_back, vector, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_insert, vector, ->Range(8, 1 << 12))
+SP_BENCHMARK_CONTAINERS(BM_erase, vector, ->Range(8, 1 << 12))
+SP_BENCHMARK_COPYABLE(BM_copy, vector, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_iterate, vector, ->Range(8, 1 << 16))
+SP_BENCHMARK_CONTAINERS(BM_clear, vector, ->Range(8, 1 << 16))
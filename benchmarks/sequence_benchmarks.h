@@ -0,0 +1,98 @@
+#ifndef SP_BENCHMARKS_SEQUENCE_BENCHMARKS_H_
+#define SP_BENCHMARKS_SEQUENCE_BENCHMARKS_H_
+
+#include <cstdint>
+#include <iterator>
+
+#include "bench_helpers.h"
+
+// Operations shared by sequence containers, parameterized by container type
+//  and by element count passed as state.range(0)
+
+template <typename Container>
+void BM_push_back(benchmark::State& state) {
+  using value_type = typename Container::value_type;
+  for (auto _ : state) {
+    Container cont;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      cont.push_back(make_value<value_type>(i));
+    }
+    benchmark::DoNotOptimize(&cont);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Inserts every element in front of the middle one
+template <typename Container>
+void BM_insert(benchmark::State& state) {
+  using value_type = typename Container::value_type;
+  for (auto _ : state) {
+    Container cont;
+    auto pos = cont.end();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      pos = cont.insert(pos, make_value<value_type>(i));
+      if (i % 2) {
+        ++pos;
+      }
+    }
+    benchmark::DoNotOptimize(&cont);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Erases elements one by one from the middle of container
+template <typename Container>
+void BM_erase(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container cont = make_container<Container>(state.range(0));
+    auto pos = std::next(cont.begin(), state.range(0) / 2);
+    state.ResumeTiming();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      pos = cont.erase(pos);
+      if (pos != cont.begin() && (i % 2 || pos == cont.end())) {
+        --pos;
+      }
+    }
+    benchmark::DoNotOptimize(&cont);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_copy(benchmark::State& state) {
+  const Container source = make_container<Container>(state.range(0));
+  for (auto _ : state) {
+    Container copy(source);
+    benchmark::DoNotOptimize(&copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Compares every element with a value, so that each one is read
+template <typename Container>
+void BM_iterate(benchmark::State& state) {
+  using value_type = typename Container::value_type;
+  const Container cont = make_container<Container>(state.range(0));
+  const value_type sample = make_value<value_type>(-1);
+  for (auto _ : state) {
+    for (const auto& value : cont) {
+      benchmark::DoNotOptimize(value == sample);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_clear(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container cont = make_container<Container>(state.range(0));
+    state.ResumeTiming();
+    cont.clear();
+    benchmark::DoNotOptimize(&cont);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#endif  // SP_BENCHMARKS_SEQUENCE_BENCHMARKS_H_
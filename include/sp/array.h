@@ -7,6 +7,7 @@
 #include <utility>  // std::forward, std::move, std::swap
 #include <type_traits>  // as name suggests
 
+#include <sp/bulk_algorithms.h>
 #include <sp/pointer_iterator.h> // iterator and std::distance
 #include <sp/reverse_iterator.h>
 
@@ -82,15 +83,29 @@ struct array {
     return const_reverse_iterator(elements - 1);
   }
 
+  // Trivially copyable elements are filled by bulk kernel at runtime
   constexpr void fill(const_reference value) noexcept(
       std::is_nothrow_copy_assignable<T>::value) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (!std::is_constant_evaluated()) {
+        sp::bulk_fill(elements, N, value);
+        return;
+      }
+    }
     for (size_type i = 0; i < N; ++i) {
       elements[i] = value;
     }
   }
 
+  // Trivially copyable elements are swapped block-wise at runtime
   constexpr void swap(array& other) noexcept(
       std::is_nothrow_swappable<T>::value) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (!std::is_constant_evaluated()) {
+        sp::bulk_swap(elements, other.elements, N);
+        return;
+      }
+    }
     for (size_type i = 0; i < N; ++i) {
       std::swap(elements[i], other.elements[i]);
     }
@@ -98,12 +113,36 @@ struct array {
 
   constexpr reference operator[](size_type i) { return elements[i]; }
   constexpr const_reference operator[](size_type i) const { return elements[i]; }
+  // Arithmetic and bitwise comparable elements are compared by bulk
+  //  kernel at runtime
   constexpr bool operator==(const array& other) const {
+    if constexpr (std::is_arithmetic<T>::value ||
+                  sp::is_bitwise_comparable<T>::value) {
+      if (!std::is_constant_evaluated()) {
+        return sp::bulk_equal(elements, other.elements, N);
+      }
+    }
     for (size_type i = 0; i < N; ++i)
       if (elements[i] != other.elements[i]) return false;
     return true;
   }
 
+  // Index of the first element differing from the one in other, N if
+  //  arrays are equal
+  constexpr size_type mismatch(const array& other) const {
+    if constexpr (std::is_arithmetic<T>::value ||
+                  sp::is_bitwise_comparable<T>::value) {
+      if (!std::is_constant_evaluated()) {
+        return sp::bulk_mismatch(elements, other.elements, N);
+      }
+    }
+    size_type pos = 0;
+    while (pos < N && elements[pos] == other.elements[pos]) {
+      ++pos;
+    }
+    return pos;
+  }
+
   friend std::ostream& operator<<(std::ostream& os, const array& array) {
     for (size_type i = 0; i < N - 1; ++i) os << array.elements[i] << ' ';
     os << array.elements[N - 1];
@@ -183,6 +222,11 @@ struct array<T, 0> {
     return true;
   }
 
+  constexpr size_type mismatch(const array& other) const {
+    (void)other;
+    return 0;
+  }
+
   friend std::ostream& operator<<(std::ostream& os,
                                   const array& array) noexcept {
     (void)array;
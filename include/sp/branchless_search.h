@@ -0,0 +1,38 @@
+#ifndef SP_CONTAINERS_BRANCHLESS_SEARCH_H_
+#define SP_CONTAINERS_BRANCHLESS_SEARCH_H_
+
+namespace sp {
+// Binary searches over sorted random access ranges, halving the range
+// unconditionally and moving its start by a select rather than a branch,
+// so that compilers emit conditional moves and the loop never mispredicts.
+// Each step compares with the middle element and keeps the half where
+// bound may be, about log2(n) comparisons as in std::lower_bound
+
+// First element of [first, last) not less than key
+template <typename RandomIt, typename K, typename Compare>
+RandomIt branchless_lower_bound(RandomIt first, RandomIt last, const K& key,
+                                Compare comp) {
+  auto length = last - first;
+  while (length > 0) {
+    auto half = length / 2;
+    first += comp(first[half], key) ? length - half : 0;
+    length = half;
+  }
+  return first;
+}
+
+// First element of [first, last) greater than key
+template <typename RandomIt, typename K, typename Compare>
+RandomIt branchless_upper_bound(RandomIt first, RandomIt last, const K& key,
+                                Compare comp) {
+  auto length = last - first;
+  while (length > 0) {
+    auto half = length / 2;
+    first += comp(key, first[half]) ? 0 : length - half;
+    length = half;
+  }
+  return first;
+}
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_BRANCHLESS_SEARCH_H_
@@ -0,0 +1,956 @@
+#ifndef SP_CONTAINERS_BTREE_H_
+#define SP_CONTAINERS_BTREE_H_
+
+#include <algorithm>    // std::max
+#include <cstddef>      // std::ptrdiff_t
+#include <cstdint>      // int64_t, uint16_t
+#include <cstring>      // std::memcpy, std::memmove
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <memory>       // std::allocator_traits
+#include <new>          // placement new, std::launder
+#include <type_traits>  // as name suggests
+#include <utility>      // std::forward, std::move, std::pair, std::swap
+
+#include <sp/key_of_value.h>
+#include <sp/type_traits.h>  // sp::is_trivially_relocatable
+
+namespace sp {
+// B-tree of values with unique keys, engine of sp::btree_map and
+// sp::btree_set. Values are kept sorted in arrays inside nodes of about
+// kNodeBytes bytes, so lookup touches a few cache lines per level instead
+// of one node per comparison.
+// Any insertion or erasure invalidates all iterators
+// Value type must meet requirements of Erasable and be nothrow movable,
+//  keys of maps are moved between slots as non-const
+// KeyOfValue must return reference to key of given value
+// Compare must induce strict weak ordering on keys, lookup methods accept
+//  any type Compare can compare with keys
+// Allocator type must meet requirements of Allocator
+// Methods may have additional requirements on types
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Compare, typename Allocator>
+class btree {
+  struct Node;
+  struct InternalNode;
+
+  using slot_type = typename sp::mutable_value<Value>::type;
+
+  static_assert(sp::is_trivially_relocatable<Value>::value ||
+                    std::is_nothrow_move_constructible<slot_type>::value,
+                "Values must be nothrow movable");
+
+ public:
+  template <typename U>
+  class BtreeIterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using reference = Value&;
+  using const_reference = const Value&;
+  using size_type = int64_t;
+  using key_compare = Compare;
+
+  using allocator_type = Allocator;
+  using al_traits = std::allocator_traits<allocator_type>;
+
+  using iterator = BtreeIterator<Value>;
+  using const_iterator = BtreeIterator<const Value>;
+
+  // Four 64 byte cache lines
+  static constexpr int kNodeBytes = 256;
+  // Values in node
+  static constexpr int kSlots = std::max<int>(
+      3, (kNodeBytes - 2 * sizeof(void*)) / sizeof(Value));
+  // Values in any node except root
+  static constexpr int kMinSlots = (kSlots - 1) / 2;
+
+  static_assert(kSlots <= UINT16_MAX, "Node counters must hold kSlots");
+
+  // Position where value with given key is or should be placed
+  struct position {
+    Node* node;  // node holding equivalent key or leaf for new value
+    int index;   // slot in node
+    bool found;
+  };
+
+  // Bidirectional iterator over values in order of keys
+  template <typename U>
+  class BtreeIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_const_t<U>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = U*;
+    using reference = U&;
+
+    BtreeIterator() noexcept : node_(nullptr), index_(0) {}
+
+    BtreeIterator(Node* node, int index) noexcept
+        : node_(node), index_(index) {}
+
+    operator BtreeIterator<const U>() const noexcept
+      requires(!std::is_const<U>::value)
+    {
+      return BtreeIterator<const U>(node_, index_);
+    }
+
+    reference operator*() const noexcept { return *node_->slot(index_); }
+    pointer operator->() const noexcept { return node_->slot(index_); }
+
+    BtreeIterator& operator++() noexcept {
+      if (!node_->leaf) {
+        node_ = node_->child(index_ + 1);
+        while (!node_->leaf) {
+          node_ = node_->child(0);
+        }
+        index_ = 0;
+        return *this;
+      }
+      if (++index_ < node_->count) {
+        return *this;
+      }
+      // climbs to first ancestor with values right of the subtree, past
+      // the last value stays at the end of rightmost leaf
+      Node* node = node_;
+      int index = index_;
+      while (index == node->count && node->parent) {
+        index = node->position;
+        node = node->parent;
+      }
+      if (index < node->count) {
+        node_ = node;
+        index_ = index;
+      }
+      return *this;
+    }
+
+    BtreeIterator operator++(int) noexcept {
+      BtreeIterator temp(*this);
+      ++*this;
+      return temp;
+    }
+
+    BtreeIterator& operator--() noexcept {
+      if (!node_->leaf) {
+        node_ = node_->child(index_);
+        while (!node_->leaf) {
+          node_ = node_->child(node_->count);
+        }
+        index_ = node_->count - 1;
+        return *this;
+      }
+      while (!index_ && node_->parent) {
+        index_ = node_->position;
+        node_ = node_->parent;
+      }
+      --index_;
+      return *this;
+    }
+
+    BtreeIterator operator--(int) noexcept {
+      BtreeIterator temp(*this);
+      --*this;
+      return temp;
+    }
+
+    bool operator==(const BtreeIterator& other) const noexcept {
+      return node_ == other.node_ && index_ == other.index_;
+    }
+
+   private:
+    friend class btree;
+
+    Node* node_;
+    int index_;
+  };
+
+  btree() = default;
+
+  explicit btree(const Compare& comp, const Allocator& al = Allocator())
+      : al_(al), comp_(comp) {}
+
+  btree(const btree& other, const Allocator& al)
+      : al_(al), comp_(other.comp_) {
+    copy_from(other);
+  }
+
+  btree(const btree& other)
+      : btree(other, al_traits::select_on_container_copy_construction(
+                         other.al_)) {}
+
+  btree(btree&& other) noexcept
+      : al_(std::move(other.al_)), comp_(other.comp_) {
+    swap_content(other);
+  }
+
+  btree(btree&& other, const Allocator& al) : al_(al), comp_(other.comp_) {
+    if (al_ == other.al_) {
+      swap_content(other);
+    } else {
+      move_from(other);
+    }
+  }
+
+  btree& operator=(const btree& other) {
+    if (this != &other) {
+      clear();
+      if constexpr (al_traits::propagate_on_container_copy_assignment::value) {
+        al_ = other.al_;
+      }
+      comp_ = other.comp_;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  btree& operator=(btree&& other) noexcept(
+      al_traits::propagate_on_container_move_assignment::value ||
+      al_traits::is_always_equal::value) {
+    if (this != &other) {
+      clear();
+      comp_ = other.comp_;
+      if constexpr (al_traits::propagate_on_container_move_assignment::value) {
+        al_ = std::move(other.al_);
+        swap_content(other);
+      } else if (al_ == other.al_) {
+        swap_content(other);
+      } else {
+        move_from(other);
+      }
+    }
+    return *this;
+  }
+
+  ~btree() { clear(); }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept { return al_; }
+
+  key_compare key_comp() const { return comp_; }
+
+  iterator begin() noexcept { return iterator(leftmost_, 0); }
+  const_iterator begin() const noexcept {
+    return const_iterator(leftmost_, 0);
+  }
+
+  iterator end() noexcept {
+    return iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+  }
+
+  bool empty() const noexcept { return !size_; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept { return al_traits::max_size(al_); }
+  //============================================================================
+
+  // Checks links, occupancy and depth of nodes, order and size
+  bool integrity() const {
+    if (!root_) {
+      return !size_ && !leftmost_ && !rightmost_;
+    }
+    const Node* leftmost = root_;
+    const Node* rightmost = root_;
+    while (!leftmost->leaf) {
+      leftmost = leftmost->child(0);
+      rightmost = rightmost->child(rightmost->count);
+    }
+    if (root_->parent || !root_->count || leftmost != leftmost_ ||
+        rightmost != rightmost_ || subtree_height(root_) < 0) {
+      return false;
+    }
+    size_type count = 0;
+    for (auto pos = begin(); pos != end(); ++pos, ++count) {
+      if (count && !comp_(key_of(*std::prev(pos)), key_of(*pos))) {
+        return false;
+      }
+    }
+    return count == size_;
+  }
+
+  // Releases all nodes
+  void clear() noexcept {
+    if (root_) {
+      destroy_subtree(root_);
+    }
+    root_ = nullptr;
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+  }
+
+  // Finds where value with key equivalent to key is or should be placed
+  template <typename K>
+  position find_position(const K& key) const {
+    for (Node* node = root_; node;) {
+      int index = node_lower_bound(node, key);
+      if (index < node->count && !comp_(key, key_of(*node->slot(index)))) {
+        return {node, index, true};
+      }
+      if (node->leaf) {
+        return {node, index, false};
+      }
+      node = node->child(index);
+    }
+    return {nullptr, 0, false};
+  }
+
+  // Places value constructed from args at pos, which must be obtained by
+  //  find_position with key of the new value and have no value found
+  // Value must meet additional requirements of EmplaceConstructible from
+  //  args
+  template <typename... Args>
+  iterator emplace_at(position pos, Args&&... args) {
+    auto [node, index] = open_slot(pos);
+    try {
+      al_traits::construct(al_, node->slot(index),
+                           std::forward<Args>(args)...);
+    } catch (...) {
+      close_slot(node, index);
+      throw;
+    }
+    ++size_;
+    return iterator(node, index);
+  }
+
+  // Value must meet additional requirements of EmplaceConstructible from
+  //  args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_unique(Args&&... args) {
+    alignas(Value) unsigned char buffer[sizeof(Value)];
+    Value* value = reinterpret_cast<Value*>(buffer);
+    al_traits::construct(al_, value, std::forward<Args>(args)...);
+    try {
+      position pos = find_position(KeyOfValue()(*value));
+      if (pos.found) {
+        al_traits::destroy(al_, value);
+        return {iterator(pos.node, pos.index), false};
+      }
+      auto [node, index] = open_slot(pos);
+      relocate(node->slot(index), value);
+      ++size_;
+      return {iterator(node, index), true};
+    } catch (...) {
+      al_traits::destroy(al_, value);
+      throw;
+    }
+  }
+
+  // Value must meet additional requirements of CopyInsertable into *this
+  std::pair<iterator, bool> insert_unique(const value_type& value) {
+    position pos = find_position(KeyOfValue()(value));
+    if (pos.found) {
+      return {iterator(pos.node, pos.index), false};
+    }
+    return {emplace_at(pos, value), true};
+  }
+
+  // Value must meet additional requirements of MoveInsertable into *this
+  std::pair<iterator, bool> insert_unique(value_type&& value) {
+    position pos = find_position(KeyOfValue()(value));
+    if (pos.found) {
+      return {iterator(pos.node, pos.index), false};
+    }
+    return {emplace_at(pos, std::move(value)), true};
+  }
+
+  // Returns iterator to value following erased one
+  iterator erase(const_iterator pos) noexcept {
+    Node* node = pos.node_;
+    int index = pos.index_;
+    al_traits::destroy(al_, node->slot(index));
+    bool internal = !node->leaf;
+    if (internal) {
+      // predecessor from leaf takes place of erased value
+      Node* leaf = node->child(index);
+      while (!leaf->leaf) {
+        leaf = leaf->child(leaf->count);
+      }
+      relocate(node->slot(index), leaf->slot(leaf->count - 1));
+      node = leaf;
+      index = --leaf->count;
+    } else {
+      shift_slots(node, index + 1, node->count, -1);
+      --node->count;
+    }
+    --size_;
+    iterator next = rebalance(node, index);
+    if (internal) {
+      // next points to predecessor now
+      ++next;
+    }
+    return next;
+  }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    if (first == begin() && last == end()) {
+      clear();
+      return end();
+    }
+    size_type count = 0;
+    for (const_iterator pos = first; pos != last; ++pos) {
+      ++count;
+    }
+    iterator pos(first.node_, first.index_);
+    while (count--) {
+      pos = erase(pos);
+    }
+    return pos;
+  }
+
+  // Erases element with key equivalent to key, returns number of erased
+  template <typename K>
+  size_type erase_key(const K& key) {
+    position pos = find_position(key);
+    if (!pos.found) {
+      return 0;
+    }
+    erase(const_iterator(pos.node, pos.index));
+    return 1;
+  }
+
+  void swap(btree& other) noexcept(
+      al_traits::propagate_on_container_swap::value ||
+      al_traits::is_always_equal::value) {
+    using std::swap;
+    if constexpr (al_traits::propagate_on_container_swap::value) {
+      swap(al_, other.al_);
+    }
+    swap(comp_, other.comp_);
+    swap_content(other);
+  }
+
+  template <typename K>
+  iterator find(const K& key) {
+    position pos = find_position(key);
+    return pos.found ? iterator(pos.node, pos.index) : end();
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    position pos = find_position(key);
+    return pos.found ? const_iterator(pos.node, pos.index) : end();
+  }
+
+  template <typename K>
+  bool contains(const K& key) const {
+    return find_position(key).found;
+  }
+
+  // First element with key not less than key
+  template <typename K>
+  iterator lower_bound(const K& key) {
+    return bound(key, [this](const K& k, Node* node) {
+      return node_lower_bound(node, k);
+    });
+  }
+
+  template <typename K>
+  const_iterator lower_bound(const K& key) const {
+    return const_cast<btree*>(this)->lower_bound(key);
+  }
+
+  // First element with key greater than key
+  template <typename K>
+  iterator upper_bound(const K& key) {
+    return bound(key, [this](const K& k, Node* node) {
+      return node_upper_bound(node, k);
+    });
+  }
+
+  template <typename K>
+  const_iterator upper_bound(const K& key) const {
+    return const_cast<btree*>(this)->upper_bound(key);
+  }
+
+ private:
+  // Leaf node, values are constructed only in first count slots
+  struct Node {
+    Value* slot(int index) noexcept {
+      return std::launder(reinterpret_cast<Value*>(storage)) + index;
+    }
+
+    const Value* slot(int index) const noexcept {
+      return const_cast<Node*>(this)->slot(index);
+    }
+
+    Node* child(int index) const noexcept {
+      return static_cast<const InternalNode*>(this)->children[index];
+    }
+
+    InternalNode* parent;
+    uint16_t position;  // index of node among children of parent
+    uint16_t count;
+    bool leaf;
+    alignas(Value) unsigned char storage[kSlots * sizeof(Value)];
+  };
+
+  // Node with count + 1 children, values of i-th child are between
+  // values in slots i - 1 and i
+  struct InternalNode : public Node {
+    Node* children[kSlots + 1];
+  };
+
+  using leaf_alloc =
+      typename al_traits::template rebind_alloc<Node>;
+  using leaf_traits = std::allocator_traits<leaf_alloc>;
+  using internal_alloc =
+      typename al_traits::template rebind_alloc<InternalNode>;
+  using internal_traits = std::allocator_traits<internal_alloc>;
+
+  // Values may be dropped along with their nodes without visiting them
+  static constexpr bool kTrivialDrop =
+      std::is_trivially_destructible<Value>::value &&
+      !requires(Allocator& al, Value* p) { al.destroy(p); };
+
+  static const Key& key_of(const Value& value) noexcept {
+    return KeyOfValue()(value);
+  }
+
+  template <typename K>
+  int node_lower_bound(const Node* node, const K& key) const {
+    int first = 0;
+    int last = node->count;
+    while (first < last) {
+      int mid = (first + last) / 2;
+      if (comp_(key_of(*node->slot(mid)), key)) {
+        first = mid + 1;
+      } else {
+        last = mid;
+      }
+    }
+    return first;
+  }
+
+  template <typename K>
+  int node_upper_bound(const Node* node, const K& key) const {
+    int first = 0;
+    int last = node->count;
+    while (first < last) {
+      int mid = (first + last) / 2;
+      if (comp_(key, key_of(*node->slot(mid)))) {
+        last = mid;
+      } else {
+        first = mid + 1;
+      }
+    }
+    return first;
+  }
+
+  // Bound within the deepest node having one is the bound of the tree
+  template <typename K, typename NodeBound>
+  iterator bound(const K& key, NodeBound node_bound) {
+    iterator result = end();
+    for (Node* node = root_; node;) {
+      int index = node_bound(key, node);
+      if (index < node->count) {
+        result = iterator(node, index);
+      }
+      if (node->leaf) {
+        break;
+      }
+      node = node->child(index);
+    }
+    return result;
+  }
+
+  Node* make_leaf(InternalNode* parent, int position) {
+    leaf_alloc al(al_);
+    Node* node = ::new (static_cast<void*>(leaf_traits::allocate(al, 1))) Node;
+    node->parent = parent;
+    node->position = position;
+    node->count = 0;
+    node->leaf = true;
+    return node;
+  }
+
+  InternalNode* make_internal(InternalNode* parent, int position) {
+    internal_alloc al(al_);
+    InternalNode* node = ::new (static_cast<void*>(
+        internal_traits::allocate(al, 1))) InternalNode;
+    node->parent = parent;
+    node->position = position;
+    node->count = 0;
+    node->leaf = false;
+    return node;
+  }
+
+  // Empty node of the same kind as node
+  Node* make_sibling(const Node* node, InternalNode* parent, int position) {
+    return node->leaf ? make_leaf(parent, position)
+                      : make_internal(parent, position);
+  }
+
+  // Frees node without touching its values
+  void drop_node(Node* node) noexcept {
+    if (node->leaf) {
+      leaf_alloc al(al_);
+      leaf_traits::deallocate(al, node, 1);
+    } else {
+      internal_alloc al(al_);
+      internal_traits::deallocate(al, static_cast<InternalNode*>(node), 1);
+    }
+  }
+
+  // Recursion depth is height of the tree, that is logarithm of size with
+  // base kSlots / 2
+  void destroy_subtree(Node* node) noexcept {
+    if (!node->leaf) {
+      for (int i = 0; i <= node->count; ++i) {
+        destroy_subtree(node->child(i));
+      }
+    }
+    if constexpr (!kTrivialDrop) {
+      for (int i = 0; i < node->count; ++i) {
+        al_traits::destroy(al_, node->slot(i));
+      }
+    }
+    drop_node(node);
+  }
+
+  // Moves value to uninitialized dest, ending lifetime of the source
+  void relocate(Value* dest, Value* src) noexcept {
+    if constexpr (sp::is_trivially_relocatable<Value>::value) {
+      std::memcpy(static_cast<void*>(dest), static_cast<void*>(src),
+                  sizeof(Value));
+    } else {
+      al_traits::construct(al_, dest,
+                           std::move(*reinterpret_cast<slot_type*>(src)));
+      al_traits::destroy(al_, src);
+    }
+  }
+
+  // Relocates values in slots [first, last) of node by offset
+  void shift_slots(Node* node, int first, int last, int offset) noexcept {
+    if constexpr (sp::is_trivially_relocatable<Value>::value) {
+      std::memmove(static_cast<void*>(node->slot(first + offset)),
+                   static_cast<void*>(node->slot(first)),
+                   (last - first) * sizeof(Value));
+    } else if (offset > 0) {
+      for (int i = last - 1; i >= first; --i) {
+        relocate(node->slot(i + offset), node->slot(i));
+      }
+    } else {
+      for (int i = first; i < last; ++i) {
+        relocate(node->slot(i + offset), node->slot(i));
+      }
+    }
+  }
+
+  // Moves children [first, last) of node by offset, fixing their positions
+  static void shift_children(InternalNode* node, int first, int last,
+                             int offset) noexcept {
+    std::memmove(node->children + first + offset, node->children + first,
+                 (last - first) * sizeof(Node*));
+    for (int i = first + offset; i < last + offset; ++i) {
+      node->children[i]->position = i;
+    }
+  }
+
+  // Moves count children of src starting from src_first to dest
+  static void move_children(InternalNode* dest, int dest_first,
+                            InternalNode* src, int src_first,
+                            int count) noexcept {
+    for (int i = 0; i < count; ++i) {
+      Node* child = src->children[src_first + i];
+      dest->children[dest_first + i] = child;
+      child->parent = dest;
+      child->position = dest_first + i;
+    }
+  }
+
+  // Frees slot for new value at pos, splitting full nodes on the way up.
+  // Returns node and index of the uninitialized slot, already counted
+  std::pair<Node*, int> open_slot(position pos) {
+    Node* node = pos.node;
+    int index = pos.index;
+    if (!node) {
+      node = make_leaf(nullptr, 0);
+      root_ = node;
+      leftmost_ = node;
+      rightmost_ = node;
+    }
+    if (node->count == kSlots) {
+      split(node);
+      if (index > node->count) {
+        index -= node->count + 1;
+        node = node->parent->children[node->position + 1];
+      }
+    }
+    shift_slots(node, index, node->count, 1);
+    ++node->count;
+    return {node, index};
+  }
+
+  // Takes back slot opened by open_slot, when value failed to construct
+  void close_slot(Node* node, int index) noexcept {
+    shift_slots(node, index + 1, node->count, -1);
+    if (!--node->count && node == root_) {
+      drop_node(node);
+      root_ = nullptr;
+      leftmost_ = nullptr;
+      rightmost_ = nullptr;
+    }
+  }
+
+  // Moves upper half of full node to new right sibling and its median
+  // to parent, splitting parent first if it is full too. Tree stays valid
+  // if allocation of new nodes throws
+  void split(Node* node) {
+    InternalNode* parent = node->parent;
+    Node* right = nullptr;
+    if (!parent) {
+      parent = make_internal(nullptr, 0);
+      try {
+        right = make_sibling(node, parent, 1);
+      } catch (...) {
+        drop_node(parent);
+        throw;
+      }
+      parent->children[0] = node;
+      node->parent = parent;
+      node->position = 0;
+      root_ = parent;
+    } else {
+      if (parent->count == kSlots) {
+        split(parent);
+        parent = node->parent;
+      }
+      right = make_sibling(node, parent, node->position + 1);
+    }
+    int position = node->position;
+    int left_count = kSlots / 2;
+    int right_count = kSlots - left_count - 1;
+
+    shift_slots(parent, position, parent->count, 1);
+    shift_children(parent, position + 1, parent->count + 1, 1);
+    relocate(parent->slot(position), node->slot(left_count));
+    parent->children[position + 1] = right;
+    ++parent->count;
+
+    for (int i = 0; i < right_count; ++i) {
+      relocate(right->slot(i), node->slot(left_count + 1 + i));
+    }
+    if (!node->leaf) {
+      move_children(static_cast<InternalNode*>(right), 0,
+                    static_cast<InternalNode*>(node), left_count + 1,
+                    right_count + 1);
+    }
+    node->count = left_count;
+    right->count = right_count;
+    if (node == rightmost_) {
+      rightmost_ = right;
+    }
+  }
+
+  // Restores occupancy of nodes after erasure left leaf with count values.
+  // Returns iterator to slot index of leaf, following values moved by
+  // rebalancing, or to next value if it is past the end of the leaf
+  iterator rebalance(Node* leaf, int index) noexcept {
+    Node* tracked = leaf;
+    for (Node* node = leaf; node != root_ && node->count < kMinSlots;) {
+      InternalNode* parent = node->parent;
+      int position = node->position;
+      Node* left = position ? parent->children[position - 1] : nullptr;
+      Node* right =
+          position < parent->count ? parent->children[position + 1] : nullptr;
+      if (left && left->count > kMinSlots) {
+        rotate_right(left, node);
+        if (tracked == node) {
+          ++index;
+        }
+        break;
+      }
+      if (right && right->count > kMinSlots) {
+        rotate_left(node, right);
+        break;
+      }
+      if (left) {
+        if (tracked == node) {
+          tracked = left;
+          index += left->count + 1;
+        }
+        merge(left, node);
+      } else {
+        merge(node, right);
+      }
+      node = parent;
+    }
+
+    if (!root_->count) {
+      Node* old_root = root_;
+      if (old_root->leaf) {
+        root_ = nullptr;
+        leftmost_ = nullptr;
+        rightmost_ = nullptr;
+        tracked = nullptr;
+      } else {
+        root_ = old_root->child(0);
+        root_->parent = nullptr;
+        root_->position = 0;
+      }
+      drop_node(old_root);
+    }
+    if (!tracked) {
+      return end();
+    }
+    iterator pos(tracked, index);
+    if (index == tracked->count) {
+      // resumes increment of last value in the node
+      --pos.index_;
+      ++pos;
+    }
+    return pos;
+  }
+
+  // Moves last value of left through parent to the front of node
+  void rotate_right(Node* left, Node* node) noexcept {
+    InternalNode* parent = node->parent;
+    int position = node->position;
+    shift_slots(node, 0, node->count, 1);
+    relocate(node->slot(0), parent->slot(position - 1));
+    relocate(parent->slot(position - 1), left->slot(left->count - 1));
+    if (!node->leaf) {
+      auto* internal = static_cast<InternalNode*>(node);
+      shift_children(internal, 0, node->count + 1, 1);
+      move_children(internal, 0, static_cast<InternalNode*>(left),
+                    left->count, 1);
+    }
+    --left->count;
+    ++node->count;
+  }
+
+  // Moves first value of right through parent to the end of node
+  void rotate_left(Node* node, Node* right) noexcept {
+    InternalNode* parent = node->parent;
+    int position = node->position;
+    relocate(node->slot(node->count), parent->slot(position));
+    relocate(parent->slot(position), right->slot(0));
+    shift_slots(right, 1, right->count, -1);
+    if (!node->leaf) {
+      auto* internal = static_cast<InternalNode*>(right);
+      move_children(static_cast<InternalNode*>(node), node->count + 1,
+                    internal, 0, 1);
+      shift_children(internal, 1, right->count + 1, -1);
+    }
+    ++node->count;
+    --right->count;
+  }
+
+  // Appends separator from parent and values of right to left, right is
+  // freed
+  void merge(Node* left, Node* right) noexcept {
+    InternalNode* parent = left->parent;
+    int position = left->position;
+    relocate(left->slot(left->count), parent->slot(position));
+    for (int i = 0; i < right->count; ++i) {
+      relocate(left->slot(left->count + 1 + i), right->slot(i));
+    }
+    if (!left->leaf) {
+      move_children(static_cast<InternalNode*>(left), left->count + 1,
+                    static_cast<InternalNode*>(right), 0, right->count + 1);
+    }
+    left->count += right->count + 1;
+
+    shift_slots(parent, position + 1, parent->count, -1);
+    shift_children(parent, position + 2, parent->count + 1, -1);
+    --parent->count;
+    if (right == rightmost_) {
+      rightmost_ = left;
+    }
+    drop_node(right);
+  }
+
+  // Copies values and shape of subtree
+  Node* clone_subtree(const Node* src, InternalNode* parent) {
+    Node* node = src->leaf ? make_leaf(parent, src->position)
+                           : make_internal(parent, src->position);
+    int children = 0;
+    try {
+      for (; node->count < src->count; ++node->count) {
+        al_traits::construct(al_, node->slot(node->count),
+                             *src->slot(node->count));
+      }
+      if (!src->leaf) {
+        auto* internal = static_cast<InternalNode*>(node);
+        for (; children <= src->count; ++children) {
+          internal->children[children] =
+              clone_subtree(src->child(children), internal);
+        }
+      }
+    } catch (...) {
+      for (int i = 0; i < children; ++i) {
+        destroy_subtree(node->child(i));
+      }
+      for (int i = 0; i < node->count; ++i) {
+        al_traits::destroy(al_, node->slot(i));
+      }
+      drop_node(node);
+      throw;
+    }
+    return node;
+  }
+
+  // *this must be empty
+  void copy_from(const btree& other) {
+    if (!other.root_) {
+      return;
+    }
+    root_ = clone_subtree(other.root_, nullptr);
+    leftmost_ = root_;
+    rightmost_ = root_;
+    while (!leftmost_->leaf) {
+      leftmost_ = leftmost_->child(0);
+      rightmost_ = rightmost_->child(rightmost_->count);
+    }
+    size_ = other.size_;
+  }
+
+  // *this must be empty
+  void move_from(btree& other) {
+    for (auto& value : other) {
+      emplace_unique(std::move(value));
+    }
+  }
+
+  void swap_content(btree& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
+    std::swap(size_, other.size_);
+  }
+
+  // Returns height of subtree or -1 if it is broken
+  int subtree_height(const Node* node) const {
+    if (node->count > kSlots || (node != root_ && node->count < kMinSlots)) {
+      return -1;
+    }
+    if (node->leaf) {
+      return 0;
+    }
+    int height = -1;
+    for (int i = 0; i <= node->count; ++i) {
+      const Node* child = node->child(i);
+      if (child->parent != node || child->position != i) {
+        return -1;
+      }
+      int child_height = subtree_height(child);
+      if (child_height < 0 || (i && child_height != height)) {
+        return -1;
+      }
+      height = child_height;
+    }
+    return height + 1;
+  }
+
+  [[no_unique_address]] Allocator al_;
+  [[no_unique_address]] Compare comp_;
+  Node* root_ = nullptr;
+  Node* leftmost_ = nullptr;
+  Node* rightmost_ = nullptr;
+  size_type size_ = 0;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_BTREE_H_
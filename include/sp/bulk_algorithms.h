@@ -0,0 +1,120 @@
+#ifndef SP_CONTAINERS_BULK_ALGORITHMS_H_
+#define SP_CONTAINERS_BULK_ALGORITHMS_H_
+
+#include <cstddef>      // std::byte
+#include <cstdint>      // int64_t
+#include <cstring>      // std::memcmp, std::memcpy, std::memset
+#include <type_traits>  // as name suggests
+
+#include <sp/type_traits.h>  // sp::is_bitwise_comparable
+
+namespace sp {
+// Kernels over runs of trivially copyable elements, shaped so that they
+//  lower to library memory routines or to loops compilers vectorize.
+//  Containers use them at runtime and keep element-wise loops for other
+//  types and constant evaluation
+
+// Bytes processed per step by block kernels, a few vector registers wide
+inline constexpr int64_t kBulkBlockSize = 256;
+
+// Assigns value to count elements from first. Values made of one repeated
+//  byte, e.g. zeroes, are stored with memset, others with a plain loop
+//  which compilers turn into broadcast stores
+// T must be trivially copyable
+template <typename T>
+void bulk_fill(T* first, int64_t count, const T& value) noexcept {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Bulk fill works on trivially copyable types");
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  bool repeated = true;
+  for (std::size_t i = 1; i < sizeof(T); ++i) {
+    repeated &= bytes[i] == bytes[0];
+  }
+  if (repeated) {
+    if (count > 0) {
+      std::memset(static_cast<void*>(first), bytes[0], count * sizeof(T));
+    }
+    return;
+  }
+  for (int64_t i = 0; i < count; ++i) {
+    first[i] = value;
+  }
+}
+
+// Exchanges count elements of two non-overlapping runs block by block
+//  through a buffer on stack, swapping a run with itself does nothing
+// T must be trivially copyable
+template <typename T>
+void bulk_swap(T* lhs, T* rhs, int64_t count) noexcept {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Bulk swap works on trivially copyable types");
+  if (lhs == rhs) {
+    return;
+  }
+  std::byte* left = reinterpret_cast<std::byte*>(lhs);
+  std::byte* right = reinterpret_cast<std::byte*>(rhs);
+  int64_t bytes = count * sizeof(T);
+  std::byte buffer[kBulkBlockSize];
+  for (; bytes >= kBulkBlockSize; bytes -= kBulkBlockSize) {
+    std::memcpy(buffer, left, kBulkBlockSize);
+    std::memcpy(left, right, kBulkBlockSize);
+    std::memcpy(right, buffer, kBulkBlockSize);
+    left += kBulkBlockSize;
+    right += kBulkBlockSize;
+  }
+  std::memcpy(buffer, left, bytes);
+  std::memcpy(left, right, bytes);
+  std::memcpy(right, buffer, bytes);
+}
+
+// Index of the first of count elements that differ, count if none does.
+//  Bitwise comparable elements are compared with memcmp, other arithmetic
+//  ones a block at a time without branching inside the block, so a
+//  mismatch is looked for element-wise only in the block holding it
+// T must be arithmetic or bitwise comparable
+template <typename T>
+int64_t bulk_mismatch(const T* lhs, const T* rhs, int64_t count) noexcept {
+  static_assert(std::is_arithmetic<T>::value ||
+                    sp::is_bitwise_comparable<T>::value,
+                "Bulk mismatch works on arithmetic or bitwise comparable "
+                "types");
+  constexpr int64_t kBlock = kBulkBlockSize / sizeof(T) > 0
+                                 ? kBulkBlockSize / sizeof(T)
+                                 : 1;
+  int64_t pos = 0;
+  for (; pos + kBlock <= count; pos += kBlock) {
+    bool differ = false;
+    if constexpr (sp::is_bitwise_comparable<T>::value) {
+      differ = std::memcmp(lhs + pos, rhs + pos, kBlock * sizeof(T)) != 0;
+    } else {
+      for (int64_t i = pos; i < pos + kBlock; ++i) {
+        differ |= !(lhs[i] == rhs[i]);
+      }
+    }
+    if (differ) {
+      break;
+    }
+  }
+  for (; pos < count; ++pos) {
+    if (!(lhs[pos] == rhs[pos])) {
+      break;
+    }
+  }
+  return pos;
+}
+
+// Whether count elements of two runs are equal
+// T must be arithmetic or bitwise comparable
+template <typename T>
+bool bulk_equal(const T* lhs, const T* rhs, int64_t count) noexcept {
+  if constexpr (sp::is_bitwise_comparable<T>::value) {
+    return count == 0 ||
+           std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+  } else {
+    return sp::bulk_mismatch(lhs, rhs, count) == count;
+  }
+}
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_BULK_ALGORITHMS_H_
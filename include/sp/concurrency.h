@@ -0,0 +1,44 @@
+#ifndef SP_CONTAINERS_CONCURRENCY_H_
+#define SP_CONTAINERS_CONCURRENCY_H_
+
+#include <cstddef>  // std::size_t
+#include <thread>   // std::this_thread::yield
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SP_CONTAINERS_CONCURRENCY_PAUSE_
+#include <emmintrin.h>
+#endif
+
+namespace sp {
+// Alignment separating data written by different threads. Fixed rather
+// than std::hardware_destructive_interference_size, whose value may differ
+// between translation units compiled for different targets
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// Busy waiting for another thread, spins briefly and then yields the core
+class spin_wait {
+ public:
+  void wait() noexcept {
+    if (spins_ < kSpinLimit) {
+      ++spins_;
+#ifdef SP_CONTAINERS_CONCURRENCY_PAUSE_
+      _mm_pause();
+#endif
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  void reset() noexcept { spins_ = 0; }
+
+ private:
+  static constexpr int kSpinLimit = 64;
+
+  int spins_ = 0;
+};
+}  // namespace sp
+
+#undef SP_CONTAINERS_CONCURRENCY_PAUSE_
+
+#endif  // SP_CONTAINERS_CONCURRENCY_H_
@@ -0,0 +1,125 @@
+#ifndef SP_CONTAINERS_CONTAINER_STATS_H_
+#define SP_CONTAINERS_CONTAINER_STATS_H_
+
+#include <atomic>   // std::atomic
+#include <cstdint>  // int64_t
+
+#ifdef SP_CONTAINERS_STATS
+#include <mutex>        // std::mutex, std::lock_guard
+#include <string_view>  // std::string_view
+#include <type_traits>  // std::is_constant_evaluated
+#include <typeinfo>     // typeid
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+#endif
+
+namespace sp {
+// Containers record what they do into stats shared by all objects of the
+//  same container type. Recording is enabled by defining SP_CONTAINERS_STATS
+//  before including any sp header, otherwise it is compiled away
+// The macro must be set the same way for the whole program: containers have
+//  the same names in both modes, so linking translation units built with
+//  and without it keeps only one of the definitions
+// Counters are updated with relaxed atomics, so they may be read while
+//  containers of the type are used from other threads
+struct container_stats {
+  // Buffers allocated, their total size and those that replaced a buffer
+  std::atomic<int64_t> allocations = 0;
+  std::atomic<int64_t> allocated_bytes = 0;
+  std::atomic<int64_t> reallocations = 0;
+  // Bytes allocated beyond what was required, by growth policy or allocator
+  std::atomic<int64_t> wasted_bytes = 0;
+
+  // Elements move or copy constructed and destroyed
+  std::atomic<int64_t> moves = 0;
+  std::atomic<int64_t> copies = 0;
+  std::atomic<int64_t> destructions = 0;
+
+  // Nodes of node based containers
+  std::atomic<int64_t> node_allocations = 0;
+  std::atomic<int64_t> node_deallocations = 0;
+
+  void reset() noexcept {
+    for (std::atomic<int64_t>* counter :
+         {&allocations, &allocated_bytes, &reallocations, &wasted_bytes,
+          &moves, &copies, &destructions, &node_allocations,
+          &node_deallocations}) {
+      counter->store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+#ifdef SP_CONTAINERS_STATS
+inline constexpr bool kStatsEnabled = true;
+
+// Stats of every container type that recorded anything, named by typeid
+class stats_registry {
+ public:
+  using entry = std::pair<std::string_view, container_stats*>;
+
+  static stats_registry& instance() {
+    static stats_registry registry;
+    return registry;
+  }
+
+  // Copy of entries in order of registration
+  std::vector<entry> entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_;
+  }
+
+  // Resets stats of every registered type
+  void reset() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const entry& item : entries_) {
+      item.second->reset();
+    }
+  }
+
+  void add(std::string_view name, container_stats* stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.emplace_back(name, stats);
+  }
+
+ private:
+  stats_registry() = default;
+
+  mutable std::mutex mutex_;
+  std::vector<entry> entries_;
+};
+
+// Stats of Container type, registered on first use
+template <typename Container>
+container_stats& stats_of() {
+  static container_stats& stats = []() -> container_stats& {
+    static container_stats storage;
+    stats_registry::instance().add(typeid(Container).name(), &storage);
+    return storage;
+  }();
+  return stats;
+}
+
+// Adds amount to counter of Container stats. Does nothing during constant
+//  evaluation
+template <typename Container>
+constexpr void record_stat(std::atomic<int64_t> container_stats::*counter,
+                           int64_t amount = 1) noexcept {
+  if (!std::is_constant_evaluated()) {
+    (stats_of<Container>().*counter)
+        .fetch_add(amount, std::memory_order_relaxed);
+  }
+}
+#else
+inline constexpr bool kStatsEnabled = false;
+
+// Stats are disabled, recording does nothing
+template <typename Container>
+constexpr void record_stat(std::atomic<int64_t> container_stats::*counter,
+                           int64_t amount = 1) noexcept {
+  (void)counter;
+  (void)amount;
+}
+#endif
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_CONTAINER_STATS_H_
@@ -0,0 +1,48 @@
+#ifndef SP_CONTAINERS_DEFAULT_INIT_ALLOCATOR_H_
+#define SP_CONTAINERS_DEFAULT_INIT_ALLOCATOR_H_
+
+#include <memory>       // std::allocator, std::allocator_traits
+#include <new>          // placement new
+#include <type_traits>  // as name suggests
+
+namespace sp {
+// Allocator adaptor which default initializes elements constructed without
+//  arguments instead of value initializing them, so containers of trivial
+//  types, e.g. I/O buffers, leave such elements uninitialized. Constructions
+//  with arguments are left to std::allocator_traits
+// Allocator type must meet requirements of Allocator and must not provide
+//  construct
+template <typename T, typename Allocator = std::allocator<T>>
+class default_init_allocator : public Allocator {
+  using base_traits = std::allocator_traits<Allocator>;
+
+  static_assert(!requires(Allocator& al, T* ptr) { al.construct(ptr); },
+                "Adapted allocator must not provide its own construct");
+
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = default_init_allocator<
+        U, typename base_traits::template rebind_alloc<U>>;
+  };
+
+  using Allocator::Allocator;
+
+  default_init_allocator() = default;
+
+  template <typename U, typename OtherAllocator>
+  default_init_allocator(
+      const default_init_allocator<U, OtherAllocator>& other) noexcept
+      : Allocator(static_cast<const OtherAllocator&>(other)) {}
+
+  template <typename U>
+  void construct(U* ptr) noexcept(
+      std::is_nothrow_default_constructible<U>::value) {
+    ::new (static_cast<void*>(ptr)) U;
+  }
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_DEFAULT_INIT_ALLOCATOR_H_
@@ -0,0 +1,556 @@
+#ifndef SP_CONTAINERS_DEQUE_H_
+#define SP_CONTAINERS_DEQUE_H_
+
+#include <algorithm>         // std::max
+#include <bit>               // std::bit_ceil
+#include <compare>           // operator<=>
+#include <cstdint>           // int64_t
+#include <cstring>           // std::memcpy
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::random_access_iterator_tag
+#include <memory>            // std::allocator, std::allocator_traits
+#include <stdexcept>         // std::out_of_range
+#include <type_traits>       // as name suggests
+#include <utility>           // std::forward, std::move, std::swap
+
+#include <sp/type_traits.h>  // sp::is_trivially_relocatable
+
+namespace sp {
+// Double-ended queue over a growable ring buffer. Elements live in one
+//  array of power of two capacity, wrapping around its end, so pushing
+//  and popping at both ends is amortized O(1) without allocating per
+//  element, and iteration walks at most two contiguous runs
+// Any growth invalidates all iterators and references, pops invalidate
+//  only popped ones
+// T type must meet requirements of Erasable
+// Allocator type must meet requirements of Allocator
+// Methods may have additional requirements on types
+template <typename T, typename Allocator = std::allocator<T>>
+class deque {
+  using al_traits = std::allocator_traits<Allocator>;
+
+ public:
+  template <typename U>
+  class DequeIterator;
+
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = int64_t;
+  using difference_type = int64_t;
+
+  using allocator_type = Allocator;
+
+  using iterator = DequeIterator<T>;
+  using const_iterator = DequeIterator<const T>;
+
+  // Capacity of the first allocation
+  static constexpr size_type kMinCapacity = 8;
+
+  // Random access iterator, keeps position unwrapped and masks it on access
+  template <typename U>
+  class DequeIterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<U>;
+    using difference_type = int64_t;
+    using pointer = U*;
+    using reference = U&;
+
+    DequeIterator() noexcept : buf_(nullptr), mask_(0), pos_(0) {}
+
+    DequeIterator(U* buf, size_type mask, size_type pos) noexcept
+        : buf_(buf), mask_(mask), pos_(pos) {}
+
+    operator DequeIterator<const U>() const noexcept
+      requires(!std::is_const<U>::value)
+    {
+      return DequeIterator<const U>(buf_, mask_, pos_);
+    }
+
+    reference operator*() const noexcept { return buf_[pos_ & mask_]; }
+    pointer operator->() const noexcept { return buf_ + (pos_ & mask_); }
+    reference operator[](difference_type n) const noexcept {
+      return buf_[(pos_ + n) & mask_];
+    }
+
+    DequeIterator& operator++() noexcept {
+      ++pos_;
+      return *this;
+    }
+
+    DequeIterator operator++(int) noexcept {
+      DequeIterator temp(*this);
+      ++pos_;
+      return temp;
+    }
+
+    DequeIterator& operator--() noexcept {
+      --pos_;
+      return *this;
+    }
+
+    DequeIterator operator--(int) noexcept {
+      DequeIterator temp(*this);
+      --pos_;
+      return temp;
+    }
+
+    DequeIterator& operator+=(difference_type n) noexcept {
+      pos_ += n;
+      return *this;
+    }
+
+    DequeIterator& operator-=(difference_type n) noexcept {
+      pos_ -= n;
+      return *this;
+    }
+
+    DequeIterator operator+(difference_type n) const noexcept {
+      return DequeIterator(buf_, mask_, pos_ + n);
+    }
+
+    friend DequeIterator operator+(difference_type n,
+                                   const DequeIterator& pos) noexcept {
+      return pos + n;
+    }
+
+    DequeIterator operator-(difference_type n) const noexcept {
+      return DequeIterator(buf_, mask_, pos_ - n);
+    }
+
+    // Friends, so that iterators mix with const ones through conversion
+    friend difference_type operator-(const DequeIterator& lhs,
+                                     const DequeIterator& rhs) noexcept {
+      return lhs.pos_ - rhs.pos_;
+    }
+
+    friend bool operator==(const DequeIterator& lhs,
+                           const DequeIterator& rhs) noexcept {
+      return lhs.pos_ == rhs.pos_;
+    }
+
+    friend auto operator<=>(const DequeIterator& lhs,
+                            const DequeIterator& rhs) noexcept {
+      return lhs.pos_ <=> rhs.pos_;
+    }
+
+   private:
+    U* buf_;
+    size_type mask_;
+    size_type pos_;
+  };
+
+  deque() noexcept(std::is_nothrow_default_constructible<Allocator>::value) =
+      default;
+
+  // Other constructors delegate here, so that destructor cleans up after
+  //  a throwing element
+  explicit deque(const Allocator& al) noexcept : al_(al) {}
+
+  // T must meet additional requirements of DefaultInsertable into *this
+  explicit deque(size_type count, const Allocator& al = Allocator())
+      : deque(al) {
+    resize(count);
+  }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  deque(size_type count, const_reference value,
+        const Allocator& al = Allocator())
+      : deque(al) {
+    resize(count, value);
+  }
+
+  // T must meet additional requirements of EmplaceConstructible from
+  //  *first
+  template <typename InputIterator>
+  deque(InputIterator first, InputIterator last,
+        const Allocator& al = Allocator())
+      : deque(al) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  deque(std::initializer_list<T> vals, const Allocator& al = Allocator())
+      : deque(vals.begin(), vals.end(), al) {}
+
+  // T must meet additional requirements of CopyInsertable into *this
+  deque(const deque& other, const Allocator& al) : deque(al) {
+    reserve(other.size_);
+    for (const_reference value : other) {
+      emplace_back(value);
+    }
+  }
+
+  deque(const deque& other)
+      : deque(other, al_traits::select_on_container_copy_construction(
+                         other.al_)) {}
+
+  deque(deque&& other) noexcept : al_(std::move(other.al_)) {
+    swap_content(other);
+  }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  deque(deque&& other, const Allocator& al) : deque(al) {
+    if (al_ == other.al_) {
+      swap_content(other);
+    } else {
+      move_from(other);
+    }
+  }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  deque& operator=(const deque& other) {
+    if (this != &other) {
+      clear();
+      if constexpr (al_traits::propagate_on_container_copy_assignment::value) {
+        if (al_ != other.al_) {
+          release();
+        }
+        al_ = other.al_;
+      }
+      reserve(other.size_);
+      for (const_reference value : other) {
+        emplace_back(value);
+      }
+    }
+    return *this;
+  }
+
+  // T must meet additional requirements of MoveInsertable into *this, if
+  //  allocators neither propagate nor compare equal
+  deque& operator=(deque&& other) noexcept(
+      al_traits::propagate_on_container_move_assignment::value ||
+      al_traits::is_always_equal::value) {
+    if (this != &other) {
+      release();
+      if constexpr (al_traits::propagate_on_container_move_assignment::value) {
+        al_ = std::move(other.al_);
+        swap_content(other);
+      } else if (al_ == other.al_) {
+        swap_content(other);
+      } else {
+        move_from(other);
+      }
+    }
+    return *this;
+  }
+
+  deque& operator=(std::initializer_list<T> vals) {
+    clear();
+    reserve(vals.size());
+    for (const_reference value : vals) {
+      emplace_back(value);
+    }
+    return *this;
+  }
+
+  ~deque() { release(); }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept { return al_; }
+
+  reference at(size_type pos) {
+    if (pos < 0 || pos >= size_) {
+      throw std::out_of_range("Index is out of deque range");
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const {
+    if (pos < 0 || pos >= size_) {
+      throw std::out_of_range("Index is out of deque range");
+    }
+    return (*this)[pos];
+  }
+
+  reference operator[](size_type index) noexcept { return *slot(index); }
+  const_reference operator[](size_type index) const noexcept {
+    return *slot(index);
+  }
+
+  reference front() noexcept { return *slot(0); }
+  const_reference front() const noexcept { return *slot(0); }
+
+  reference back() noexcept { return *slot(size_ - 1); }
+  const_reference back() const noexcept { return *slot(size_ - 1); }
+
+  iterator begin() noexcept { return iterator(buf_, cap_ - 1, head_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(buf_, cap_ - 1, head_);
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  iterator end() noexcept { return iterator(buf_, cap_ - 1, head_ + size_); }
+  const_iterator end() const noexcept {
+    return const_iterator(buf_, cap_ - 1, head_ + size_);
+  }
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return !size_; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return cap_; }
+  size_type max_size() const noexcept { return al_traits::max_size(al_); }
+  //============================================================================
+
+  // Makes room for count elements, capacity is rounded up to power of two
+  // T must meet additional requirements of MoveInsertable into *this
+  void reserve(size_type count) {
+    if (count > cap_) {
+      reallocate(std::bit_ceil(static_cast<uint64_t>(count)));
+    }
+  }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  void shrink_to_fit() {
+    if (!size_) {
+      release();
+    } else if (std::bit_ceil(static_cast<uint64_t>(size_)) < uint64_t(cap_)) {
+      reallocate(std::bit_ceil(static_cast<uint64_t>(size_)));
+    }
+  }
+
+  // Destroys all elements, keeping the buffer
+  void clear() noexcept {
+    destroy_content();
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // T must meet additional requirements of DefaultInsertable and
+  //  MoveInsertable into *this
+  void resize(size_type count) {
+    reserve(count);
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      emplace_back();
+    }
+  }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  void resize(size_type count, const_reference value) {
+    reserve(count);
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      emplace_back(value);
+    }
+  }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  void push_back(const_reference value) { emplace_back(value); }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  void push_front(const_reference value) { emplace_front(value); }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  void push_front(value_type&& value) { emplace_front(std::move(value)); }
+
+  // Strong exception guarantee, args may refer to elements of *this
+  // T must meet additional requirements of EmplaceConstructible from args
+  //  and MoveInsertable into *this
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == cap_) {
+      grow_emplace(size_, std::forward<Args>(args)...);
+    } else {
+      al_traits::construct(al_, slot(size_), std::forward<Args>(args)...);
+    }
+    ++size_;
+    return back();
+  }
+
+  // Same as above
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    if (size_ == cap_) {
+      grow_emplace(-1, std::forward<Args>(args)...);
+    } else {
+      al_traits::construct(al_, slot(-1), std::forward<Args>(args)...);
+      head_ = (head_ - 1) & (cap_ - 1);
+    }
+    ++size_;
+    return front();
+  }
+
+  void pop_back() noexcept {
+    al_traits::destroy(al_, slot(size_ - 1));
+    --size_;
+  }
+
+  void pop_front() noexcept {
+    al_traits::destroy(al_, slot(0));
+    head_ = (head_ + 1) & (cap_ - 1);
+    --size_;
+  }
+
+  void swap(deque& other) noexcept(
+      al_traits::propagate_on_container_swap::value ||
+      al_traits::is_always_equal::value) {
+    if constexpr (al_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(al_, other.al_);
+    }
+    swap_content(other);
+  }
+
+  // T must meet additional requirements of EqualityComparable
+  bool operator==(const deque& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    for (size_type i = 0; i < size_; ++i) {
+      if (!((*this)[i] == other[i])) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const deque& other) const { return !(*this == other); }
+
+ private:
+  // Relocation bypasses allocator construct and destroy, so it is only used
+  // when allocator does not provide its own
+  static constexpr bool kRelocatable =
+      sp::is_trivially_relocatable<T>::value &&
+      !requires(Allocator& al, pointer p) { al.destroy(p); } &&
+      !requires(Allocator& al, pointer p, T&& val) {
+        al.construct(p, std::move(val));
+      };
+
+  // Element at offset from the front, offsets wrap around the buffer
+  pointer slot(size_type offset) const noexcept {
+    return buf_ + ((head_ + offset) & (cap_ - 1));
+  }
+
+  // Memory freed on scope exit unless swapped into deque
+  struct pointer_buffer {
+    pointer_buffer(size_type size, Allocator* al)
+        : ptr(al_traits::allocate(*al, size)), cap(size), alc(al) {}
+    pointer_buffer(const pointer_buffer&) = delete;
+    pointer_buffer& operator=(const pointer_buffer&) = delete;
+    ~pointer_buffer() {
+      if (ptr) {
+        al_traits::deallocate(*alc, ptr, cap);
+      }
+    }
+
+    pointer ptr;
+    size_type cap;
+    Allocator* alc;
+  };
+
+  // Moves elements in order to the start of dest, strong guarantee as
+  // elements are copied if their move may throw
+  void relocate_to(pointer dest) {
+    if constexpr (kRelocatable) {
+      if (!size_) {
+        return;
+      }
+      size_type first_run = std::min(size_, cap_ - head_);
+      std::memcpy(static_cast<void*>(dest), static_cast<void*>(buf_ + head_),
+                  first_run * sizeof(T));
+      std::memcpy(static_cast<void*>(dest + first_run),
+                  static_cast<void*>(buf_), (size_ - first_run) * sizeof(T));
+    } else {
+      size_type i = 0;
+      try {
+        for (; i < size_; ++i) {
+          al_traits::construct(al_, dest + i, std::move_if_noexcept(*slot(i)));
+        }
+      } catch (...) {
+        while (i--) {
+          al_traits::destroy(al_, dest + i);
+        }
+        throw;
+      }
+      destroy_content();
+    }
+  }
+
+  // Moves elements to new buffer of capacity elements
+  void reallocate(size_type capacity) {
+    pointer_buffer temp(capacity, &al_);
+    relocate_to(temp.ptr);
+    adopt(temp);
+  }
+
+  // Constructs element at offset of doubled buffer, -1 for the front, then
+  // moves old elements after it
+  template <typename... Args>
+  void grow_emplace(size_type offset, Args&&... args) {
+    size_type capacity = std::max(cap_ * 2, kMinCapacity);
+    pointer_buffer temp(capacity, &al_);
+    pointer target = temp.ptr + (offset & (capacity - 1));
+    al_traits::construct(al_, target, std::forward<Args>(args)...);
+    try {
+      relocate_to(temp.ptr);
+    } catch (...) {
+      al_traits::destroy(al_, target);
+      throw;
+    }
+    adopt(temp);
+    if (offset < 0) {
+      head_ = capacity - 1;
+    }
+  }
+
+  // Takes buffer holding elements from its start, frees the old one
+  void adopt(pointer_buffer& temp) noexcept {
+    std::swap(buf_, temp.ptr);
+    std::swap(cap_, temp.cap);
+    head_ = 0;
+  }
+
+  void destroy_content() noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for (size_type i = 0; i < size_; ++i) {
+        al_traits::destroy(al_, slot(i));
+      }
+    }
+  }
+
+  // Destroys elements and frees buffer
+  void release() noexcept {
+    destroy_content();
+    if (buf_) {
+      al_traits::deallocate(al_, buf_, cap_);
+    }
+    buf_ = nullptr;
+    cap_ = 0;
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // *this must be empty
+  void move_from(deque& other) {
+    reserve(other.size_);
+    for (reference value : other) {
+      emplace_back(std::move(value));
+    }
+  }
+
+  void swap_content(deque& other) noexcept {
+    std::swap(buf_, other.buf_);
+    std::swap(cap_, other.cap_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  pointer buf_ = nullptr;
+  size_type cap_ = 0;
+  size_type head_ = 0;
+  size_type size_ = 0;
+  [[no_unique_address]] Allocator al_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_DEQUE_H_
@@ -0,0 +1,630 @@
+#ifndef SP_CONTAINERS_FLAT_MAP_H_
+#define SP_CONTAINERS_FLAT_MAP_H_
+
+#include <algorithm>         // std::stable_sort, std::unique
+#include <compare>           // operator<=>
+#include <cstdint>           // int64_t
+#include <functional>        // std::less
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::random_access_iterator_tag
+#include <stdexcept>         // std::out_of_range, std::invalid_argument
+#include <type_traits>       // std::conditional_t, std::is_convertible
+#include <utility>           // std::move, std::as_const, std::pair
+
+#include <sp/branchless_search.h>
+#include <sp/vector.h>
+
+namespace sp {
+// Map keeping keys and mapped values in two parallel containers sorted by
+//  key, so that lookup runs branchless binary search over keys alone.
+//  Insertion and erasure shift elements, so it suits tables built once and
+//  read often
+// Any insertion or erasure invalidates iterators
+// Key and T types must meet requirements of Erasable, MoveInsertable and
+//  MoveAssignable
+// Compare must induce strict weak ordering on keys, if it is transparent
+//  lookup methods accept any type comparable with keys
+// KeyContainer and MappedContainer must be random access sequence
+//  containers of Key and T
+// Methods may have additional requirements on types
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename KeyContainer = sp::vector<Key>,
+          typename MappedContainer = sp::vector<T>>
+class flat_map {
+  static constexpr bool kTransparent =
+      requires { typename Compare::is_transparent; };
+
+ public:
+  template <bool Const>
+  class FlatMapIterator;
+
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using reference = std::pair<const Key&, T&>;
+  using const_reference = std::pair<const Key&, const T&>;
+  using size_type = int64_t;
+  using difference_type = int64_t;
+  using key_compare = Compare;
+  using key_container_type = KeyContainer;
+  using mapped_container_type = MappedContainer;
+
+  using iterator = FlatMapIterator<false>;
+  using const_iterator = FlatMapIterator<true>;
+
+  // Compares values by their keys
+  class value_compare {
+   public:
+    bool operator()(const_reference lhs, const_reference rhs) const {
+      return comp(lhs.first, rhs.first);
+    }
+
+   protected:
+    friend class flat_map;
+    value_compare(Compare c) : comp(c) {}
+
+    Compare comp;
+  };
+
+  // Both underlying containers
+  struct containers {
+    KeyContainer keys;
+    MappedContainer values;
+  };
+
+  // Random access iterator yielding pairs of references to key and value
+  template <bool Const>
+  class FlatMapIterator {
+    using key_iterator = typename KeyContainer::const_iterator;
+    using value_iterator =
+        std::conditional_t<Const, typename MappedContainer::const_iterator,
+                           typename MappedContainer::iterator>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::pair<Key, T>;
+    using difference_type = int64_t;
+    using reference = std::conditional_t<Const, const_reference,
+                                         typename flat_map::reference>;
+
+    // Pair of references is made on the fly, arrow keeps it alive
+    struct pointer {
+      reference* operator->() noexcept { return &ref; }
+
+      reference ref;
+    };
+
+    FlatMapIterator() = default;
+
+    FlatMapIterator(key_iterator key, value_iterator value) noexcept
+        : key_(key), value_(value) {}
+
+    operator FlatMapIterator<true>() const noexcept
+      requires(!Const)
+    {
+      return FlatMapIterator<true>(key_, value_);
+    }
+
+    reference operator*() const noexcept { return {*key_, *value_}; }
+    pointer operator->() const noexcept { return {**this}; }
+    reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    FlatMapIterator& operator++() noexcept {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+
+    FlatMapIterator operator++(int) noexcept {
+      FlatMapIterator temp(*this);
+      ++*this;
+      return temp;
+    }
+
+    FlatMapIterator& operator--() noexcept {
+      --key_;
+      --value_;
+      return *this;
+    }
+
+    FlatMapIterator operator--(int) noexcept {
+      FlatMapIterator temp(*this);
+      --*this;
+      return temp;
+    }
+
+    FlatMapIterator& operator+=(difference_type n) noexcept {
+      key_ += n;
+      value_ += n;
+      return *this;
+    }
+
+    FlatMapIterator& operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+
+    FlatMapIterator operator+(difference_type n) const noexcept {
+      FlatMapIterator temp(*this);
+      return temp += n;
+    }
+
+    friend FlatMapIterator operator+(difference_type n,
+                                     const FlatMapIterator& pos) noexcept {
+      return pos + n;
+    }
+
+    FlatMapIterator operator-(difference_type n) const noexcept {
+      FlatMapIterator temp(*this);
+      return temp -= n;
+    }
+
+    difference_type operator-(const FlatMapIterator& other) const noexcept {
+      return key_ - other.key_;
+    }
+
+    bool operator==(const FlatMapIterator& other) const noexcept {
+      return key_ == other.key_;
+    }
+
+    auto operator<=>(const FlatMapIterator& other) const noexcept {
+      return key_ <=> other.key_;
+    }
+
+   private:
+    friend class flat_map;
+
+    key_iterator key_;
+    value_iterator value_;
+  };
+
+  flat_map() = default;
+
+  explicit flat_map(const Compare& comp) : comp_(comp) {}
+
+  // Containers must have equal sizes, keys may come in any order and
+  //  repeat, only first of equivalent keys is kept
+  flat_map(KeyContainer keys, MappedContainer values,
+           const Compare& comp = Compare())
+      : comp_(comp) {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument("Keys and values must have equal sizes");
+    }
+    if (is_sorted_unique(keys)) {
+      keys_.swap(keys);
+      values_.swap(values);
+      return;
+    }
+    sp::vector<value_type> fresh;
+    fresh.reserve(keys.size());
+    for (size_type i = 0; i < keys.size(); ++i) {
+      fresh.emplace_back(std::move(keys[i]), std::move(values[i]));
+    }
+    merge_fresh(fresh);
+  }
+
+  template <typename InputIterator>
+  flat_map(InputIterator first, InputIterator last,
+           const Compare& comp = Compare())
+      : comp_(comp) {
+    insert(first, last);
+  }
+
+  flat_map(std::initializer_list<value_type> vals,
+           const Compare& comp = Compare())
+      : flat_map(vals.begin(), vals.end(), comp) {}
+
+  flat_map(const flat_map& other) = default;
+  flat_map(flat_map&& other) noexcept = default;
+
+  flat_map& operator=(const flat_map& other) = default;
+  flat_map& operator=(flat_map&& other) = default;
+
+  flat_map& operator=(std::initializer_list<value_type> vals) {
+    clear();
+    insert(vals);
+    return *this;
+  }
+
+  ~flat_map() = default;
+
+  //============================================================================
+  key_compare key_comp() const { return comp_; }
+  value_compare value_comp() const { return value_compare(comp_); }
+
+  // Underlying containers, keys are sorted with no equivalent ones
+  const KeyContainer& keys() const noexcept { return keys_; }
+  const MappedContainer& values() const noexcept { return values_; }
+
+  // Hands the containers over, leaving map empty
+  containers extract() && {
+    containers result{std::move(keys_), std::move(values_)};
+    clear();
+    return result;
+  }
+
+  T& at(const Key& key) {
+    size_type index = find_index(key);
+    if (index == size()) {
+      throw std::out_of_range("Key is not present in flat_map");
+    }
+    return values_[index];
+  }
+
+  const T& at(const Key& key) const {
+    size_type index = find_index(key);
+    if (index == size()) {
+      throw std::out_of_range("Key is not present in flat_map");
+    }
+    return values_[index];
+  }
+
+  // T must meet additional requirements of DefaultConstructible, Key of
+  //  CopyConstructible
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  // T must meet additional requirements of DefaultConstructible, Key of
+  //  MoveConstructible
+  T& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  iterator begin() noexcept { return at_index(0); }
+  const_iterator begin() const noexcept { return at_index(0); }
+  const_iterator cbegin() const noexcept { return at_index(0); }
+
+  iterator end() noexcept { return at_index(size()); }
+  const_iterator end() const noexcept { return at_index(size()); }
+  const_iterator cend() const noexcept { return at_index(size()); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept {
+    return std::min<size_type>(keys_.max_size(), values_.max_size());
+  }
+  //============================================================================
+
+  // Checks that containers have equal sizes and keys are sorted and unique
+  bool integrity() const {
+    return keys_.size() == values_.size() && is_sorted_unique(keys_);
+  }
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+
+  // Key and T must meet additional requirements of CopyInsertable
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  // Key and T must meet additional requirements of MoveInsertable
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  // Collects values, sorts them by key and merges with present ones in one
+  //  pass, only first of equivalent keys is kept. Strong exception
+  //  guarantee
+  // value_type must meet additional requirements of EmplaceConstructible
+  //  from *first
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    sp::vector<value_type> fresh;
+    for (; first != last; ++first) {
+      fresh.emplace_back(*first);
+    }
+    merge_fresh(fresh);
+  }
+
+  // Same as insert(vals.begin(), vals.end())
+  void insert(std::initializer_list<value_type> vals) {
+    insert(vals.begin(), vals.end());
+  }
+
+  // T must meet additional requirements of Assignable from value
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // T must meet additional requirements of Assignable from value
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+    auto result = try_emplace(std::move(key), std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // value_type must meet additional requirements of EmplaceConstructible
+  //  from args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  // Constructs T from args only if key is not present, never moves from
+  //  arguments otherwise
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    size_type index = lower_index(key);
+    if (index < size() && !comp_(key, keys_[index])) {
+      return {at_index(index), false};
+    }
+    return {emplace_at(index, key, std::forward<Args>(args)...), true};
+  }
+
+  // Same as above, but moves key
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    size_type index = lower_index(key);
+    if (index < size() && !comp_(key, keys_[index])) {
+      return {at_index(index), false};
+    }
+    return {emplace_at(index, std::move(key), std::forward<Args>(args)...),
+            true};
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = first - begin();
+    values_.erase(first.value_, last.value_);
+    keys_.erase(first.key_, last.key_);
+    return at_index(index);
+  }
+
+  size_type erase(const Key& key) { return erase_key(key); }
+
+  template <typename K>
+    requires(kTransparent && !std::is_convertible<K, const_iterator>::value)
+  size_type erase(K&& key) {
+    return erase_key(key);
+  }
+
+  void swap(flat_map& other) noexcept {
+    using std::swap;
+    swap(comp_, other.comp_);
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+  //============================================================================
+  size_type count(const Key& key) const { return contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  size_type count(const K& key) const {
+    return contains(key);
+  }
+
+  iterator find(const Key& key) { return at_index(find_index(key)); }
+  const_iterator find(const Key& key) const {
+    return at_index(find_index(key));
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator find(const K& key) {
+    return at_index(find_index(key));
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator find(const K& key) const {
+    return at_index(find_index(key));
+  }
+
+  bool contains(const Key& key) const { return find_index(key) != size(); }
+
+  template <typename K>
+    requires kTransparent
+  bool contains(const K& key) const {
+    return find_index(key) != size();
+  }
+
+  iterator lower_bound(const Key& key) { return at_index(lower_index(key)); }
+  const_iterator lower_bound(const Key& key) const {
+    return at_index(lower_index(key));
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator lower_bound(const K& key) {
+    return at_index(lower_index(key));
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator lower_bound(const K& key) const {
+    return at_index(lower_index(key));
+  }
+
+  iterator upper_bound(const Key& key) { return at_index(upper_index(key)); }
+  const_iterator upper_bound(const Key& key) const {
+    return at_index(upper_index(key));
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator upper_bound(const K& key) {
+    return at_index(upper_index(key));
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator upper_bound(const K& key) const {
+    return at_index(upper_index(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  //============================================================================
+
+  // Key and T must meet additional requirements of EqualityComparable
+  bool operator==(const flat_map& other) const {
+    return keys_ == other.keys_ && values_ == other.values_;
+  }
+
+  bool operator!=(const flat_map& other) const { return !(*this == other); }
+
+ private:
+  iterator at_index(size_type index) noexcept {
+    return iterator(keys_.begin() + index, values_.begin() + index);
+  }
+
+  const_iterator at_index(size_type index) const noexcept {
+    return const_iterator(keys_.begin() + index, values_.begin() + index);
+  }
+
+  bool is_sorted_unique(const KeyContainer& keys) const {
+    return std::adjacent_find(keys.begin(), keys.end(),
+                              [this](const Key& lhs, const Key& rhs) {
+                                return !comp_(lhs, rhs);
+                              }) == keys.end();
+  }
+
+  template <typename K>
+  size_type lower_index(const K& key) const {
+    return sp::branchless_lower_bound(keys_.begin(), keys_.end(), key,
+                                      comp_) -
+           keys_.begin();
+  }
+
+  template <typename K>
+  size_type upper_index(const K& key) const {
+    return sp::branchless_upper_bound(keys_.begin(), keys_.end(), key,
+                                      comp_) -
+           keys_.begin();
+  }
+
+  // Index of key or size() if it is not present
+  template <typename K>
+  size_type find_index(const K& key) const {
+    size_type index = lower_index(key);
+    if (index == size() || comp_(key, keys_[index])) {
+      return size();
+    }
+    return index;
+  }
+
+  template <typename K>
+  size_type erase_key(const K& key) {
+    size_type index = find_index(key);
+    if (index == size()) {
+      return 0;
+    }
+    erase(at_index(index));
+    return 1;
+  }
+
+  // Inserts key and value constructed from args before index
+  template <typename K, typename... Args>
+  iterator emplace_at(size_type index, K&& key, Args&&... args) {
+    keys_.insert(keys_.begin() + index, std::forward<K>(key));
+    try {
+      values_.emplace(values_.begin() + index, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.begin() + index);
+      throw;
+    }
+    return at_index(index);
+  }
+
+  // Sorts fresh values by key and merges them with present ones into new
+  // containers, present values win over equivalent fresh ones. Present
+  // keys and values are moved only if neither move can throw, otherwise
+  // both are copied, so present ones are intact if merge throws
+  void merge_fresh(sp::vector<value_type>& fresh) {
+    if (fresh.empty()) {
+      return;
+    }
+    auto less = [this](const value_type& lhs, const value_type& rhs) {
+      return comp_(lhs.first, rhs.first);
+    };
+    std::stable_sort(fresh.begin(), fresh.end(), less);
+    auto fresh_end = std::unique(
+        fresh.begin(), fresh.end(),
+        [&less](const value_type& lhs, const value_type& rhs) {
+          return !less(lhs, rhs);
+        });
+
+    constexpr bool kMovePresent =
+        std::is_nothrow_move_constructible<Key>::value &&
+        std::is_nothrow_move_constructible<T>::value;
+    auto take = [](auto& present) -> decltype(auto) {
+      if constexpr (kMovePresent) {
+        return std::move(present);
+      } else {
+        return std::as_const(present);
+      }
+    };
+
+    KeyContainer keys;
+    MappedContainer values;
+    keys.reserve(size() + (fresh_end - fresh.begin()));
+    values.reserve(size() + (fresh_end - fresh.begin()));
+    size_type old = 0;
+    for (auto pos = fresh.begin(); pos != fresh_end;) {
+      if (old < size() && !comp_(pos->first, keys_[old])) {
+        if (!comp_(keys_[old], pos->first)) {
+          ++pos;
+        }
+        keys.push_back(take(keys_[old]));
+        values.push_back(take(values_[old]));
+        ++old;
+      } else {
+        keys.push_back(std::move(pos->first));
+        values.push_back(std::move(pos->second));
+        ++pos;
+      }
+    }
+    for (; old < size(); ++old) {
+      keys.push_back(take(keys_[old]));
+      values.push_back(take(values_[old]));
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+  }
+
+  [[no_unique_address]] Compare comp_;
+  KeyContainer keys_;
+  MappedContainer values_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_FLAT_MAP_H_
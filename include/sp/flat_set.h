@@ -0,0 +1,297 @@
+#ifndef SP_CONTAINERS_FLAT_SET_H_
+#define SP_CONTAINERS_FLAT_SET_H_
+
+#include <algorithm>         // std::stable_sort, std::unique
+#include <cstdint>           // int64_t
+#include <functional>        // std::less
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::make_move_iterator
+#include <type_traits>       // std::is_convertible
+#include <utility>           // std::move, std::move_if_noexcept, std::pair
+
+#include <sp/branchless_search.h>
+#include <sp/vector.h>
+
+namespace sp {
+// Set keeping its keys sorted in a contiguous container. Lookup is
+//  a branchless binary search, insertion and erasure shift keys, so it
+//  suits tables built once and read often
+// Any insertion or erasure invalidates iterators
+// Key type must meet requirements of Erasable, MoveInsertable and
+//  MoveAssignable
+// Compare must induce strict weak ordering on keys, if it is transparent
+//  lookup methods accept any type comparable with keys
+// KeyContainer must be random access sequence container of keys
+// Methods may have additional requirements on types
+template <typename Key, typename Compare = std::less<Key>,
+          typename KeyContainer = sp::vector<Key>>
+class flat_set {
+  static constexpr bool kTransparent =
+      requires { typename Compare::is_transparent; };
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = Key&;
+  using const_reference = const Key&;
+  using size_type = int64_t;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using container_type = KeyContainer;
+
+  // Keys are never modified through iterators
+  using iterator = typename KeyContainer::const_iterator;
+  using const_iterator = typename KeyContainer::const_iterator;
+
+  flat_set() = default;
+
+  explicit flat_set(const Compare& comp) : comp_(comp) {}
+
+  // Keys may come in any order and repeat, only first of equivalent keys
+  //  is kept
+  explicit flat_set(KeyContainer keys, const Compare& comp = Compare())
+      : comp_(comp) {
+    if (is_sorted_unique(keys.begin(), keys.end())) {
+      keys_.swap(keys);
+    } else {
+      insert(std::make_move_iterator(keys.begin()),
+             std::make_move_iterator(keys.end()));
+    }
+  }
+
+  template <typename InputIterator>
+  flat_set(InputIterator first, InputIterator last,
+           const Compare& comp = Compare())
+      : comp_(comp) {
+    insert(first, last);
+  }
+
+  flat_set(std::initializer_list<Key> vals, const Compare& comp = Compare())
+      : flat_set(vals.begin(), vals.end(), comp) {}
+
+  flat_set(const flat_set& other) = default;
+  flat_set(flat_set&& other) noexcept = default;
+
+  flat_set& operator=(const flat_set& other) = default;
+  flat_set& operator=(flat_set&& other) = default;
+
+  flat_set& operator=(std::initializer_list<Key> vals) {
+    clear();
+    insert(vals);
+    return *this;
+  }
+
+  ~flat_set() = default;
+
+  //============================================================================
+  key_compare key_comp() const { return comp_; }
+  value_compare value_comp() const { return comp_; }
+
+  // Underlying container, sorted with no equivalent keys
+  const KeyContainer& keys() const noexcept { return keys_; }
+
+  // Hands the container over, leaving set empty
+  KeyContainer extract() && {
+    KeyContainer keys(std::move(keys_));
+    keys_.clear();
+    return keys;
+  }
+
+  iterator begin() const noexcept { return keys_.begin(); }
+  const_iterator cbegin() const noexcept { return keys_.begin(); }
+
+  iterator end() const noexcept { return keys_.end(); }
+  const_iterator cend() const noexcept { return keys_.end(); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  //============================================================================
+
+  // Checks that keys are sorted and unique
+  bool integrity() const { return is_sorted_unique(begin(), end()); }
+
+  void clear() noexcept { keys_.clear(); }
+
+  void reserve(size_type count) { keys_.reserve(count); }
+
+  // Key must meet additional requirements of CopyInsertable
+  std::pair<iterator, bool> insert(const Key& value) {
+    return emplace(value);
+  }
+
+  // Key must meet additional requirements of MoveInsertable
+  std::pair<iterator, bool> insert(Key&& value) {
+    return emplace(std::move(value));
+  }
+
+  // Collects keys, sorts them and merges with present ones in one pass,
+  //  only first of equivalent keys is kept. Strong exception guarantee
+  // Key must meet additional requirements of EmplaceConstructible from
+  //  *first
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    KeyContainer fresh;
+    for (; first != last; ++first) {
+      fresh.emplace_back(*first);
+    }
+    if (fresh.empty()) {
+      return;
+    }
+    std::stable_sort(fresh.begin(), fresh.end(), comp_);
+    auto fresh_end = std::unique(
+        fresh.begin(), fresh.end(),
+        [this](const Key& lhs, const Key& rhs) { return !comp_(lhs, rhs); });
+
+    KeyContainer merged;
+    merged.reserve(size() + (fresh_end - fresh.begin()));
+    auto old = keys_.begin();
+    for (auto pos = fresh.begin(); pos != fresh_end;) {
+      if (old != keys_.end() && !comp_(*pos, *old)) {
+        if (!comp_(*old, *pos)) {
+          ++pos;
+        }
+        merged.push_back(std::move_if_noexcept(*old++));
+      } else {
+        merged.push_back(std::move(*pos++));
+      }
+    }
+    for (; old != keys_.end(); ++old) {
+      merged.push_back(std::move_if_noexcept(*old));
+    }
+    keys_.swap(merged);
+  }
+
+  // Same as insert(vals.begin(), vals.end())
+  void insert(std::initializer_list<Key> vals) {
+    insert(vals.begin(), vals.end());
+  }
+
+  // Key must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    Key key(std::forward<Args>(args)...);
+    auto pos = lower_bound(key);
+    if (pos != end() && !comp_(key, *pos)) {
+      return {pos, false};
+    }
+    return {keys_.insert(pos, std::move(key)), true};
+  }
+
+  iterator erase(const_iterator pos) { return keys_.erase(pos); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    return keys_.erase(first, last);
+  }
+
+  size_type erase(const Key& key) { return erase_key(key); }
+
+  template <typename K>
+    requires(kTransparent && !std::is_convertible<K, const_iterator>::value)
+  size_type erase(K&& key) {
+    return erase_key(key);
+  }
+
+  void swap(flat_set& other) noexcept {
+    using std::swap;
+    swap(comp_, other.comp_);
+    keys_.swap(other.keys_);
+  }
+
+  //============================================================================
+  size_type count(const Key& key) const { return contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  size_type count(const K& key) const {
+    return contains(key);
+  }
+
+  iterator find(const Key& key) const { return find_key(key); }
+
+  template <typename K>
+    requires kTransparent
+  iterator find(const K& key) const {
+    return find_key(key);
+  }
+
+  bool contains(const Key& key) const { return find_key(key) != end(); }
+
+  template <typename K>
+    requires kTransparent
+  bool contains(const K& key) const {
+    return find_key(key) != end();
+  }
+
+  iterator lower_bound(const Key& key) const {
+    return sp::branchless_lower_bound(begin(), end(), key, comp_);
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator lower_bound(const K& key) const {
+    return sp::branchless_lower_bound(begin(), end(), key, comp_);
+  }
+
+  iterator upper_bound(const Key& key) const {
+    return sp::branchless_upper_bound(begin(), end(), key, comp_);
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator upper_bound(const K& key) const {
+    return sp::branchless_upper_bound(begin(), end(), key, comp_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  //============================================================================
+
+  // Key must meet additional requirements of EqualityComparable
+  bool operator==(const flat_set& other) const {
+    return keys_ == other.keys_;
+  }
+
+  bool operator!=(const flat_set& other) const { return !(*this == other); }
+
+ private:
+  template <typename It>
+  bool is_sorted_unique(It first, It last) const {
+    return std::adjacent_find(first, last,
+                              [this](const Key& lhs, const Key& rhs) {
+                                return !comp_(lhs, rhs);
+                              }) == last;
+  }
+
+  template <typename K>
+  iterator find_key(const K& key) const {
+    iterator pos = sp::branchless_lower_bound(begin(), end(), key, comp_);
+    if (pos == end() || comp_(key, *pos)) {
+      return end();
+    }
+    return pos;
+  }
+
+  template <typename K>
+  size_type erase_key(const K& key) {
+    iterator pos = find_key(key);
+    if (pos == end()) {
+      return 0;
+    }
+    keys_.erase(pos);
+    return 1;
+  }
+
+  [[no_unique_address]] Compare comp_;
+  KeyContainer keys_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_FLAT_SET_H_
@@ -0,0 +1,61 @@
+#ifndef SP_CONTAINERS_GROWTH_POLICY_H_
+#define SP_CONTAINERS_GROWTH_POLICY_H_
+
+#include <algorithm>  // std::max, std::min
+#include <bit>        // std::bit_ceil
+#include <cstdint>    // int64_t
+
+namespace sp {
+// Growth policy defines capacity of container buffer on reallocation.
+// Policy type must provide static member function
+//  int64_t grow(int64_t cap, int64_t required, int64_t obj_size)
+// returning new capacity not less than required, where cap is current
+// capacity and obj_size is size of single element in bytes
+
+// Doubles capacity
+struct doubling_growth {
+  static constexpr int64_t grow(int64_t cap, int64_t required,
+                                int64_t obj_size) noexcept {
+    (void)obj_size;
+    return std::max(cap * 2, required);
+  }
+};
+
+// Multiplies capacity by 1.5, wastes less memory than doubling and lets
+// allocator reuse previously freed blocks
+struct one_and_half_growth {
+  static constexpr int64_t grow(int64_t cap, int64_t required,
+                                int64_t obj_size) noexcept {
+    (void)obj_size;
+    return std::max(cap + cap / 2, required);
+  }
+};
+
+// Rounds buffer size in bytes up to power of two, so that buffer fills
+// whole size class of binned allocators
+struct power_of_two_growth {
+  static constexpr int64_t grow(int64_t cap, int64_t required,
+                                int64_t obj_size) noexcept {
+    (void)cap;
+    if (required > (int64_t(1) << 62) / obj_size) {
+      return required;
+    }
+    uint64_t bytes = std::bit_ceil(static_cast<uint64_t>(required * obj_size));
+    return static_cast<int64_t>(bytes) / obj_size;
+  }
+};
+
+// Doubles capacity until buffer reaches Limit bytes, then grows it by
+// Limit bytes at a time, bounding unused memory of huge buffers
+template <int64_t Limit = (int64_t(1) << 26)>
+struct capped_growth {
+  static_assert(Limit > 0, "Growth limit must be positive");
+
+  static constexpr int64_t grow(int64_t cap, int64_t required,
+                                int64_t obj_size) noexcept {
+    int64_t step = std::max(Limit / obj_size, int64_t(1));
+    return std::max(cap + std::min(cap, step), required);
+  }
+};
+}  // namespace sp
+#endif  // SP_CONTAINERS_GROWTH_POLICY_H_
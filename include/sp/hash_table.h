@@ -0,0 +1,849 @@
+#ifndef SP_CONTAINERS_HASH_TABLE_H_
+#define SP_CONTAINERS_HASH_TABLE_H_
+
+#include <bit>          // std::countr_zero, std::countl_zero, std::countr_one
+#include <cstddef>      // std::ptrdiff_t, std::size_t
+#include <cstdint>      // int64_t, int8_t, uint64_t
+#include <cstring>      // std::memcpy, std::memset
+#include <iterator>     // std::forward_iterator_tag
+#include <memory>       // std::allocator_traits
+#include <type_traits>  // as name suggests
+#include <utility>      // std::forward, std::move, std::pair, std::swap
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SP_CONTAINERS_HASH_TABLE_SSE2_
+#include <emmintrin.h>
+#endif
+
+#include <sp/key_of_value.h>
+#include <sp/type_traits.h>  // sp::is_trivially_relocatable
+
+namespace sp {
+// Matching slots of a control group, a set bit per slot. Shift is binary
+// logarithm of bits taken by a slot
+template <typename T, int Shift>
+class group_mask {
+ public:
+  explicit group_mask(T mask) noexcept : mask_(mask) {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+
+  // Index of the first matching slot
+  int lowest() const noexcept { return std::countr_zero(mask_) >> Shift; }
+
+  void drop_lowest() noexcept { mask_ &= mask_ - 1; }
+
+  // Slots before the first match, group width if there is none
+  int trailing_zeros() const noexcept {
+    return std::countr_zero(mask_) >> Shift;
+  }
+
+  // Slots after the last match, group width if there is none
+  int leading_zeros() const noexcept {
+    return std::countl_zero(mask_) >> Shift;
+  }
+
+ private:
+  T mask_;
+};
+
+// Control bytes of consecutive slots of hash table, loaded at once and
+// matched by SIMD compare where available. Full slots keep 7 low bits of
+// hash of their key, other states are negative
+class control_group {
+ public:
+  static constexpr int8_t kEmpty = -128;
+  static constexpr int8_t kDeleted = -2;
+  static constexpr int8_t kSentinel = -1;
+
+#if defined(__AVX2__)
+  static constexpr int kWidth = 32;
+  using mask = group_mask<uint32_t, 0>;
+
+  explicit control_group(const int8_t* pos) noexcept
+      : ctrl_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+  mask match(int8_t h2) const noexcept {
+    return mask(uint32_t(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_set1_epi8(h2), ctrl_))));
+  }
+
+  mask match_empty() const noexcept { return match(kEmpty); }
+
+  mask match_free() const noexcept {
+    return mask(uint32_t(_mm256_movemask_epi8(
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(kSentinel), ctrl_))));
+  }
+
+  // Empty or deleted slots at the start of the group
+  int count_leading_free() const noexcept {
+    return std::countr_one(uint32_t(_mm256_movemask_epi8(
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(kSentinel), ctrl_))));
+  }
+
+ private:
+  __m256i ctrl_;
+#elif defined(SP_CONTAINERS_HASH_TABLE_SSE2_)
+  static constexpr int kWidth = 16;
+  using mask = group_mask<uint16_t, 0>;
+
+  explicit control_group(const int8_t* pos) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  mask match(int8_t h2) const noexcept {
+    return mask(uint16_t(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+
+  mask match_empty() const noexcept { return match(kEmpty); }
+
+  mask match_free() const noexcept {
+    return mask(uint16_t(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_))));
+  }
+
+  // Empty or deleted slots at the start of the group
+  int count_leading_free() const noexcept {
+    return std::countr_one(uint16_t(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_))));
+  }
+
+ private:
+  __m128i ctrl_;
+#else
+  // Portable fallback treating 8 control bytes as one word
+  static constexpr int kWidth = 8;
+  using mask = group_mask<uint64_t, 3>;
+
+  explicit control_group(const int8_t* pos) noexcept : ctrl_(0) {
+    for (int i = 0; i < kWidth; ++i) {
+      ctrl_ |= uint64_t(uint8_t(pos[i])) << (8 * i);
+    }
+  }
+
+  // May also report full slots following a match, callers compare keys
+  // anyway
+  mask match(int8_t h2) const noexcept {
+    uint64_t x = ctrl_ ^ (kLsbs * uint8_t(h2));
+    return mask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  // Only empty slots have high bit set and bit 1 clear
+  mask match_empty() const noexcept {
+    return mask(ctrl_ & ~(ctrl_ << 6) & kMsbs);
+  }
+
+  // Only empty and deleted slots have high bit set and bit 0 clear
+  mask match_free() const noexcept {
+    return mask(ctrl_ & ~(ctrl_ << 7) & kMsbs);
+  }
+
+  // Empty or deleted slots at the start of the group
+  int count_leading_free() const noexcept {
+    uint64_t free = ctrl_ & ~(ctrl_ << 7) & kMsbs;
+    return std::countr_zero(~free & kMsbs) >> 3;
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101;
+  static constexpr uint64_t kMsbs = 0x8080808080808080;
+
+  uint64_t ctrl_;
+#endif
+};
+#undef SP_CONTAINERS_HASH_TABLE_SSE2_
+
+// Open addressing hash table of values with unique keys, engine of
+// sp::unordered_map and sp::unordered_set. Values are kept in one array
+// of slots next to an array of control bytes, a byte per slot. Lookup
+// hashes the key once, then compares a group of control bytes with 7 bits
+// of the hash at a time and touches only slots that match, probing groups
+// until one with an empty slot.
+// Capacity is always a power of two minus one, the control array holds a
+// sentinel after the last slot and a copy of the first kWidth - 1 bytes,
+// so that a group may be loaded at any slot. Table grows when 7/8 of
+// slots are used.
+// Any insertion invalidates all iterators, erasure only erased ones
+// Value type must meet requirements of Erasable and be nothrow movable,
+//  keys of maps are moved between slots as non-const
+// KeyOfValue must return reference to key of given value
+// Hash must not throw, KeyEqual must be equivalence relation consistent
+//  with it, lookup methods accept any type both can take
+// Allocator type must meet requirements of Allocator
+// Methods may have additional requirements on types
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+class hash_table {
+  using slot_type = typename sp::mutable_value<Value>::type;
+
+  static_assert(sp::is_trivially_relocatable<Value>::value ||
+                    std::is_nothrow_move_constructible<slot_type>::value,
+                "Values must be nothrow movable");
+
+  static constexpr int8_t kEmpty = control_group::kEmpty;
+  static constexpr int8_t kDeleted = control_group::kDeleted;
+  static constexpr int8_t kSentinel = control_group::kSentinel;
+
+ public:
+  template <typename U>
+  class HashIterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using reference = Value&;
+  using const_reference = const Value&;
+  using size_type = int64_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  using allocator_type = Allocator;
+  using al_traits = std::allocator_traits<allocator_type>;
+
+  using iterator = HashIterator<Value>;
+  using const_iterator = HashIterator<const Value>;
+
+  // Control bytes matched at once
+  static constexpr int kWidth = control_group::kWidth;
+
+  // Slot where value with given key is, hash is kept for insertion
+  struct position {
+    size_type index;
+    uint64_t hash;
+    bool found;
+  };
+
+  // Forward iterator over values in order of slots
+  template <typename U>
+  class HashIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<U>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = U*;
+    using reference = U&;
+
+    HashIterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+
+    HashIterator(const int8_t* ctrl, U* slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {}
+
+    operator HashIterator<const U>() const noexcept
+      requires(!std::is_const<U>::value)
+    {
+      return HashIterator<const U>(ctrl_, slot_);
+    }
+
+    reference operator*() const noexcept { return *slot_; }
+    pointer operator->() const noexcept { return slot_; }
+
+    HashIterator& operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      skip_free();
+      return *this;
+    }
+
+    HashIterator operator++(int) noexcept {
+      HashIterator temp(*this);
+      ++*this;
+      return temp;
+    }
+
+    bool operator==(const HashIterator& other) const noexcept {
+      return ctrl_ == other.ctrl_;
+    }
+
+   private:
+    friend class hash_table;
+
+    // Moves to the next full slot or sentinel, a group at a time
+    void skip_free() noexcept {
+      while (*ctrl_ < kSentinel) {
+        int shift = control_group(ctrl_).count_leading_free();
+        ctrl_ += shift;
+        slot_ += shift;
+      }
+    }
+
+    const int8_t* ctrl_;
+    U* slot_;
+  };
+
+  hash_table() = default;
+
+  explicit hash_table(size_type bucket_count, const Hash& hash = Hash(),
+                      const KeyEqual& eq = KeyEqual(),
+                      const Allocator& al = Allocator())
+      : al_(al), hash_(hash), eq_(eq) {
+    if (bucket_count > 0) {
+      resize(normalize_capacity(bucket_count));
+    }
+  }
+
+  hash_table(const hash_table& other, const Allocator& al)
+      : al_(al), hash_(other.hash_), eq_(other.eq_) {
+    copy_from(other);
+  }
+
+  hash_table(const hash_table& other)
+      : hash_table(other, al_traits::select_on_container_copy_construction(
+                              other.al_)) {}
+
+  hash_table(hash_table&& other) noexcept
+      : al_(std::move(other.al_)), hash_(other.hash_), eq_(other.eq_) {
+    swap_content(other);
+  }
+
+  hash_table(hash_table&& other, const Allocator& al)
+      : al_(al), hash_(other.hash_), eq_(other.eq_) {
+    if (al_ == other.al_) {
+      swap_content(other);
+    } else {
+      move_from(other);
+    }
+  }
+
+  hash_table& operator=(const hash_table& other) {
+    if (this != &other) {
+      release();
+      if constexpr (al_traits::propagate_on_container_copy_assignment::value) {
+        al_ = other.al_;
+      }
+      hash_ = other.hash_;
+      eq_ = other.eq_;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  hash_table& operator=(hash_table&& other) noexcept(
+      al_traits::propagate_on_container_move_assignment::value ||
+      al_traits::is_always_equal::value) {
+    if (this != &other) {
+      release();
+      hash_ = other.hash_;
+      eq_ = other.eq_;
+      if constexpr (al_traits::propagate_on_container_move_assignment::value) {
+        al_ = std::move(other.al_);
+        swap_content(other);
+      } else if (al_ == other.al_) {
+        swap_content(other);
+      } else {
+        move_from(other);
+      }
+    }
+    return *this;
+  }
+
+  ~hash_table() { release(); }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept { return al_; }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return eq_; }
+
+  iterator begin() noexcept {
+    iterator pos(ctrl(), slots_);
+    pos.skip_free();
+    return pos;
+  }
+
+  const_iterator begin() const noexcept {
+    const_iterator pos(ctrl(), slots_);
+    pos.skip_free();
+    return pos;
+  }
+
+  iterator end() noexcept {
+    return iterator(ctrl() + capacity_, slots_ + capacity_);
+  }
+
+  const_iterator end() const noexcept {
+    return const_iterator(ctrl() + capacity_, slots_ + capacity_);
+  }
+
+  bool empty() const noexcept { return !size_; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept { return al_traits::max_size(al_); }
+
+  // Slots allocated, reported as buckets
+  size_type capacity() const noexcept { return capacity_; }
+  //============================================================================
+
+  // Checks control bytes, their copies and counters, and that every value
+  // is found by its key
+  bool integrity() const {
+    if (!capacity_) {
+      return !size_ && !growth_left_ && !ctrl_ && !slots_;
+    }
+    if (ctrl_[capacity_] != kSentinel) {
+      return false;
+    }
+    for (size_type i = 0; i < kWidth - 1; ++i) {
+      int8_t copy = i < capacity_ ? ctrl_[i] : kEmpty;
+      if (ctrl_[capacity_ + 1 + i] != copy) {
+        return false;
+      }
+    }
+    size_type full = 0;
+    size_type deleted = 0;
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] == kDeleted) {
+        ++deleted;
+      } else if (ctrl_[i] >= 0) {
+        ++full;
+        position pos = find_position(key_of(slots_[i]));
+        if (ctrl_[i] != h2(pos.hash) || !pos.found || pos.index != i) {
+          return false;
+        }
+      } else if (ctrl_[i] != kEmpty) {
+        return false;
+      }
+    }
+    return full == size_ &&
+           growth_left_ == growth_of(capacity_) - size_ - deleted;
+  }
+
+  // Destroys all values, keeping slots allocated
+  void clear() noexcept {
+    if (!capacity_) {
+      return;
+    }
+    destroy_values();
+    reset_ctrl();
+    size_ = 0;
+    growth_left_ = growth_of(capacity_);
+  }
+
+  // Finds slot of value with key equivalent to key
+  template <typename K>
+  position find_position(const K& key) const {
+    uint64_t hash = hash_of(key);
+    if (!capacity_) {
+      return {0, hash, false};
+    }
+    int8_t tag = h2(hash);
+    for (probe_sequence seq(h1(hash), capacity_);; seq.next()) {
+      control_group group(ctrl_ + seq.offset());
+      for (auto match = group.match(tag); match; match.drop_lowest()) {
+        size_type index = seq.offset(match.lowest());
+        if (eq_(key, key_of(slots_[index]))) {
+          return {index, hash, true};
+        }
+      }
+      if (group.match_empty()) {
+        return {0, hash, false};
+      }
+    }
+  }
+
+  iterator iterator_at(size_type index) noexcept {
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+  const_iterator iterator_at(size_type index) const noexcept {
+    return const_iterator(ctrl_ + index, slots_ + index);
+  }
+
+  // Places value constructed from args into a free slot on the probe
+  //  sequence of pos.hash, pos must be obtained by find_position with key
+  //  of the new value and have no value found. May grow the table first
+  // Value must meet additional requirements of EmplaceConstructible from
+  //  args
+  template <typename... Args>
+  iterator emplace_at(const position& pos, Args&&... args) {
+    size_type index = prepare_insert(pos.hash);
+    al_traits::construct(al_, slots_ + index, std::forward<Args>(args)...);
+    occupy(index, pos.hash);
+    return iterator_at(index);
+  }
+
+  // Value must meet additional requirements of EmplaceConstructible from
+  //  args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_unique(Args&&... args) {
+    alignas(Value) unsigned char buffer[sizeof(Value)];
+    Value* value = reinterpret_cast<Value*>(buffer);
+    al_traits::construct(al_, value, std::forward<Args>(args)...);
+    try {
+      position pos = find_position(key_of(*value));
+      if (pos.found) {
+        al_traits::destroy(al_, value);
+        return {iterator_at(pos.index), false};
+      }
+      size_type index = prepare_insert(pos.hash);
+      relocate(slots_ + index, value);
+      occupy(index, pos.hash);
+      return {iterator_at(index), true};
+    } catch (...) {
+      al_traits::destroy(al_, value);
+      throw;
+    }
+  }
+
+  // Value must meet additional requirements of CopyInsertable into *this
+  std::pair<iterator, bool> insert_unique(const value_type& value) {
+    position pos = find_position(key_of(value));
+    if (pos.found) {
+      return {iterator_at(pos.index), false};
+    }
+    return {emplace_at(pos, value), true};
+  }
+
+  // Value must meet additional requirements of MoveInsertable into *this
+  std::pair<iterator, bool> insert_unique(value_type&& value) {
+    position pos = find_position(key_of(value));
+    if (pos.found) {
+      return {iterator_at(pos.index), false};
+    }
+    return {emplace_at(pos, std::move(value)), true};
+  }
+
+  // Returns iterator to value following erased one
+  iterator erase(const_iterator pos) noexcept {
+    size_type index = pos.ctrl_ - ctrl_;
+    al_traits::destroy(al_, slots_ + index);
+    free_slot(index);
+    iterator next = iterator_at(index);
+    next.skip_free();
+    return next;
+  }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator(last.ctrl_, const_cast<Value*>(last.slot_));
+  }
+
+  // Erases element with key equivalent to key, returns number of erased
+  template <typename K>
+  size_type erase_key(const K& key) {
+    position pos = find_position(key);
+    if (!pos.found) {
+      return 0;
+    }
+    al_traits::destroy(al_, slots_ + pos.index);
+    free_slot(pos.index);
+    return 1;
+  }
+
+  void swap(hash_table& other) noexcept(
+      al_traits::propagate_on_container_swap::value ||
+      al_traits::is_always_equal::value) {
+    using std::swap;
+    if constexpr (al_traits::propagate_on_container_swap::value) {
+      swap(al_, other.al_);
+    }
+    swap(hash_, other.hash_);
+    swap(eq_, other.eq_);
+    swap_content(other);
+  }
+
+  template <typename K>
+  iterator find(const K& key) {
+    position pos = find_position(key);
+    return pos.found ? iterator_at(pos.index) : end();
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    position pos = find_position(key);
+    return pos.found ? iterator_at(pos.index) : end();
+  }
+
+  template <typename K>
+  bool contains(const K& key) const {
+    return find_position(key).found;
+  }
+
+  // Makes room for count values without growing
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) {
+      resize(normalize_capacity(count));
+    }
+  }
+
+  // Rebuilds table with at least count slots, also dropping deleted ones
+  void rehash(size_type count) {
+    if (!count && !size_) {
+      release();
+      return;
+    }
+    size_type capacity = normalize_capacity(size_);
+    while (capacity < count) {
+      capacity = capacity * 2 + 1;
+    }
+    resize(capacity);
+  }
+
+ private:
+  // Visits offsets of groups in triangular order, which covers every group
+  // of table with power of two slots
+  class probe_sequence {
+   public:
+    probe_sequence(uint64_t hash, size_type mask) noexcept
+        : mask_(mask), offset_(hash & mask), index_(0) {}
+
+    size_type offset() const noexcept { return offset_; }
+    size_type offset(int i) const noexcept { return (offset_ + i) & mask_; }
+
+    void next() noexcept {
+      index_ += kWidth;
+      offset_ = (offset_ + index_) & mask_;
+    }
+
+   private:
+    size_type mask_;
+    size_type offset_;
+    size_type index_;
+  };
+
+  using ctrl_alloc = typename al_traits::template rebind_alloc<int8_t>;
+  using ctrl_traits = std::allocator_traits<ctrl_alloc>;
+
+  // Values may be dropped along with their slots without visiting them
+  static constexpr bool kTrivialDrop =
+      std::is_trivially_destructible<Value>::value &&
+      !requires(Allocator& al, Value* p) { al.destroy(p); };
+
+  // Control bytes of table without slots, sentinel ends iteration
+  static constexpr int8_t kNoSlots[1] = {kSentinel};
+
+  static const Key& key_of(const Value& value) noexcept {
+    return KeyOfValue()(value);
+  }
+
+  // Starting group on probe sequence
+  static uint64_t h1(uint64_t hash) noexcept { return hash >> 7; }
+  // Tag stored in control byte
+  static int8_t h2(uint64_t hash) noexcept { return hash & 0x7F; }
+
+  // Values that fit in capacity slots before the table grows, at least one
+  // slot stays empty for probing to stop at
+  static size_type growth_of(size_type capacity) noexcept {
+    return capacity - (capacity + 1) / 8;
+  }
+
+  // Smallest capacity that fits count values
+  static size_type normalize_capacity(size_type count) noexcept {
+    size_type capacity = 1;
+    while (growth_of(capacity) < count) {
+      capacity = capacity * 2 + 1;
+    }
+    return capacity;
+  }
+
+  // Hashes of std::hash are often identity, bits are mixed so that both
+  // h1 and h2 depend on all of them
+  template <typename K>
+  uint64_t hash_of(const K& key) const noexcept {
+    uint64_t hash = hash_(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  const int8_t* ctrl() const noexcept { return ctrl_ ? ctrl_ : kNoSlots; }
+
+  // Sets control byte of slot and its copy past the sentinel
+  void set_ctrl(size_type index, int8_t value) noexcept {
+    ctrl_[index] = value;
+    ctrl_[((index - (kWidth - 1)) & capacity_) + ((kWidth - 1) & capacity_)] =
+        value;
+  }
+
+  void reset_ctrl() noexcept {
+    std::memset(ctrl_, kEmpty, capacity_ + kWidth);
+    ctrl_[capacity_] = kSentinel;
+  }
+
+  // First empty or deleted slot on probe sequence of hash
+  size_type find_free(uint64_t hash) const noexcept {
+    for (probe_sequence seq(h1(hash), capacity_);; seq.next()) {
+      auto match = control_group(ctrl_ + seq.offset()).match_free();
+      if (match) {
+        return seq.offset(match.lowest());
+      }
+    }
+  }
+
+  // Finds slot for new value with given hash, growing table if it is full
+  // or rehashing in place if it is mostly filled with deleted slots
+  size_type prepare_insert(uint64_t hash) {
+    if (!capacity_) {
+      resize(1);
+    }
+    size_type index = find_free(hash);
+    if (!growth_left_ && ctrl_[index] != kDeleted) {
+      resize(size_ * 32 <= capacity_ * 25 ? capacity_ : capacity_ * 2 + 1);
+      index = find_free(hash);
+    }
+    return index;
+  }
+
+  // Marks slot prepared by prepare_insert as full
+  void occupy(size_type index, uint64_t hash) noexcept {
+    growth_left_ -= ctrl_[index] == kEmpty;
+    set_ctrl(index, h2(hash));
+    ++size_;
+  }
+
+  // Marks slot as empty if no probe sequence could pass it, that is no
+  // group containing it was ever full, or as deleted otherwise
+  void free_slot(size_type index) noexcept {
+    --size_;
+    bool was_never_full = capacity_ < kWidth - 1;
+    if (!was_never_full) {
+      auto empty_after = control_group(ctrl_ + index).match_empty();
+      auto empty_before =
+          control_group(ctrl_ + ((index - kWidth) & capacity_)).match_empty();
+      was_never_full = empty_before && empty_after &&
+                       empty_after.trailing_zeros() +
+                               empty_before.leading_zeros() <
+                           kWidth;
+    }
+    set_ctrl(index, was_never_full ? kEmpty : kDeleted);
+    growth_left_ += was_never_full;
+  }
+
+  // Moves value to uninitialized dest, ending lifetime of the source
+  void relocate(Value* dest, Value* src) noexcept {
+    if constexpr (sp::is_trivially_relocatable<Value>::value) {
+      std::memcpy(static_cast<void*>(dest), static_cast<void*>(src),
+                  sizeof(Value));
+    } else {
+      al_traits::construct(al_, dest,
+                           std::move(*reinterpret_cast<slot_type*>(src)));
+      al_traits::destroy(al_, src);
+    }
+  }
+
+  // Allocates arrays for capacity slots, all empty
+  void allocate(size_type capacity) {
+    ctrl_alloc al(al_);
+    int8_t* ctrl = ctrl_traits::allocate(al, capacity + kWidth);
+    try {
+      slots_ = al_traits::allocate(al_, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(al, ctrl, capacity + kWidth);
+      throw;
+    }
+    ctrl_ = ctrl;
+    capacity_ = capacity;
+    reset_ctrl();
+  }
+
+  void deallocate(int8_t* ctrl, Value* slots, size_type capacity) noexcept {
+    ctrl_alloc al(al_);
+    ctrl_traits::deallocate(al, ctrl, capacity + kWidth);
+    al_traits::deallocate(al_, slots, capacity);
+  }
+
+  // Moves values to new arrays of capacity slots
+  void resize(size_type capacity) {
+    int8_t* old_ctrl = ctrl_;
+    Value* old_slots = slots_;
+    size_type old_capacity = capacity_;
+    allocate(capacity);
+    growth_left_ = growth_of(capacity) - size_;
+    for (size_type i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] >= 0) {
+        uint64_t hash = hash_of(key_of(old_slots[i]));
+        size_type index = find_free(hash);
+        set_ctrl(index, h2(hash));
+        relocate(slots_ + index, old_slots + i);
+      }
+    }
+    if (old_ctrl) {
+      deallocate(old_ctrl, old_slots, old_capacity);
+    }
+  }
+
+  void destroy_values() noexcept {
+    if constexpr (!kTrivialDrop) {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] >= 0) {
+          al_traits::destroy(al_, slots_ + i);
+        }
+      }
+    }
+  }
+
+  // Destroys all values and frees arrays
+  void release() noexcept {
+    if (!capacity_) {
+      return;
+    }
+    destroy_values();
+    deallocate(ctrl_, slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  // Copies values into the same slots, *this must have no slots
+  void copy_from(const hash_table& other) {
+    if (!other.size_) {
+      return;
+    }
+    allocate(other.capacity_);
+    size_type i = 0;
+    try {
+      for (; i < capacity_; ++i) {
+        if (other.ctrl_[i] >= 0) {
+          al_traits::construct(al_, slots_ + i, other.slots_[i]);
+        }
+      }
+    } catch (...) {
+      while (i--) {
+        if (other.ctrl_[i] >= 0) {
+          al_traits::destroy(al_, slots_ + i);
+        }
+      }
+      deallocate(ctrl_, slots_, capacity_);
+      ctrl_ = nullptr;
+      slots_ = nullptr;
+      capacity_ = 0;
+      throw;
+    }
+    std::memcpy(ctrl_, other.ctrl_, capacity_ + kWidth);
+    size_ = other.size_;
+    growth_left_ = other.growth_left_;
+  }
+
+  // *this must have no slots
+  void move_from(hash_table& other) {
+    reserve(other.size_);
+    for (auto& value : other) {
+      emplace_unique(std::move(value));
+    }
+  }
+
+  void swap_content(hash_table& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+
+  [[no_unique_address]] Allocator al_;
+  [[no_unique_address]] Hash hash_;
+  [[no_unique_address]] KeyEqual eq_;
+  int8_t* ctrl_ = nullptr;
+  Value* slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  size_type growth_left_ = 0;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_HASH_TABLE_H_
@@ -0,0 +1,38 @@
+#ifndef SP_CONTAINERS_KEY_OF_VALUE_H_
+#define SP_CONTAINERS_KEY_OF_VALUE_H_
+
+#include <utility>  // std::pair
+
+namespace sp {
+// Key of value stored in tree is value itself, as in sp::set
+struct identity_key {
+  template <typename T>
+  const T& operator()(const T& value) const noexcept {
+    return value;
+  }
+};
+
+// Key of value stored in tree is its first member, as in sp::map
+struct first_key {
+  template <typename Pair>
+  const typename Pair::first_type& operator()(
+      const Pair& value) const noexcept {
+    return value.first;
+  }
+};
+
+// Values of maps are pair<const Key, T>, their keys are const only for
+// users. Containers keeping values in arrays move them between slots
+// through this type, as the source is destroyed right after
+template <typename Value>
+struct mutable_value {
+  using type = Value;
+};
+
+template <typename Key, typename T>
+struct mutable_value<std::pair<const Key, T>> {
+  using type = std::pair<Key, T>;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_KEY_OF_VALUE_H_
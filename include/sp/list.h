@@ -2,19 +2,33 @@
 #define SP_CONTAINERS_LIST_H_
 
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include <sp/container_stats.h>
 #include <sp/node_iterator.h>
+#include <sp/node_slab.h>
 #include <sp/reverse_iterator.h>
 
 namespace sp {
-template <typename T, typename Allocator = std::allocator<T>>
+// T type must meet requirements of Erasable
+// Allocator type must meet requirements of Allocator
+// SlabSize is number of nodes allocated at once. If zero, every node is
+//  allocated separately, otherwise nodes are carved out of chunks of
+//  SlabSize nodes, erased nodes are kept for reuse and chunks are released
+//  only by clear() and destructor
+// Methods may have additional requirements on types
+template <typename T, typename Allocator = std::allocator<T>,
+          int64_t SlabSize = 0>
 class list {
+  static_assert(SlabSize >= 0, "Slab size must not be negative");
+
   struct Node;
   struct ValueNode;
 
@@ -37,8 +51,8 @@ class list {
   using allocator_type = Allocator;
   using al_traits = std::allocator_traits<allocator_type>;
 
-  using iterator = sp::node_iterator<T, Node, list>;
-  using const_iterator = sp::node_iterator<const T, Node, list>;
+  using iterator = sp::node_iterator<T, ValueNode, list>;
+  using const_iterator = sp::node_iterator<const T, ValueNode, list>;
   using reverse_iterator = sp::reverse_iterator<iterator>;
   using const_reverse_iterator = sp::reverse_iterator<const_iterator>;
 
@@ -49,53 +63,49 @@ class list {
       : al_(static_cast<rebind_alloc>(al)), size_(0) {}
 
   list(size_type count, const_reference val, const Allocator& al = Allocator())
-      : al_(static_cast<rebind_alloc>(al)), size_(count) {
+      : list(al) {
     push_nodes(&head_, count, val);
   };
 
-  list(size_type count, const Allocator& al = Allocator())
-      : al_(static_cast<rebind_alloc>(al)), size_(count) {
+  list(size_type count, const Allocator& al = Allocator()) : list(al) {
     push_nodes(&head_, count);
   }
 
   template <typename InputIterator>
   list(InputIterator first, InputIterator last,
        const Allocator& al = Allocator())
-      : al_(static_cast<rebind_alloc>(al)), size_(std::distance(first, last)) {
-    push_nodes(&head_, first, last);
+      : list(al) {
+    push_range(&head_, first, last);
   }
 
   list(std::initializer_list<T> vals, const Allocator& al = Allocator())
       : list(vals.begin(), vals.end(), al) {}
 
-  list(const list& other) : list(other.begin(), other.end(), other.al_) {}
+  list(const list& other)
+      : list(other, al_traits::select_on_container_copy_construction(
+                        other.get_allocator())) {}
 
-  list(const list& other, const Allocator& al)
-      : al_(al_traits::select_on_container_copy_construction(other.al_)),
-        size_(other.size_) {
-    push_nodes(&head_, other.begin(), other.end());
+  list(const list& other, const Allocator& al) : list(al) {
+    push_range(&head_, other.begin(), other.end());
   };
 
-  list(list&& other) : size_(other.size_) {
-    if constexpr (!al_traits::is_always_equal::value) {
-      al_ = std::move(other.al_);
-    }
-    head_.bind(other.head_.prev_node, other.head_.next_node);
-    other.head_.unbind();
+  list(list&& other) noexcept
+      : al_(std::move(other.al_)), size_(other.size_) {
+    head_.swap(other.head_);
+    slabs_.swap(other.slabs_);
     other.size_ = 0;
   }
 
+  // T must meet additional requirements of MoveInsertable into *this
   list(list&& other, const Allocator& al) : list(al) {
-    // if (al == other.al_) {
-    //   swap(other);
-    // } else {
-    //   pointer_buffer temp(other.size_, &al_);
-    //   move_from(temp.ptr, other.buf_.ptr, other.size_);
-    //   buf_.swap(temp);
-    //   size_ = other.size_;
-    // }
-    std::swap(size_, other.size_);
-    std::swap(head_, other.head_);
+    if (al_ == other.al_) {
+      std::swap(size_, other.size_);
+      head_.swap(other.head_);
+      slabs_.swap(other.slabs_);
+    } else {
+      push_range(&head_, std::make_move_iterator(other.begin()),
+                 std::make_move_iterator(other.end()));
+    }
   }
 
   // list& operator=(list& other) {
@@ -112,7 +122,7 @@ class list {
   //   return *this;
   // }
 
-  virtual ~list() noexcept { clear(); }
+  ~list() noexcept { clear(); }
 
   //============================================================================
   allocator_type get_allocator() const noexcept {
@@ -129,9 +139,9 @@ class list {
   const_iterator begin() const { return const_iterator(head_.next_node); }
   const_iterator cbegin() const { return const_iterator(head_.next_node); }
 
-  iterator end() { return iterator(head_); }
-  const_iterator end() const { return const_iterator(head_); }
-  const_iterator cend() const { return const_iterator(head_); }
+  iterator end() { return iterator(&head_); }
+  const_iterator end() const { return const_iterator(&head_); }
+  const_iterator cend() const { return const_iterator(&head_); }
 
   bool empty() const noexcept { return !size_; }
   size_type max_size() const noexcept { return rebind_traits::max_size(al_); }
@@ -147,60 +157,303 @@ class list {
     return count == size_;
   }
 
+  // Releases all memory held by list, including spare nodes of slabs
   void clear() noexcept {
-    pop_nodes(head_.next_node, &head_);
-    size_ = 0;
-    head_.next_node = &head_;
-    head_.prev_node = &head_;
-  }
-
-  // iterator insert(const_iterator pos, const_reference value) {
-  //   Node* some = node_al_.allocate(1);
-  //   Node* target = const_cast<Node*>(pos.base());
-  //   some->construct(target->prev_node, target, al_, value);
-  //   some->bind(target->prev_node, target);
-  //   size_ += 1;
-  //   return iterator(some);
-  // }
+    if constexpr (kSlab) {
+      if constexpr (!kTrivialDrop) {
+        for (Node* ptr = head_.next_node; ptr != &head_;) {
+          ValueNode* node = cast(ptr);
+          ptr = ptr->next_node;
+          rebind_traits::destroy(al_, node);
+        }
+      }
+      head_.prev_node = &head_;
+      head_.next_node = &head_;
+      sp::record_stat<list>(&container_stats::node_deallocations, size_);
+      size_ = 0;
+      slabs_.release(al_);
+    } else {
+      pop_nodes(head_.next_node, &head_);
+    }
+  }
 
-  // iterator insert(const_iterator pos, move_reference value) {
-  //   Node* some = node_al_.allocate(1);
-  //   Node* target = const_cast<Node*>(pos.base());
-  //   some->construct(target->prev_node, target, al_,
-  //                   std::forward<value_type>(value));
-  //   some->bind(target->prev_node, target);
-  //   size_ += 1;
-  //   return iterator(some);
-  // }
+  // T must meet additional requirements of CopyInsertable into *this
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
 
-  // iterator insert(const_iterator pos, size_type count, const_reference value);
+  // T must meet additional requirements of MoveInsertable into *this
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
 
-  // template <typename InputIterator>
-  // iterator insert(const_iterator first, InputIterator end, InputIterator
-  // last);
+  // T must meet additional requirements of CopyInsertable into *this
+  iterator insert(const_iterator pos, size_type count, const_reference value) {
+    return iterator(push_nodes(link(pos), count, value));
+  }
 
-  // iterator insert(const_iterator pos, std::initializer_list<T> vals);
+  // T must meet additional requirements of EmplaceConstructible from *first
+  template <typename InputIterator>
+  iterator insert(const_iterator pos, InputIterator first, InputIterator last) {
+    return iterator(push_range(link(pos), first, last));
+  }
 
-  // //  Deletes an element at pos
-  // void erase(iterator pos) {
-  //   Node* nextNode = (pos + 1).ptr_;
-  //   Node* prevNode = (pos - 1).ptr_;
-  //   prevNode->next_ = nextNode;
-  //   nextNode->prev_ = prevNode;
-  //   delete pos.ptr_;
-  //   counter_ -= 1;
-  // }
+  // Same as insert(pos, vals.begin(), vals.end())
+  iterator insert(const_iterator pos, std::initializer_list<T> vals) {
+    return insert(pos, vals.begin(), vals.end());
+  }
 
-  // void push_back(const_reference value) {
-  //   //  insert puts a node at a position before the one iterator is pointing
-  //   to insert(end(), value);
-  // }
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    Node* target = link(pos);
+    make_node(std::forward<Args>(args)...)->bind(target->prev_node, target);
+    ++size_;
+    return iterator(target->prev_node);
+  }
+
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    return *emplace(cend(), std::forward<Args>(args)...);
+  }
+
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    return *emplace(cbegin(), std::forward<Args>(args)...);
+  }
+
+  // No additional requirements on types
+  iterator erase(const_iterator pos) noexcept {
+    Node* next = link(pos)->next_node;
+    pop_nodes(link(pos), next);
+    return iterator(next);
+  }
+
+  // No additional requirements on types
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    pop_nodes(link(first), link(last));
+    return iterator(link(last));
+  }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  void push_back(const_reference value) { emplace_back(value); }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+  // T must meet additional requirements of CopyInsertable into *this
+  void push_front(const_reference value) { emplace_front(value); }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  void push_front(value_type&& value) { emplace_front(std::move(value)); }
+
+  // No additional requirements on types
+  void pop_back() noexcept { pop_nodes(head_.prev_node, &head_); }
+
+  // No additional requirements on types
+  void pop_front() noexcept {
+    pop_nodes(head_.next_node, head_.next_node->next_node);
+  }
+
+  // Moves all elements of other before pos without copying them
+  // Allocators of lists must compare equal
+  void splice(const_iterator pos, list& other) noexcept {
+    if (&other == this) {
+      return;
+    }
+    transfer(link(pos), other.head_.next_node, &other.head_);
+    size_ += other.size_;
+    other.size_ = 0;
+    // spliced nodes may live in chunks of other
+    slabs_.adopt(other.slabs_);
+  }
+
+  // Same as splice(pos, other)
+  void splice(const_iterator pos, list&& other) noexcept {
+    splice(pos, other);
+  }
+
+  // Moves element at it from other before pos
+  // Allocators of lists must compare equal
+  // In slab mode element of other list is moved into new node, since its
+  //  node belongs to slab of other
+  void splice(const_iterator pos, list& other,
+              const_iterator it) noexcept(!kSlab) {
+    if constexpr (kSlab) {
+      if (&other != this) {
+        emplace(pos, std::move(*iterator(link(it))));
+        other.erase(it);
+        return;
+      }
+    }
+    Node* node = link(it);
+    if (node == link(pos)) {
+      return;
+    }
+    transfer(link(pos), node, node->next_node);
+    ++size_;
+    --other.size_;
+  }
+
+  // Same as splice(pos, other, it)
+  void splice(const_iterator pos, list&& other,
+              const_iterator it) noexcept(!kSlab) {
+    splice(pos, other, it);
+  }
+
+  // Moves elements in [first, last) from other before pos, pos must not be
+  //  in [first, last). Constant if other is *this, linear in distance
+  //  between first and last otherwise
+  // Allocators of lists must compare equal
+  // In slab mode elements of other list are moved into new nodes, since
+  //  their nodes belong to slabs of other
+  void splice(const_iterator pos, list& other, const_iterator first,
+              const_iterator last) noexcept(!kSlab) {
+    if (first == last) {
+      return;
+    }
+    if (&other != this) {
+      if constexpr (kSlab) {
+        insert(pos, std::make_move_iterator(iterator(link(first))),
+               std::make_move_iterator(iterator(link(last))));
+        other.erase(first, last);
+        return;
+      }
+      size_type count = std::distance(first, last);
+      size_ += count;
+      other.size_ -= count;
+    }
+    transfer(link(pos), link(first), link(last));
+  }
+
+  // Same as splice(pos, other, first, last)
+  void splice(const_iterator pos, list&& other, const_iterator first,
+              const_iterator last) noexcept(!kSlab) {
+    splice(pos, other, first, last);
+  }
+
+  // Same as merge(other, std::less<>())
+  void merge(list& other) { merge(other, std::less<>()); }
+
+  // Same as merge(other, std::less<>())
+  void merge(list&& other) { merge(other, std::less<>()); }
+
+  // Merges sorted other into sorted *this by relinking nodes, elements of
+  //  *this go first among equivalent ones. Other becomes empty
+  // Allocators of lists must compare equal
+  // If comp throws, lists stay valid, but their order is unspecified
+  template <typename Compare>
+  void merge(list& other, Compare comp) {
+    if (&other == this) {
+      return;
+    }
+    Node* first = head_.next_node;
+    Node* src = other.head_.next_node;
+    try {
+      while (first != &head_ && src != &other.head_) {
+        if (comp(cast(src)->value(), cast(first)->value())) {
+          Node* next = src->next_node;
+          transfer(first, src, next);
+          ++size_;
+          --other.size_;
+          src = next;
+        } else {
+          first = first->next_node;
+        }
+      }
+    } catch (...) {
+      if constexpr (kSlab) {
+        splice(cend(), other);
+      }
+      throw;
+    }
+    splice(cend(), other);
+  }
+
+  // Same as merge(other, comp)
+  template <typename Compare>
+  void merge(list&& other, Compare comp) {
+    merge(other, comp);
+  }
 
-  // void pop_back() { erase(end() - 1); }
+  // Reverses order of elements
+  void reverse() noexcept {
+    Node* node = &head_;
+    do {
+      std::swap(node->prev_node, node->next_node);
+      node = node->prev_node;
+    } while (node != &head_);
+  }
 
-  // void push_front(const_reference value) { insert(begin(), value); }
+  // Same as unique(std::equal_to<>())
+  size_type unique() { return unique(std::equal_to<>()); }
+
+  // Erases all but first element of every group of consecutive elements,
+  //  for which pred(first of group, element) holds. Returns number of
+  //  erased elements
+  template <typename BinaryPredicate>
+  size_type unique(BinaryPredicate pred) {
+    size_type before = size_;
+    if (size_ < 2) {
+      return 0;
+    }
+    Node* first = head_.next_node;
+    for (Node* next = first->next_node; next != &head_;
+         next = first->next_node) {
+      if (pred(cast(first)->value(), cast(next)->value())) {
+        pop_nodes(next, next->next_node);
+      } else {
+        first = next;
+      }
+    }
+    return before - size_;
+  }
 
-  // void pop_front() { erase(begin()); }
+  // Same as sort(std::less<>())
+  void sort() { sort(std::less<>()); }
+
+  // Stable bottom-up merge sort relinking nodes, takes O(n log n)
+  //  comparisons and constant memory
+  // If comp throws, list stays valid, but its order is unspecified
+  template <typename Compare>
+  void sort(Compare comp) {
+    if (size_ < 2) {
+      return;
+    }
+    // runs[i] is either empty or sorted run of 2^i nodes, nodes of higher
+    // runs precede nodes of lower ones
+    Node* runs[64] = {};
+    Node* rest = head_.next_node;
+    Node* carry = nullptr;
+    head_.prev_node->next_node = nullptr;
+    try {
+      while (rest) {
+        carry = rest;
+        rest = rest->next_node;
+        carry->next_node = nullptr;
+        int i = 0;
+        for (; runs[i]; ++i) {
+          carry = merge_runs(runs[i], carry, comp);
+        }
+        runs[i] = carry;
+        carry = nullptr;
+      }
+      for (Node*& run : runs) {
+        if (run) {
+          carry = merge_runs(run, carry, comp);
+        }
+      }
+    } catch (...) {
+      for (Node* run : runs) {
+        carry = append_run(run, carry);
+      }
+      relink(append_run(carry, rest));
+      throw;
+    }
+    relink(carry);
+  }
 
   void swap(list& other) noexcept(
       al_traits::propagate_on_container_swap::value ||
@@ -211,111 +464,15 @@ class list {
     }
     std::swap(size_, other.size_);
     head_.swap(other.head_);
+    slabs_.swap(other.slabs_);
   }
 
-  // void merge(list& other) {
-  //   iterator iter = begin();
-  //   iterator iter_other = other.begin();
-  //   while (iter != end() && iter_other != other.end()) {
-  //     if (*iter > *iter_other) {
-  //       insert(iter, *iter_other);
-  //       other.erase(iter_other);
-  //       ++iter_other;
-  //     } else {
-  //       ++iter;
-  //     }
-  //   }
-  // }
-
-  // //  No elements are copied or moved, only the internal
-  // //  pointers of the list nodes are re-pointed. Transfers all
-  // //  elements from other into *this. The elements are inserted
-  // //  before the element pointed to by pos. The container other
-  // //  becomes empty after the operation.
-  // void splice(const_iterator pos, list& other) {
-  //   Node* nextNode = const_cast<Node*>((pos).ptr_);
-  //   Node* prevNode = const_cast<Node*>((pos - 1).ptr_);
-  //   prevNode->next_ = other.begin().ptr_;
-  //   nextNode->prev_ = other.end().ptr_->prev_;
-  //   other.head_.prev_ = &other.head_;
-  //   other.head_.next_ = &other.head_;
-  //   counter_ += other.counter_;
-  //   other.counter_ = 0;
-  // }
-  // void reverse() {
-  //   Node* ptr = head_.next_;
-  //   for (size_type i = 0; i < counter_; ++i) {
-  //     insert(ptr, back());
-  //     pop_back();
-  //   }
-  // }
-
-  // void unique() {
-  //   iterator first = begin();
-  //   iterator second = first + 1;
-  //   while (second != end()) {
-  //     if (*second == *first) {
-  //       erase(second);
-  //       second = first;
-  //     } else {
-  //       ++first;
-  //     }
-  //     ++second;
-  //   }
-  // }
-
-  // // void sort() {
-  // //   if (counter_ > 1) {
-  // //       MergeSorting(&this);
-  // //   }
-  // // }
-
-  // //  rename to sort
-
-  // // void sort() {
-  // //     if (counter_ < 2) {
-  // //         return;
-  // //       }
-  // //     list a();
-  // //     list b();
-  // //     FrontBackSplit(*this, a, b);
-  // //     a.sort();
-  // //     b.sort();
-  // //     *this = a.merge(b);
-  // //     return;
-  // // }
-
-  // // void FrontBackSplit(list &initial, list &a, list &b) {
-  // //       iterator middle = initial.begin();
-  // //       size_type limit = (initial.counter_ % 2 > 0) ? initial.counter_ / 2 +
-  // 1 : initial.counter_ / 2;
-  // //       size_type i = 0;
-  // //       for (; i < limit; ++i) {
-  // //           ++middle;
-  // //           // middle = middle.ptr_->next;
-  // //       }
-  // //       b.head_.next_ = middle.ptr_;
-  // //       b.head_.prev_ = initial.end().ptr_->prev_;
-  // //       initial.end().ptr_->prev_.next_ = &b.head_;
-  // //       b.counter_ = initial.counter_ / 2;
-
-  // //       a.head_.next_ = initial.begin().ptr_;
-  // //       a.head_.prev_ = middle.ptr_->prev_;
-  // //       middle.ptr_->prev_.next_ = &a.head_;
-  // //       initial.begin().ptr_->prev = &a.head_;
-  // //       a.counter_ = i;
-
-  // //       initial.head_.prev_ = initial.head_;
-  // //       initial.head_.next_ = initial.head_.prev_;
-  // //       initial.counter_ = 0;
-  // // }
-
   bool operator==(const list& other) const {
     if (size_ != other.size_) {
       return false;
     }
     const_iterator second = other.begin();
-    for (auto first = begin(); first != end(); ++first) {
+    for (auto first = begin(); first != end(); ++first, ++second) {
       if (*first != *second) return false;
     }
     return true;
@@ -325,21 +482,18 @@ class list {
 
   friend std::ostream& operator<<(std::ostream& os, const list& target) {
     const Node* ptr = target.head_.next_node;
-    for (; ptr->next_node != target.head_; ptr = ptr->next_node) {
-      os << ptr->data << ' ';
+    for (; ptr->next_node != &target.head_; ptr = ptr->next_node) {
+      os << cast(ptr)->data << ' ';
     }
-    os << ptr->data;
+    os << cast(ptr)->data;
     return os;
   }
 
  private:
+  // Links of the list. Sentinel head_ is a bare Node and every other node is
+  // a ValueNode, so nodes need no vtable and are downcast statically
   struct Node {
     Node() noexcept : prev_node(this), next_node(this) {}
-    Node(Node* prev, Node* next) noexcept : prev_node(prev), next_node(next) {
-      prev->next_node = this;
-      next->prev_node = this;
-    }
-    virtual ~Node() = default;
 
     Node* next() const noexcept { return next_node; }
     Node* prev() const noexcept { return prev_node; }
@@ -358,78 +512,221 @@ class list {
       next_node = nullptr;
     }
 
-    void swap(Node& other) {
-      prev_node->next = &other;
-      next_node->prev = &other;
-      other.prev_node->next = this;
-      other.next_node->prev = this;
+    // Exchanges chains of two sentinels
+    void swap(Node& other) noexcept {
       std::swap(prev_node, other.prev_node);
       std::swap(next_node, other.next_node);
+      adopt(&other);
+      other.adopt(this);
+    }
+
+    // Repoints neighbours which linked to former at this node
+    void adopt(Node* former) noexcept {
+      if (next_node == former) {
+        prev_node = this;
+        next_node = this;
+      } else {
+        prev_node->next_node = this;
+        next_node->prev_node = this;
+      }
     }
 
     Node* prev_node;
     Node* next_node;
   };
 
-  struct ValueNode final : public Node {
-    ValueNode() = default;
-    ValueNode(const T& value) noexcept(
-        std::is_nothrow_copy_constructible<T>::value)
-        : data(value) {}
-    ValueNode(const T& value, Node* prev,
-              Node* next) noexcept(std::is_nothrow_copy_constructible<T>::value)
-        : Node(prev, next), data(value) {}
+  struct ValueNode : public Node {
+    using base_type = Node;
 
     template <typename... Args>
-    ValueNode(Node* prev, Node* next) noexcept(
+    explicit ValueNode(Args&&... args) noexcept(
         std::is_nothrow_constructible<T, Args...>::value)
-        : Node(prev, next), data(value) {}
+        : data(std::forward<Args>(args)...) {}
 
-    T& value() { return data; }
-    const T& value() const { return data; }
+    T& value() noexcept { return data; }
+    const T& value() const noexcept { return data; }
 
     T data;
   };
 
-  constexpr ValueNode* cast(Node* ptr) const {
-    return dynamic_cast<ValueNode*>(ptr);
+  static_assert(sizeof(Node) == 2 * sizeof(Node*),
+                "List links must take exactly two pointers");
+  static_assert(!std::is_polymorphic<ValueNode>::value,
+                "List nodes must not carry vtable pointer");
+
+  static constexpr bool kSlab = SlabSize > 0;
+
+  // Nodes may be dropped along with their memory without visiting them
+  static constexpr bool kTrivialDrop =
+      std::is_trivially_destructible<T>::value &&
+      !requires(rebind_alloc& al, ValueNode* p) { al.destroy(p); };
+
+  static ValueNode* cast(Node* ptr) noexcept {
+    return static_cast<ValueNode*>(ptr);
+  }
+
+  static const ValueNode* cast(const Node* ptr) noexcept {
+    return static_cast<const ValueNode*>(ptr);
+  }
+
+  static Node* link(const_iterator pos) noexcept {
+    return const_cast<Node*>(pos.base());
+  }
+
+  ValueNode* allocate_node() {
+    if constexpr (kSlab) {
+      return slabs_.allocate(al_);
+    } else {
+      return rebind_traits::allocate(al_, 1);
+    }
+  }
+
+  void deallocate_node(ValueNode* node) noexcept {
+    if constexpr (kSlab) {
+      slabs_.deallocate(node);
+    } else {
+      rebind_traits::deallocate(al_, node, 1);
+    }
+  }
+
+  template <typename... Args>
+  ValueNode* make_node(Args&&... args) {
+    ValueNode* node = allocate_node();
+    try {
+      rebind_traits::construct(al_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate_node(node);
+      throw;
+    }
+    sp::record_stat<list>(&container_stats::node_allocations);
+    return node;
+  }
+
+  void drop_node(ValueNode* node) noexcept {
+    rebind_traits::destroy(al_, node);
+    deallocate_node(node);
+    sp::record_stat<list>(&container_stats::node_deallocations);
   }
 
+  // Links count nodes constructed from args before pos, returns first of
+  // them. Has no effect if exception is thrown
   template <typename... Args>
-  Node* push_nodes(Node* where, sp::size_type count, Args&&... args) {
-    for (size_type i = 0; i < count; ++i, where = where->next_node) {
-      ValueNode* some = al_.allocate(1);
-      rebind_traits::construct(al_, some, std::forward<Args>(args)...);
-      some->bind(where, &head_);
+  Node* push_nodes(Node* pos, size_type count, const Args&... args) {
+    Node* prev = pos->prev_node;
+    try {
+      for (size_type i = 0; i < count; ++i) {
+        make_node(args...)->bind(pos->prev_node, pos);
+        ++size_;
+      }
+    } catch (...) {
+      pop_nodes(prev->next_node, pos);
+      throw;
     }
-    return where;
+    return prev->next_node;
   }
 
+  // Links nodes constructed from [first, last) before pos, returns first of
+  // them. Has no effect if exception is thrown
   template <typename InputIterator>
-  Node* push_nodes(Node* where, InputIterator first, InputIterator last) {
-    for (; first != last; ++first, where = where->next_node) {
-      ValueNode* some = al_.allocate(1);
-      rebind_traits::construct(al_, some, *first);
-      some->bind(where, &head_);
+  Node* push_range(Node* pos, InputIterator first, InputIterator last) {
+    Node* prev = pos->prev_node;
+    try {
+      for (; first != last; ++first) {
+        make_node(*first)->bind(pos->prev_node, pos);
+        ++size_;
+      }
+    } catch (...) {
+      pop_nodes(prev->next_node, pos);
+      throw;
+    }
+    return prev->next_node;
+  }
+
+  // Unlinks and destroys nodes in [first, last)
+  void pop_nodes(Node* first, Node* last) noexcept {
+    first->prev_node->next_node = last;
+    last->prev_node = first->prev_node;
+    while (first != last) {
+      ValueNode* node = cast(first);
+      first = first->next_node;
+      drop_node(node);
+      --size_;
+    }
+  }
+
+  // Moves [first, last) before pos, range may belong to other list
+  static void transfer(Node* pos, Node* first, Node* last) noexcept {
+    if (first == last) {
+      return;
+    }
+    Node* tail = last->prev_node;
+    first->prev_node->next_node = last;
+    last->prev_node = first->prev_node;
+    first->prev_node = pos->prev_node;
+    tail->next_node = pos;
+    pos->prev_node->next_node = first;
+    pos->prev_node = tail;
+  }
+
+
+  // Merges null terminated sorted runs linked by next_node, left goes first
+  // among equivalent nodes. Both runs are consumed, if comp throws left
+  // holds all their nodes
+  template <typename Compare>
+  static Node* merge_runs(Node*& left, Node*& right, Compare& comp) {
+    Node merged;
+    Node* tail = &merged;
+    try {
+      while (left && right) {
+        if (comp(cast(right)->value(), cast(left)->value())) {
+          tail->next_node = right;
+          right = right->next_node;
+        } else {
+          tail->next_node = left;
+          left = left->next_node;
+        }
+        tail = tail->next_node;
+      }
+    } catch (...) {
+      tail->next_node = append_run(left, right);
+      left = merged.next_node;
+      right = nullptr;
+      throw;
+    }
+    tail->next_node = left ? left : right;
+    left = nullptr;
+    right = nullptr;
+    return merged.next_node;
+  }
+
+  // Links null terminated run tail after run head, returns resulting run
+  static Node* append_run(Node* head, Node* tail) noexcept {
+    if (!head) {
+      return tail;
+    }
+    Node* last = head;
+    while (last->next_node) {
+      last = last->next_node;
     }
-    return where;
+    last->next_node = tail;
+    return head;
   }
 
-  void pop_nodes(Node* first, Node* last) {
-    Node* bwd = first;
-    Node* fwd = first->next_node;
-    while (bwd != last) {
-      ValueNode* x = cast(bwd);
-      rebind_traits::destroy(al_, x);
-      al_.deallocate(x, 1);
-      bwd = fwd;
-      fwd = fwd->next_node;
+  // Makes null terminated run linked by next_node content of the list
+  void relink(Node* run) noexcept {
+    Node* prev = &head_;
+    for (; run; prev = run, run = run->next_node) {
+      run->prev_node = prev;
+      prev->next_node = run;
     }
+    prev->next_node = &head_;
+    head_.prev_node = prev;
   }
 
-  rebind_alloc al_;
+  [[no_unique_address]] rebind_alloc al_;
   size_type size_;
   Node head_;
+  [[no_unique_address]] sp::node_slab<ValueNode, SlabSize> slabs_;
 };
 
 }  // namespace sp
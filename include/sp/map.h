@@ -1,4 +1,350 @@
-#ifndef SRC_CONTAINERS_S21_MAP_H_
-#define SRC_CONTAINERS_S21_MAP_H_
+#ifndef SP_CONTAINERS_MAP_H_
+#define SP_CONTAINERS_MAP_H_
 
-#endif  // SRC_CONTAINERS_S21_MAP_H_
\ No newline at end of file
+#include <cstdint>           // int64_t
+#include <functional>        // std::less
+#include <initializer_list>  // std::initializer_list
+#include <memory>            // std::allocator
+#include <stdexcept>         // std::out_of_range
+#include <tuple>             // std::forward_as_tuple
+#include <type_traits>       // std::is_convertible
+#include <utility>           // std::pair, std::piecewise_construct
+
+#include <sp/red_black_tree.h>
+
+namespace sp {
+// Key type must meet requirements of Erasable
+// T type must meet requirements of Erasable
+// Compare must induce strict weak ordering on keys, if it is transparent
+//  lookup methods accept any type comparable with keys
+// Allocator type must meet requirements of Allocator
+// SlabSize is number of nodes allocated at once, see sp::red_black_tree
+// Methods may have additional requirements on types
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          int64_t SlabSize = 0>
+class map {
+  using tree_type =
+      sp::red_black_tree<Key, std::pair<const Key, T>, sp::first_key,
+                         Compare, Allocator, SlabSize>;
+
+  static constexpr bool kTransparent =
+      requires { typename Compare::is_transparent; };
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = int64_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+  // Compares values by their keys
+  class value_compare {
+   public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const {
+      return comp(lhs.first, rhs.first);
+    }
+
+   protected:
+    friend class map;
+    value_compare(Compare c) : comp(c) {}
+
+    Compare comp;
+  };
+
+  map() = default;
+
+  explicit map(const Compare& comp, const Allocator& al = Allocator())
+      : tree_(comp, al) {}
+
+  explicit map(const Allocator& al) : tree_(Compare(), al) {}
+
+  template <typename InputIterator>
+  map(InputIterator first, InputIterator last,
+      const Compare& comp = Compare(), const Allocator& al = Allocator())
+      : tree_(comp, al) {
+    insert(first, last);
+  }
+
+  map(std::initializer_list<value_type> vals, const Compare& comp = Compare(),
+      const Allocator& al = Allocator())
+      : map(vals.begin(), vals.end(), comp, al) {}
+
+  map(const map& other) = default;
+  map(const map& other, const Allocator& al) : tree_(other.tree_, al) {}
+  map(map&& other) noexcept = default;
+  map(map&& other, const Allocator& al) : tree_(std::move(other.tree_), al) {}
+
+  map& operator=(const map& other) = default;
+  map& operator=(map&& other) = default;
+
+  map& operator=(std::initializer_list<value_type> vals) {
+    clear();
+    insert(vals);
+    return *this;
+  }
+
+  ~map() = default;
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  }
+
+  key_compare key_comp() const { return tree_.key_comp(); }
+  value_compare value_comp() const { return value_compare(key_comp()); }
+
+  T& at(const Key& key) {
+    iterator pos = find(key);
+    if (pos == end()) {
+      throw std::out_of_range("Key is not present in map");
+    }
+    return pos->second;
+  }
+
+  const T& at(const Key& key) const {
+    const_iterator pos = find(key);
+    if (pos == end()) {
+      throw std::out_of_range("Key is not present in map");
+    }
+    return pos->second;
+  }
+
+  // T must meet additional requirements of DefaultConstructible, Key of
+  //  CopyConstructible
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  // T must meet additional requirements of DefaultConstructible, Key of
+  //  MoveConstructible
+  T& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  iterator begin() noexcept { return tree_.begin(); }
+  const_iterator begin() const noexcept { return tree_.begin(); }
+  const_iterator cbegin() const noexcept { return tree_.begin(); }
+
+  iterator end() noexcept { return tree_.end(); }
+  const_iterator end() const noexcept { return tree_.end(); }
+  const_iterator cend() const noexcept { return tree_.end(); }
+
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  //============================================================================
+
+  bool integrity() const { return tree_.integrity(); }
+
+  void clear() noexcept { tree_.clear(); }
+
+  // value_type must meet additional requirements of CopyInsertable
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return tree_.insert_unique(value);
+  }
+
+  // value_type must meet additional requirements of MoveInsertable
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return tree_.insert_unique(std::move(value));
+  }
+
+  // value_type must meet additional requirements of EmplaceConstructible
+  //  from *first
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) {
+      tree_.emplace_unique(*first);
+    }
+  }
+
+  // Same as insert(vals.begin(), vals.end())
+  void insert(std::initializer_list<value_type> vals) {
+    insert(vals.begin(), vals.end());
+  }
+
+  // T must meet additional requirements of Assignable from value
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // T must meet additional requirements of Assignable from value
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+    auto result = try_emplace(std::move(key), std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // value_type must meet additional requirements of EmplaceConstructible
+  //  from args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.emplace_unique(std::forward<Args>(args)...);
+  }
+
+  // Constructs T from args only if key is not present, never moves from
+  //  arguments otherwise
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    auto pos = tree_.find_position(key);
+    if (pos.found) {
+      return {iterator(pos.found), false};
+    }
+    iterator inserted = tree_.emplace_at(
+        pos, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {inserted, true};
+  }
+
+  // Same as above, but moves key
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    auto pos = tree_.find_position(key);
+    if (pos.found) {
+      return {iterator(pos.found), false};
+    }
+    iterator inserted = tree_.emplace_at(
+        pos, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {inserted, true};
+  }
+
+  iterator erase(iterator pos) noexcept { return tree_.erase(pos); }
+  iterator erase(const_iterator pos) noexcept { return tree_.erase(pos); }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    return tree_.erase(first, last);
+  }
+
+  size_type erase(const Key& key) { return tree_.erase_key(key); }
+
+  template <typename K>
+    requires(kTransparent && !std::is_convertible<K, const_iterator>::value)
+  size_type erase(K&& key) {
+    return tree_.erase_key(key);
+  }
+
+  void swap(map& other) noexcept(noexcept(tree_.swap(other.tree_))) {
+    tree_.swap(other.tree_);
+  }
+
+  //============================================================================
+  size_type count(const Key& key) const { return tree_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  size_type count(const K& key) const {
+    return tree_.contains(key);
+  }
+
+  iterator find(const Key& key) { return tree_.find(key); }
+  const_iterator find(const Key& key) const { return tree_.find(key); }
+
+  template <typename K>
+    requires kTransparent
+  iterator find(const K& key) {
+    return tree_.find(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  }
+
+  bool contains(const Key& key) const { return tree_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  bool contains(const K& key) const {
+    return tree_.contains(key);
+  }
+
+  iterator lower_bound(const Key& key) { return tree_.lower_bound(key); }
+  const_iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  }
+
+  iterator upper_bound(const Key& key) { return tree_.upper_bound(key); }
+  const_iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  //============================================================================
+
+  // Key and T must meet additional requirements of EqualityComparable
+  bool operator==(const map& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    const_iterator second = other.begin();
+    for (auto first = begin(); first != end(); ++first, ++second) {
+      if (!(*first == *second)) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const map& other) const { return !(*this == other); }
+
+ private:
+  tree_type tree_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_MAP_H_
@@ -0,0 +1,255 @@
+#ifndef SP_CONTAINERS_MPMC_QUEUE_H_
+#define SP_CONTAINERS_MPMC_QUEUE_H_
+
+#include <atomic>       // std::atomic, std::memory_order
+#include <bit>          // std::bit_ceil
+#include <cstddef>      // std::byte
+#include <cstdint>      // int64_t, uint64_t
+#include <iterator>     // std::distance
+#include <memory>       // std::allocator, std::allocator_traits
+#include <new>          // std::launder
+#include <stdexcept>    // std::length_error
+#include <type_traits>  // as name suggests
+#include <utility>      // std::forward, std::move
+
+#include <sp/concurrency.h>  // sp::kCacheLineSize, sp::spin_wait
+
+namespace sp {
+// Bounded lock-free queue for any number of producer and consumer threads.
+//  Each slot of a power of two ring buffer carries a sequence number
+//  telling which position may take it next, so a thread claims a slot
+//  with one compare-and-swap on the shared position and then works on
+//  the slot without touching positions of the other side. Batch methods
+//  claim whole runs of ready slots with a single compare-and-swap
+// Elements are constructed before a slot is claimed and moved in after,
+//  so a throwing constructor never leaves a claimed slot behind
+// T type must meet requirements of Erasable, NothrowMoveConstructible and
+//  NothrowMoveAssignable
+// Allocator type must meet requirements of Allocator
+template <typename T, typename Allocator = std::allocator<T>>
+class mpmc_queue {
+  static_assert(std::is_nothrow_move_constructible<T>::value &&
+                    std::is_nothrow_move_assignable<T>::value,
+                "Moves of mpmc_queue elements must not throw");
+
+  using al_traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = int64_t;
+  using allocator_type = Allocator;
+
+  // Capacity is rounded up to power of two
+  explicit mpmc_queue(size_type capacity, const Allocator& al = Allocator())
+      : al_(al) {
+    if (capacity <= 0 ||
+        static_cast<uint64_t>(capacity) > al_traits::max_size(al_)) {
+      throw std::length_error("Invalid mpmc_queue capacity");
+    }
+    cap_ = std::bit_ceil(static_cast<uint64_t>(capacity));
+    slot_allocator slot_al(al_);
+    slots_ = slot_traits::allocate(slot_al, cap_);
+    for (size_type pos = 0; pos < cap_; ++pos) {
+      slot_traits::construct(slot_al, slots_ + pos, pos);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  ~mpmc_queue() {
+    size_type head = dequeue_.load(std::memory_order_relaxed);
+    size_type tail = enqueue_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      al_traits::destroy(al_, std::launder(slot_at(head).value()));
+    }
+    slot_allocator slot_al(al_);
+    for (size_type pos = 0; pos < cap_; ++pos) {
+      slot_traits::destroy(slot_al, slots_ + pos);
+    }
+    slot_traits::deallocate(slot_al, slots_, cap_);
+  }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept { return al_; }
+
+  size_type capacity() const noexcept { return cap_; }
+
+  // Exact only when no thread is running, counts claimed slots
+  size_type size() const noexcept {
+    size_type size = enqueue_.load(std::memory_order_acquire) -
+                     dequeue_.load(std::memory_order_acquire);
+    return size < 0 ? 0 : size;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+  //============================================================================
+
+  // False if queue is full
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 &&
+                  (std::is_same<Args, T>::value && ...)) {
+      return try_emplace_nothrow(std::forward<Args>(args)...);
+    } else {
+      return try_emplace_nothrow(T(std::forward<Args>(args)...));
+    }
+  }
+
+  // T must meet additional requirements of CopyInsertable
+  bool try_push(const_reference value) { return try_emplace(value); }
+
+  // T must meet additional requirements of MoveInsertable
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  // Pushes as many elements as there are free slots, returns iterator past
+  //  the last pushed one. Elements are copied or converted up front when
+  //  that may throw
+  // T must meet additional requirements of EmplaceConstructible from
+  //  *first
+  template <typename ForwardIterator>
+  ForwardIterator try_push(ForwardIterator first, ForwardIterator last) {
+    if constexpr (std::is_nothrow_constructible<T, decltype(*first)>::value) {
+      size_type count = std::distance(first, last);
+      size_type pos = claim_run(enqueue_, count, 0);
+      for (size_type i = 0; i < count; ++i, ++first) {
+        slot& target = slot_at(pos + i);
+        al_traits::construct(al_, target.value(), *first);
+        target.seq.store(pos + i + 1, std::memory_order_release);
+      }
+      return first;
+    } else {
+      for (; first != last && try_emplace(*first); ++first) {
+      }
+      return first;
+    }
+  }
+
+  // Waits while queue is full
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    sp::spin_wait waiter;
+    while (!try_emplace_nothrow(std::move(value))) {
+      waiter.wait();
+    }
+  }
+
+  void push(const_reference value) { emplace(value); }
+  void push(T&& value) { emplace(std::move(value)); }
+
+  // Moves front element to out, false if queue is empty
+  bool try_pop(T& out) noexcept {
+    size_type count = 1;
+    size_type pos = claim_run(dequeue_, count, 1);
+    if (pos < 0) {
+      return false;
+    }
+    take(pos, out);
+    return true;
+  }
+
+  // Moves up to count elements to out, returns number of moved elements
+  // T must meet additional requirements of MoveInsertable into container
+  //  behind out, moves through it must not throw
+  template <typename OutputIterator>
+  size_type try_pop(OutputIterator out, size_type count) noexcept {
+    size_type pos = claim_run(dequeue_, count, 1);
+    for (size_type i = 0; i < count; ++i, ++out) {
+      take(pos + i, *out);
+    }
+    return count;
+  }
+
+  // Waits while queue is empty
+  void pop(T& out) noexcept {
+    sp::spin_wait waiter;
+    while (!try_pop(out)) {
+      waiter.wait();
+    }
+  }
+
+ private:
+  // Sequence equals position which may take slot next: pos for pushing to
+  // empty slot, pos + 1 for popping what was pushed at pos
+  struct slot {
+    explicit slot(size_type pos) noexcept : seq(pos) {}
+
+    T* value() noexcept { return reinterpret_cast<T*>(storage); }
+
+    std::atomic<size_type> seq;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  using slot_allocator = typename al_traits::template rebind_alloc<slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  slot& slot_at(size_type pos) const noexcept {
+    return slots_[pos & (cap_ - 1)];
+  }
+
+  template <typename U>
+  bool try_emplace_nothrow(U&& value) noexcept {
+    size_type count = 1;
+    size_type pos = claim_run(enqueue_, count, 0);
+    if (pos < 0) {
+      return false;
+    }
+    slot& target = slot_at(pos);
+    al_traits::construct(al_, target.value(), std::forward<U>(value));
+    target.seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Claims up to count consecutive slots whose sequence is position plus
+  //  lag, lowering count to the ready ones. Returns first claimed position,
+  //  -1 if none is ready
+  size_type claim_run(std::atomic<size_type>& position, size_type& count,
+                      size_type lag) noexcept {
+    size_type pos = position.load(std::memory_order_relaxed);
+    while (count > 0) {
+      size_type ready = 0;
+      for (; ready < count && ready < cap_; ++ready) {
+        size_type seq =
+            slot_at(pos + ready).seq.load(std::memory_order_acquire);
+        if (seq != pos + ready + lag) {
+          break;
+        }
+      }
+      if (ready == 0) {
+        size_type seq = slot_at(pos).seq.load(std::memory_order_acquire);
+        if (seq < pos + lag) {
+          break;  // slot is still taken by the other side, full or empty
+        }
+        pos = position.load(std::memory_order_relaxed);  // lost the race
+      } else if (position.compare_exchange_weak(pos, pos + ready,
+                                                std::memory_order_relaxed)) {
+        count = ready;
+        return pos;
+      }
+    }
+    count = 0;
+    return -1;
+  }
+
+  template <typename U>
+  void take(size_type pos, U& out) noexcept {
+    slot& source = slot_at(pos);
+    out = std::move(*std::launder(source.value()));
+    al_traits::destroy(al_, source.value());
+    source.seq.store(pos + cap_, std::memory_order_release);
+  }
+
+  slot* slots_ = nullptr;
+  size_type cap_ = 0;
+  [[no_unique_address]] Allocator al_;
+
+  alignas(sp::kCacheLineSize) std::atomic<size_type> enqueue_ = 0;
+  alignas(sp::kCacheLineSize) std::atomic<size_type> dequeue_ = 0;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_MPMC_QUEUE_H_
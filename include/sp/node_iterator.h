@@ -0,0 +1,83 @@
+#ifndef SP_CONTAINERS_NODE_ITERATOR_H_
+#define SP_CONTAINERS_NODE_ITERATOR_H_
+
+#include <cstdint>      // int64_t
+#include <iterator>     // std::bidirectional_iterator_tag
+#include <type_traits>  // as name suggests
+
+namespace sp {
+// Bidirectional iterator over linked nodes, models
+//  std::bidirectional_iterator. Container only tells iterators of
+//  different containers apart
+// Node must derive from Node::base_type, link providing next() and prev()
+//  that return neighbour links, and provide value() returning T&. End of
+//  a container is a link which is not a Node and is never dereferenced
+// Iterator converts to const one
+template <typename T, typename Node, typename Container>
+class node_iterator {
+  using link = std::conditional_t<std::is_const<T>::value,
+                                  const typename Node::base_type,
+                                  typename Node::base_type>;
+  using value_node =
+      std::conditional_t<std::is_const<T>::value, const Node, Node>;
+
+ public:
+  using iterator_concept = std::bidirectional_iterator_tag;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using difference_type = int64_t;
+  using pointer = T*;
+  using reference = T&;
+
+  node_iterator() noexcept = default;
+
+  explicit node_iterator(link* node) noexcept : node_(node) {}
+
+  operator node_iterator<const T, Node, Container>() const noexcept
+    requires(!std::is_const<T>::value)
+  {
+    return node_iterator<const T, Node, Container>(node_);
+  }
+
+  // Link the iterator points to, pointer to const for const iterators
+  link* base() const noexcept { return node_; }
+
+  reference operator*() const noexcept {
+    return static_cast<value_node*>(node_)->value();
+  }
+  pointer operator->() const noexcept { return &**this; }
+
+  node_iterator& operator++() noexcept {
+    node_ = node_->next();
+    return *this;
+  }
+
+  node_iterator operator++(int) noexcept {
+    node_iterator temp(*this);
+    node_ = node_->next();
+    return temp;
+  }
+
+  node_iterator& operator--() noexcept {
+    node_ = node_->prev();
+    return *this;
+  }
+
+  node_iterator operator--(int) noexcept {
+    node_iterator temp(*this);
+    node_ = node_->prev();
+    return temp;
+  }
+
+  // Friend, so that iterators compare with const ones through conversion
+  friend bool operator==(const node_iterator& lhs,
+                         const node_iterator& rhs) noexcept {
+    return lhs.node_ == rhs.node_;
+  }
+
+ private:
+  link* node_ = nullptr;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_NODE_ITERATOR_H_
@@ -0,0 +1,133 @@
+#ifndef SP_CONTAINERS_NODE_SLAB_H_
+#define SP_CONTAINERS_NODE_SLAB_H_
+
+#include <cstdint>  // int64_t
+#include <memory>   // std::allocator_traits
+#include <new>      // placement new
+#include <utility>  // std::swap
+
+namespace sp {
+// Arena of node based containers. Carves nodes out of chunks of SlabSize
+// nodes allocated at once, keeps deallocated nodes for reuse and returns
+// memory to allocator only in release(). Nodes are handed out raw, owner
+// constructs and destroys them
+// Allocator passed to methods must be the same or compare equal every time
+template <typename NodeType, int64_t SlabSize>
+class node_slab {
+  static_assert(SlabSize > 0, "Slab must hold at least one node");
+
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  struct Chunk {
+    NodeType* node(int64_t index) noexcept {
+      return reinterpret_cast<NodeType*>(storage) + index;
+    }
+
+    Chunk* next;
+    alignas(NodeType) unsigned char storage[SlabSize * sizeof(NodeType)];
+  };
+
+  template <typename Allocator>
+  using chunk_alloc = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Chunk>;
+
+ public:
+  node_slab() noexcept : chunks_(nullptr), free_(nullptr), used_(SlabSize) {}
+
+  node_slab(const node_slab&) = delete;
+  node_slab& operator=(const node_slab&) = delete;
+
+  // Memory must be released beforehand
+  ~node_slab() = default;
+
+  template <typename Allocator>
+  NodeType* allocate(Allocator& al) {
+    if (free_) {
+      FreeNode* node = free_;
+      free_ = node->next;
+      return reinterpret_cast<NodeType*>(node);
+    }
+    if (used_ == SlabSize) {
+      chunk_alloc<Allocator> chunk_al(al);
+      Chunk* chunk =
+          std::allocator_traits<chunk_alloc<Allocator>>::allocate(chunk_al, 1);
+      chunk->next = chunks_;
+      chunks_ = chunk;
+      used_ = 0;
+    }
+    return chunks_->node(used_++);
+  }
+
+  void deallocate(NodeType* node) noexcept {
+    free_ = ::new (static_cast<void*>(node)) FreeNode{free_};
+  }
+
+  // Frees all chunks at once, nodes in them must be already destroyed or
+  //  be trivially destructible
+  template <typename Allocator>
+  void release(Allocator& al) noexcept {
+    chunk_alloc<Allocator> chunk_al(al);
+    while (chunks_) {
+      Chunk* next = chunks_->next;
+      std::allocator_traits<chunk_alloc<Allocator>>::deallocate(chunk_al,
+                                                                chunks_, 1);
+      chunks_ = next;
+    }
+    free_ = nullptr;
+    used_ = SlabSize;
+  }
+
+  // Takes chunks of other along with its spare nodes, so that nodes moved
+  //  from container of other outlive it
+  void adopt(node_slab& other) noexcept {
+    Chunk* chunks = other.chunks_;
+    if (!chunks) {
+      return;
+    }
+    for (int64_t i = other.used_; i < SlabSize; ++i) {
+      deallocate(chunks->node(i));
+    }
+    for (FreeNode* node = other.free_; node;) {
+      FreeNode* next = node->next;
+      deallocate(reinterpret_cast<NodeType*>(node));
+      node = next;
+    }
+    Chunk* tail = chunks;
+    while (tail->next) {
+      tail = tail->next;
+    }
+    if (chunks_) {
+      tail->next = chunks_->next;
+      chunks_->next = chunks;
+    } else {
+      chunks_ = chunks;
+    }
+    other.chunks_ = nullptr;
+    other.free_ = nullptr;
+    other.used_ = SlabSize;
+  }
+
+  void swap(node_slab& other) noexcept {
+    std::swap(chunks_, other.chunks_);
+    std::swap(free_, other.free_);
+    std::swap(used_, other.used_);
+  }
+
+ private:
+  Chunk* chunks_;
+  FreeNode* free_;
+  int64_t used_;  // nodes taken from head chunk
+};
+
+// Containers without slab allocate every node separately
+template <typename NodeType>
+class node_slab<NodeType, 0> {
+ public:
+  void swap(node_slab&) noexcept {}
+  void adopt(node_slab&) noexcept {}
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_NODE_SLAB_H_
@@ -0,0 +1,109 @@
+#ifndef SP_CONTAINERS_POINTER_ITERATOR_H_
+#define SP_CONTAINERS_POINTER_ITERATOR_H_
+
+#include <compare>      // operator<=>
+#include <cstdint>      // int64_t
+#include <iterator>     // std::contiguous_iterator_tag, std::distance
+#include <type_traits>  // as name suggests
+
+namespace sp {
+// Iterator over contiguous storage, thin wrapper of T*. Container only
+//  tells iterators of different containers apart. Models
+//  std::contiguous_iterator, so std::to_address unwraps it and standard
+//  algorithms and ranges treat it as raw pointer, e.g. std::copy of
+//  trivially copyable elements lowers to memmove
+// Iterator converts to const one, both compare and subtract with each other
+template <typename T, typename Container>
+class pointer_iterator {
+ public:
+  using iterator_concept = std::contiguous_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using element_type = T;
+  using difference_type = int64_t;
+  using pointer = T*;
+  using reference = T&;
+
+  constexpr pointer_iterator() noexcept : ptr_(nullptr) {}
+
+  constexpr explicit pointer_iterator(T* ptr) noexcept : ptr_(ptr) {}
+
+  template <typename U>
+    requires(std::is_same<const U, T>::value && !std::is_same<U, T>::value)
+  constexpr pointer_iterator(const pointer_iterator<U, Container>& other)
+      noexcept
+      : ptr_(other.base()) {}
+
+  constexpr T* base() const noexcept { return ptr_; }
+
+  constexpr reference operator*() const noexcept { return *ptr_; }
+  constexpr pointer operator->() const noexcept { return ptr_; }
+  constexpr reference operator[](difference_type n) const noexcept {
+    return ptr_[n];
+  }
+
+  constexpr pointer_iterator& operator++() noexcept {
+    ++ptr_;
+    return *this;
+  }
+
+  constexpr pointer_iterator operator++(int) noexcept {
+    return pointer_iterator(ptr_++);
+  }
+
+  constexpr pointer_iterator& operator--() noexcept {
+    --ptr_;
+    return *this;
+  }
+
+  constexpr pointer_iterator operator--(int) noexcept {
+    return pointer_iterator(ptr_--);
+  }
+
+  constexpr pointer_iterator& operator+=(difference_type n) noexcept {
+    ptr_ += n;
+    return *this;
+  }
+
+  constexpr pointer_iterator& operator-=(difference_type n) noexcept {
+    ptr_ -= n;
+    return *this;
+  }
+
+  constexpr pointer_iterator operator+(difference_type n) const noexcept {
+    return pointer_iterator(ptr_ + n);
+  }
+
+  friend constexpr pointer_iterator operator+(
+      difference_type n, const pointer_iterator& pos) noexcept {
+    return pos + n;
+  }
+
+  constexpr pointer_iterator operator-(difference_type n) const noexcept {
+    return pointer_iterator(ptr_ - n);
+  }
+
+  template <typename U>
+  constexpr difference_type operator-(
+      const pointer_iterator<U, Container>& other) const noexcept {
+    return ptr_ - other.base();
+  }
+
+  template <typename U>
+  constexpr bool operator==(
+      const pointer_iterator<U, Container>& other) const noexcept {
+    return ptr_ == other.base();
+  }
+
+  template <typename U>
+  constexpr std::strong_ordering operator<=>(
+      const pointer_iterator<U, Container>& other) const noexcept {
+    return ptr_ <=> other.base();
+  }
+
+ private:
+  T* ptr_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_POINTER_ITERATOR_H_
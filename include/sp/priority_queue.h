@@ -0,0 +1,228 @@
+#ifndef SP_CONTAINERS_PRIORITY_QUEUE_H_
+#define SP_CONTAINERS_PRIORITY_QUEUE_H_
+
+#include <functional>        // std::less
+#include <initializer_list>  // std::initializer_list
+#include <ranges>            // std::ranges::input_range
+#include <utility>           // std::forward, std::move
+
+#include <sp/vector.h>
+
+namespace sp {
+// Max-heap adaptor like std::priority_queue, laid out as d-ary heap. With
+//  four children per node the heap is half as deep as a binary one and
+//  the children compared on the way down share a cache line, while the
+//  extra comparisons are cheap. top is the greatest element per Compare
+// Beside push and pop it offers replace_top and pop_push, which sift once
+//  where pop followed by push sifts twice, and push_range, which rebuilds
+//  the heap in O(n) when many elements arrive at once
+// Container must be random access sequence container providing front,
+//  push_back, emplace_back, pop_back, size and swap
+// Compare must induce strict weak ordering on elements
+template <typename T, typename Container = sp::vector<T>,
+          typename Compare = std::less<typename Container::value_type>,
+          int Arity = 4>
+class priority_queue {
+  static_assert(Arity >= 2, "Heap nodes must have at least two children");
+
+ public:
+  using container_type = Container;
+  using value_compare = Compare;
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+  using reference = typename Container::reference;
+  using const_reference = typename Container::const_reference;
+
+  static constexpr int kArity = Arity;
+
+  priority_queue() = default;
+
+  explicit priority_queue(const Compare& comp) : comp_(comp) {}
+
+  // Elements of cont are arranged into heap in O(n)
+  priority_queue(const Compare& comp, const Container& cont)
+      : comp_(comp), c_(cont) {
+    make_heap();
+  }
+
+  priority_queue(const Compare& comp, Container&& cont)
+      : comp_(comp), c_(std::move(cont)) {
+    make_heap();
+  }
+
+  template <typename InputIterator>
+  priority_queue(InputIterator first, InputIterator last,
+                 const Compare& comp = Compare())
+      : comp_(comp), c_(first, last) {
+    make_heap();
+  }
+
+  priority_queue(std::initializer_list<value_type> vals,
+                 const Compare& comp = Compare())
+      : priority_queue(vals.begin(), vals.end(), comp) {}
+
+  //============================================================================
+  const_reference top() const { return c_.front(); }
+
+  bool empty() const { return c_.empty(); }
+  size_type size() const { return c_.size(); }
+
+  // Checks heap property of the underlying container
+  bool integrity() const {
+    for (size_type child = 1; child < size(); ++child) {
+      if (comp_(c_[parent(child)], c_[child])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  //============================================================================
+
+  void push(const value_type& value) { emplace(value); }
+  void push(value_type&& value) { emplace(std::move(value)); }
+
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    c_.emplace_back(std::forward<Args>(args)...);
+    sift_up(size() - 1);
+  }
+
+  // Appends elements and restores heap by sifting each of them up, or by
+  //  rebuilding the whole heap when that takes fewer comparisons. If
+  //  appending throws, elements appended so far are removed again
+  template <std::ranges::input_range R>
+  void push_range(R&& range) {
+    size_type old_size = size();
+    try {
+      for (auto&& value : range) {
+        c_.emplace_back(std::forward<decltype(value)>(value));
+      }
+    } catch (...) {
+      while (size() > old_size) {
+        c_.pop_back();
+      }
+      throw;
+    }
+    size_type added = size() - old_size;
+    if (added * depth(size()) > size()) {
+      make_heap();
+    } else {
+      for (size_type pos = old_size; pos < size(); ++pos) {
+        sift_up(pos);
+      }
+    }
+  }
+
+  void pop() {
+    if (size() > 1) {
+      value_type last(std::move(c_[size() - 1]));
+      c_.pop_back();
+      sift_down(0, std::move(last));
+    } else {
+      c_.pop_back();
+    }
+  }
+
+  // Same as pop followed by emplace, sifting only once. Heap must not be
+  //  empty
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  void replace_top(Args&&... args) {
+    sift_down(0, value_type(std::forward<Args>(args)...));
+  }
+
+  // Same as push followed by pop returning the popped element. Value is
+  //  returned right away if it would be the new top, otherwise it takes
+  //  place of the top with one sift
+  value_type pop_push(value_type value) {
+    if (empty() || !comp_(value, top())) {
+      return value;
+    }
+    value_type result(std::move(c_.front()));
+    sift_down(0, std::move(value));
+    return result;
+  }
+
+  void swap(priority_queue& other) noexcept {
+    using std::swap;
+    swap(comp_, other.comp_);
+    c_.swap(other.c_);
+  }
+
+ private:
+  static size_type parent(size_type child) noexcept {
+    return (child - 1) / Arity;
+  }
+
+  // Number of heap levels below root of heap of count elements
+  static size_type depth(size_type count) noexcept {
+    size_type levels = 0;
+    for (size_type width = 1; width < count; width = width * Arity + 1) {
+      ++levels;
+    }
+    return levels;
+  }
+
+  // Moves parents down into the hole until value fits
+  void sift_up(size_type hole) {
+    if (hole == 0 || !comp_(c_[parent(hole)], c_[hole])) {
+      return;
+    }
+    value_type value(std::move(c_[hole]));
+    do {
+      c_[hole] = std::move(c_[parent(hole)]);
+      hole = parent(hole);
+    } while (hole > 0 && comp_(c_[parent(hole)], value));
+    c_[hole] = std::move(value);
+  }
+
+  // Moves greatest children up into the hole until value fits
+  void sift_down(size_type hole, value_type&& value) {
+    size_type count = size();
+    while (true) {
+      size_type first = hole * Arity + 1;
+      if (first >= count) {
+        break;
+      }
+      size_type last = first + Arity < count ? first + Arity : count;
+      size_type best = first;
+      for (size_type child = first + 1; child < last; ++child) {
+        if (comp_(c_[best], c_[child])) {
+          best = child;
+        }
+      }
+      if (!comp_(value, c_[best])) {
+        break;
+      }
+      c_[hole] = std::move(c_[best]);
+      hole = best;
+    }
+    c_[hole] = std::move(value);
+  }
+
+  // Floyd's bottom-up construction, O(n)
+  void make_heap() {
+    if (size() < 2) {
+      return;
+    }
+    for (size_type pos = parent(size() - 1); pos >= 0; --pos) {
+      size_type first = pos * Arity + 1;
+      size_type last = first + Arity < size() ? first + Arity : size();
+      bool fits = true;
+      for (size_type child = first; child < last && fits; ++child) {
+        fits = !comp_(c_[pos], c_[child]);
+      }
+      if (!fits) {
+        sift_down(pos, value_type(std::move(c_[pos])));
+      }
+    }
+  }
+
+ protected:
+  [[no_unique_address]] Compare comp_;
+  Container c_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_PRIORITY_QUEUE_H_
@@ -1,66 +1,65 @@
-#ifndef SRC_CONTAINERS_S21_QUEUE_H_
-#define SRC_CONTAINERS_S21_QUEUE_H_
-#include "s21_list.h"
+#ifndef SP_CONTAINERS_QUEUE_H_
+#define SP_CONTAINERS_QUEUE_H_
 
-namespace s21 {
-template <typename T, typename containers = s21::list<T>>
+#include <initializer_list>  // std::initializer_list
+#include <utility>           // std::forward, std::move
 
+#include <sp/deque.h>
+
+namespace sp {
+// FIFO adaptor, elements are pushed to the back and popped from the front
+// Container must provide front, back, push_back, emplace_back, pop_front,
+//  empty, size and swap, sp::deque and sp::list do
+template <typename T, typename Container = sp::deque<T>>
 class queue {
-    public:
-        typedef T value_type;
-        typedef T& reference;
-        typedef const T& const_reference;
-        typedef typename containers::iterator iterator;
-        typedef typename containers::const_iterator const_iterator;
-        typedef size_t size_type;
-
-        //  Default constructor
-        queue() : base() {}
-
-        //  Initializer list constructor
-        queue(std::initializer_list<value_type> const& items) : base(items) {}
-
-        //  Copy 
-        queue(const queue& other) : base(other.base) {}
-
-        //  Move constructor (use move to make shure the argument is rvalue)
-        queue(queue&& other) : base(std::move(other.base)) {}
-
-        //  Assignment operator overload for moving an object
-        queue& operator=(queue&& s) {
-        base = std::move(s.base);
-        return *this;
-        }
-
-        //  Destructor:  
-        ~queue() = default;
-
-        //  Queue Element access:
-
-        const_reference front() {
-            return base.front();
-        }
-        const_reference back() {
-            return base.back();
-        }
-
-        //  Queue Capacity:
-
-        bool empty() {
-            return base.empty();
-        }
-        size_type size() {
-            return base.size();
-        }
-
-        void pop() { base.pop_front(); }
-        void push(const_reference value) { base.push_back(value); }
-        void swap(queue& other) { base.swap(other.base); }
-
-  
-    private:
-    containers base;
-    };
-} // namespace s21
-
-#endif  // SRC_CONTAINERS_S21_QUEUE_H_
\ No newline at end of file
+ public:
+  using container_type = Container;
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+  using reference = typename Container::reference;
+  using const_reference = typename Container::const_reference;
+
+  queue() = default;
+
+  explicit queue(const Container& cont) : c_(cont) {}
+  explicit queue(Container&& cont) : c_(std::move(cont)) {}
+
+  template <typename InputIterator>
+  queue(InputIterator first, InputIterator last) : c_(first, last) {}
+
+  queue(std::initializer_list<value_type> vals) : c_(vals) {}
+
+  //============================================================================
+  reference front() { return c_.front(); }
+  const_reference front() const { return c_.front(); }
+
+  reference back() { return c_.back(); }
+  const_reference back() const { return c_.back(); }
+
+  bool empty() const { return c_.empty(); }
+  size_type size() const { return c_.size(); }
+  //============================================================================
+
+  void push(const value_type& value) { c_.push_back(value); }
+  void push(value_type&& value) { c_.push_back(std::move(value)); }
+
+  template <typename... Args>
+  decltype(auto) emplace(Args&&... args) {
+    return c_.emplace_back(std::forward<Args>(args)...);
+  }
+
+  void pop() { c_.pop_front(); }
+
+  void swap(queue& other) noexcept(noexcept(c_.swap(other.c_))) {
+    c_.swap(other.c_);
+  }
+
+  bool operator==(const queue& other) const { return c_ == other.c_; }
+  bool operator!=(const queue& other) const { return !(*this == other); }
+
+ protected:
+  Container c_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_QUEUE_H_
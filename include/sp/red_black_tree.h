@@ -1,276 +1,872 @@
-#ifndef SRC_CONTAINERS_S21_RED_BLACK_TREE_H_
-#define SRC_CONTAINERS_S21_RED_BLACK_TREE_H_
+#ifndef SP_CONTAINERS_RED_BLACK_TREE_H_
+#define SP_CONTAINERS_RED_BLACK_TREE_H_
 
-#include <iostream>
+#include <cstdint>      // int64_t
+#include <memory>       // std::allocator_traits
+#include <type_traits>  // as name suggests
+#include <utility>      // std::forward, std::move, std::pair, std::swap
 
-namespace s21 {
+#include <sp/key_of_value.h>
+#include <sp/node_iterator.h>
+#include <sp/node_slab.h>
 
-enum class Color {
-  kRed,
-  kBlack,
-};
+namespace sp {
+// Red-black tree of values with unique keys, engine of sp::map and sp::set
+// Value type must meet requirements of Erasable
+// KeyOfValue must return reference to key of given value
+// Compare must induce strict weak ordering on keys, lookup methods accept
+//  any type Compare can compare with keys
+// Allocator type must meet requirements of Allocator
+// SlabSize is number of nodes allocated at once, as in sp::list. With
+//  slabs clear() and destructor free whole chunks, skipping nodes entirely
+//  when values are trivially destructible
+// Methods may have additional requirements on types
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Compare, typename Allocator, int64_t SlabSize = 0>
+class red_black_tree {
+  static_assert(SlabSize >= 0, "Slab size must not be negative");
+
+  struct Node;
+  struct ValueNode;
+
+  using rebind_alloc = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<ValueNode>;
+  using rebind_traits = std::allocator_traits<rebind_alloc>;
 
-template <typename K, typename V>
-class RedBlackTree {
  public:
-  RedBlackTree() { root_ = nullptr; };
-  RedBlackTree(K key, V value) { root_ = new Node(key, value); };
-  ~RedBlackTree() { delete root_; };
-
-  void insert(K key, V value) {
-    Node *n_node = new Node(key, value);
-    if (!root_) {
-      root_ = n_node;
-      root_->color_ = Color::kBlack;
-      return;
+  using key_type = Key;
+  using value_type = Value;
+  using reference = Value&;
+  using const_reference = const Value&;
+  using size_type = int64_t;
+  using key_compare = Compare;
+
+  using allocator_type = Allocator;
+  using al_traits = std::allocator_traits<allocator_type>;
+
+  using iterator = sp::node_iterator<Value, ValueNode, red_black_tree>;
+  using const_iterator =
+      sp::node_iterator<const Value, ValueNode, red_black_tree>;
+
+  // Position where value with given key is or should be linked
+  struct position {
+    Node* found;   // node with equivalent key, if any
+    Node* parent;  // parent of new node otherwise
+    bool left;     // side of parent new node goes to
+  };
+
+  red_black_tree() = default;
+
+  explicit red_black_tree(const Compare& comp,
+                          const Allocator& al = Allocator())
+      : al_(static_cast<rebind_alloc>(al)), comp_(comp), size_(0) {}
+
+  red_black_tree(const red_black_tree& other, const Allocator& al)
+      : al_(static_cast<rebind_alloc>(al)), comp_(other.comp_), size_(0) {
+    copy_from(other);
+  }
+
+  red_black_tree(const red_black_tree& other)
+      : red_black_tree(other,
+                       al_traits::select_on_container_copy_construction(
+                           other.get_allocator())) {}
+
+  red_black_tree(red_black_tree&& other) noexcept
+      : al_(std::move(other.al_)), comp_(other.comp_), size_(0) {
+    swap_content(other);
+  }
+
+  red_black_tree(red_black_tree&& other, const Allocator& al)
+      : al_(static_cast<rebind_alloc>(al)), comp_(other.comp_), size_(0) {
+    if (al_ == other.al_) {
+      swap_content(other);
+    } else {
+      move_from(other);
     }
-    Node *deep = root_;
-    while (deep != nullptr) {
-      if (deep->key_ <= key) {
-        if (deep->right_ == nullptr) {
-          n_node->parent_ = deep;
-          deep->right_ = n_node;
-          break;
-        }
-        deep = deep->right_;
-      } else {
-        if (deep->left_ == nullptr) {
-          n_node->parent_ = deep;
-          deep->left_ = n_node;
-          break;
-        }
-        deep = deep->left_;
+  }
+
+  red_black_tree& operator=(const red_black_tree& other) {
+    if (this != &other) {
+      clear();
+      if constexpr (al_traits::propagate_on_container_copy_assignment::value) {
+        al_ = other.al_;
       }
+      comp_ = other.comp_;
+      copy_from(other);
     }
-    if (!n_node->Granny()) return;
-    n_node->AfterInsertFix(this);
-    root_->color_ = Color::kBlack;
-  };
-  void remove(K key) {
-    Node *deep = root_;
-    while (deep != nullptr && deep->key_ != key) {
-      if (deep->key_ <= key) {
-        deep = deep->right_;
+    return *this;
+  }
+
+  red_black_tree& operator=(red_black_tree&& other) noexcept(
+      al_traits::propagate_on_container_move_assignment::value ||
+      al_traits::is_always_equal::value) {
+    if (this != &other) {
+      clear();
+      comp_ = other.comp_;
+      if constexpr (al_traits::propagate_on_container_move_assignment::value) {
+        al_ = std::move(other.al_);
+        swap_content(other);
+      } else if (al_ == other.al_) {
+        swap_content(other);
       } else {
-        deep = deep->left_;
+        move_from(other);
       }
     }
-    if (!deep) {
-      // НЕТ НИКАКОГО EXCEPTION НА СЛУЧАЙ НЕСУЩЕСТВУЮЩЕГО КЛЮЧА
-      // а надо ли...
-      return;
+    return *this;
+  }
+
+  ~red_black_tree() { clear(); }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept {
+    return static_cast<Allocator>(al_);
+  }
+
+  key_compare key_comp() const { return comp_; }
+
+  iterator begin() noexcept { return iterator(header_.left_node); }
+  const_iterator begin() const noexcept {
+    return const_iterator(header_.left_node);
+  }
+
+  iterator end() noexcept { return iterator(&header_); }
+  const_iterator end() const noexcept { return const_iterator(&header_); }
+
+  bool empty() const noexcept { return !size_; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return rebind_traits::max_size(al_);
+  }
+  //============================================================================
+
+  // Checks links, order, sizes and red-black properties
+  bool integrity() const {
+    const Node* root = header_.parent_node;
+    if (!root) {
+      return !size_ && header_.left_node == &header_ &&
+             header_.right_node == &header_;
+    }
+    if (root->parent_node != &header_ || root->node_color != color::kBlack ||
+        header_.left_node != root->minimum() ||
+        header_.right_node != root->maximum()) {
+      return false;
     }
-    if (!deep->right_) {
-      deep->SwapAndDelete(deep->left_, this);
-    } else if (!deep->left_) {
-      deep->SwapAndDelete(deep->right_, this);
+    size_type count = 0;
+    return black_height(root, count) >= 0 && count == size_;
+  }
+
+  // Releases all memory held by tree, including spare nodes of slabs
+  void clear() noexcept {
+    if constexpr (kSlab) {
+      if constexpr (!kTrivialDrop) {
+        destroy_subtree<false>(header_.parent_node);
+      }
+      slabs_.release(al_);
     } else {
-      // заменить удаляемое на число, которое max из чисел меньше удаляемого
-      // или min из чисел больше удаляемого
-      Node *max = deep->left_->Max();
-      // max->parent_->GetNodeInfo();
-      if (max->parent_->left_ == max) {
-        max->parent_->left_ = nullptr;
-      } else {
-        max->parent_->right_ = nullptr;
+      destroy_subtree(header_.parent_node);
+    }
+    header_.parent_node = nullptr;
+    header_.left_node = &header_;
+    header_.right_node = &header_;
+    size_ = 0;
+  }
+
+  // Finds where value with key equivalent to key is or should be linked
+  template <typename K>
+  position find_position(const K& key) const {
+    Node* parent = end_node();
+    Node* node = header_.parent_node;
+    bool less = true;
+    while (node) {
+      parent = node;
+      less = comp_(key, key_of(node));
+      node = less ? node->left_node : node->right_node;
+    }
+    Node* prev = parent;
+    if (less) {
+      if (prev == header_.left_node) {
+        return {nullptr, parent, true};
       }
-      // max->parent_->GetNodeInfo();
-      deep->SwapAndDelete(max, this);
+      prev = prev->prev();
     }
-    // AfterDeleteFix();
-  };
+    if (comp_(key_of(prev), key)) {
+      return {nullptr, parent, less};
+    }
+    return {prev, nullptr, false};
+  }
 
-  void print() {
-    if (root_) {
-      root_->PrintHelper("", true, 0);
+  // Links node constructed from args at pos, which must be obtained by
+  //  find_position with key of the new value and have no node found
+  // Value must meet additional requirements of EmplaceConstructible from
+  //  args
+  template <typename... Args>
+  iterator emplace_at(position pos, Args&&... args) {
+    ValueNode* node = make_node(std::forward<Args>(args)...);
+    link_node(node, pos.parent, pos.left);
+    return iterator(node);
+  }
+
+  // Value must meet additional requirements of EmplaceConstructible from
+  //  args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_unique(Args&&... args) {
+    ValueNode* node = make_node(std::forward<Args>(args)...);
+    position pos;
+    try {
+      pos = find_position(KeyOfValue()(node->value()));
+    } catch (...) {
+      drop_node(node);
+      throw;
     }
-  };
+    if (pos.found) {
+      drop_node(node);
+      return {iterator(pos.found), false};
+    }
+    link_node(node, pos.parent, pos.left);
+    return {iterator(node), true};
+  }
+
+  // Value must meet additional requirements of CopyInsertable into *this
+  std::pair<iterator, bool> insert_unique(const value_type& value) {
+    position pos = find_position(KeyOfValue()(value));
+    if (pos.found) {
+      return {iterator(pos.found), false};
+    }
+    return {emplace_at(pos, value), true};
+  }
 
-  //  private:
-  class Node {
-   public:
-    Node(K key, V value) : key_(key), value_(value){};
-    Node(Node *parent, K key, V value)
-        : parent_(parent), key_(key), value_(value){};
-    ~Node() {
-      delete left_;
-      delete right_;
-    };
-
-    Node *Granny() {
-      if (parent_) {
-        return parent_->parent_;
+  // Value must meet additional requirements of MoveInsertable into *this
+  std::pair<iterator, bool> insert_unique(value_type&& value) {
+    position pos = find_position(KeyOfValue()(value));
+    if (pos.found) {
+      return {iterator(pos.found), false};
+    }
+    return {emplace_at(pos, std::move(value)), true};
+  }
+
+  // No additional requirements on types
+  iterator erase(const_iterator pos) noexcept {
+    Node* node = link(pos);
+    Node* next = node->next();
+    unlink_node(node);
+    drop_node(cast(node));
+    return iterator(next);
+  }
+
+  // No additional requirements on types
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    if (first == begin() && last == end()) {
+      clear();
+      return end();
+    }
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator(link(last));
+  }
+
+  // Erases element with key equivalent to key, returns number of erased
+  template <typename K>
+  size_type erase_key(const K& key) {
+    iterator pos = find(key);
+    if (pos == end()) {
+      return 0;
+    }
+    erase(pos);
+    return 1;
+  }
+
+  void swap(red_black_tree& other) noexcept(
+      al_traits::propagate_on_container_swap::value ||
+      al_traits::is_always_equal::value) {
+    if constexpr (al_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(al_, other.al_);
+    }
+    using std::swap;
+    swap(comp_, other.comp_);
+    swap_content(other);
+  }
+
+  template <typename K>
+  iterator find(const K& key) {
+    return iterator(find_node(key));
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return const_iterator(find_node(key));
+  }
+
+  template <typename K>
+  bool contains(const K& key) const {
+    return find_node(key) != &header_;
+  }
+
+  // First element with key not less than key
+  template <typename K>
+  iterator lower_bound(const K& key) {
+    return iterator(lower_bound_node(key));
+  }
+
+  template <typename K>
+  const_iterator lower_bound(const K& key) const {
+    return const_iterator(lower_bound_node(key));
+  }
+
+  // First element with key greater than key
+  template <typename K>
+  iterator upper_bound(const K& key) {
+    return iterator(upper_bound_node(key));
+  }
+
+  template <typename K>
+  const_iterator upper_bound(const K& key) const {
+    return const_iterator(upper_bound_node(key));
+  }
+
+ private:
+  enum class color : bool { kRed, kBlack };
+
+  // Links of the tree. Header is a bare red Node, its parent is root, left
+  // and right are leftmost and rightmost nodes. Every other node is
+  // a ValueNode
+  struct Node {
+    Node() noexcept
+        : parent_node(nullptr),
+          left_node(this),
+          right_node(this),
+          node_color(color::kRed) {}
+
+    Node* minimum() noexcept {
+      Node* node = this;
+      while (node->left_node) {
+        node = node->left_node;
       }
-      return nullptr;
-    };
-    Node *Uncle() {
-      Node *granny = Granny();
-      if (!granny) {
-        return nullptr;
+      return node;
+    }
+
+    const Node* minimum() const noexcept {
+      return const_cast<Node*>(this)->minimum();
+    }
+
+    Node* maximum() noexcept {
+      Node* node = this;
+      while (node->right_node) {
+        node = node->right_node;
       }
-      if (parent_ == granny->right_) {
-        return granny->left_;
+      return node;
+    }
+
+    const Node* maximum() const noexcept {
+      return const_cast<Node*>(this)->maximum();
+    }
+
+    // In-order successor, successor of rightmost node is header
+    Node* next() const noexcept {
+      if (right_node) {
+        return right_node->minimum();
       }
-      return granny->right_;
-    };
-    Node *Brother() {
-      if (!parent_) {
-        return nullptr;
-      } else if (parent_->right_ = this) {
-        return parent_->left_;
+      const Node* node = this;
+      Node* parent = parent_node;
+      while (node == parent->right_node) {
+        node = parent;
+        parent = parent->parent_node;
       }
-      return parent_->right_;
-    };
-    Node *Max() {
-      Node *maximum = this;
-      while (maximum->right_) {
-        maximum = maximum->right_;
+      // Only happens on rightmost node of tree with root lacking right
+      // child, where header and root are parents of each other
+      if (node->right_node == parent) {
+        return const_cast<Node*>(node);
       }
-      return maximum;
-    };
-
-    void GetNodeInfo() {
-      std::cout << "~~~~~~~~~~~~~~~~~~\n";
-      std::cout << "Key: " << key_ << "; Val: " << value_ << std::endl;
-      std::cout << "P: " << (parent_ ? parent_->key_ : -1)
-                << "; L: " << (left_ ? left_->key_ : -1)
-                << "; R: " << (right_ ? right_->key_ : -1) << std::endl;
-      std::cout << "~~~~~~~~~~~~~~~~~~\n";
-    }
-
-    void RotationLeft(RedBlackTree *tree) {
-      Node *replace = right_;
-      replace->parent_ = parent_;
-      if (!replace->parent_) {
-        tree->root_ = replace;
-      } else if (parent_->left_ == this) {
-        parent_->left_ = replace;
-      } else {
-        parent_->right_ = replace;
+      return parent;
+    }
+
+    // In-order predecessor, predecessor of header is rightmost node
+    Node* prev() const noexcept {
+      if (node_color == color::kRed && parent_node &&
+          parent_node->parent_node == this) {
+        return right_node;
+      }
+      if (left_node) {
+        return left_node->maximum();
       }
-      right_ = replace->left_;
-      if (right_) {
-        right_->parent_ = this;
+      const Node* node = this;
+      Node* parent = parent_node;
+      while (node == parent->left_node) {
+        node = parent;
+        parent = parent->parent_node;
       }
-      parent_ = replace;
-      replace->left_ = this;
-    };
-    void RotationRight(RedBlackTree *tree) {
-      Node *replace = left_;
-      replace->parent_ = parent_;
-      if (!replace->parent_) {
-        tree->root_ = replace;
-      } else if (parent_->left_ == this) {
-        parent_->left_ = replace;
+      return parent;
+    }
+
+    Node* parent_node;
+    Node* left_node;
+    Node* right_node;
+    color node_color;
+  };
+
+  struct ValueNode : public Node {
+    using base_type = Node;
+
+    template <typename... Args>
+    explicit ValueNode(Args&&... args) noexcept(
+        std::is_nothrow_constructible<Value, Args...>::value)
+        : data(std::forward<Args>(args)...) {}
+
+    Value& value() noexcept { return data; }
+    const Value& value() const noexcept { return data; }
+
+    Value data;
+  };
+
+  static_assert(!std::is_polymorphic<ValueNode>::value,
+                "Tree nodes must not carry vtable pointer");
+
+  static constexpr bool kSlab = SlabSize > 0;
+
+  // Nodes may be dropped along with their memory without visiting them
+  static constexpr bool kTrivialDrop =
+      std::is_trivially_destructible<Value>::value &&
+      !requires(rebind_alloc& al, ValueNode* p) { al.destroy(p); };
+
+  static ValueNode* cast(Node* ptr) noexcept {
+    return static_cast<ValueNode*>(ptr);
+  }
+
+  static const ValueNode* cast(const Node* ptr) noexcept {
+    return static_cast<const ValueNode*>(ptr);
+  }
+
+  static Node* link(const_iterator pos) noexcept {
+    return const_cast<Node*>(pos.base());
+  }
+
+  static const Key& key_of(const Node* node) noexcept {
+    return KeyOfValue()(cast(node)->value());
+  }
+
+  Node* end_node() const noexcept { return const_cast<Node*>(&header_); }
+
+  ValueNode* allocate_node() {
+    if constexpr (kSlab) {
+      return slabs_.allocate(al_);
+    } else {
+      return rebind_traits::allocate(al_, 1);
+    }
+  }
+
+  void deallocate_node(ValueNode* node) noexcept {
+    if constexpr (kSlab) {
+      slabs_.deallocate(node);
+    } else {
+      rebind_traits::deallocate(al_, node, 1);
+    }
+  }
+
+  template <typename... Args>
+  ValueNode* make_node(Args&&... args) {
+    ValueNode* node = allocate_node();
+    try {
+      rebind_traits::construct(al_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate_node(node);
+      throw;
+    }
+    return node;
+  }
+
+  void drop_node(ValueNode* node) noexcept {
+    rebind_traits::destroy(al_, node);
+    deallocate_node(node);
+  }
+
+  // Destroys every node of subtree, freeing them unless Free is false.
+  // Rotates left child over its parent until there is none, so nodes are
+  // visited as a list threaded through right links, without any stack
+  template <bool Free = true>
+  void destroy_subtree(Node* node) noexcept {
+    while (node) {
+      if (Node* left = node->left_node) {
+        node->left_node = left->right_node;
+        left->right_node = node;
+        node = left;
       } else {
-        parent_->right_ = replace;
+        Node* right = node->right_node;
+        if constexpr (Free) {
+          drop_node(cast(node));
+        } else {
+          rebind_traits::destroy(al_, cast(node));
+        }
+        node = right;
       }
-      left_ = replace->right_;
-      if (left_) {
-        left_->parent_ = this;
+    }
+  }
+
+  // Copies structure and colors of subtree, recursing only into right
+  // children
+  Node* clone_subtree(const Node* src, Node* parent) {
+    Node* top = clone_node(src, parent);
+    try {
+      if (src->right_node) {
+        top->right_node = clone_subtree(src->right_node, top);
+      }
+      parent = top;
+      for (src = src->left_node; src; src = src->left_node) {
+        Node* node = clone_node(src, parent);
+        parent->left_node = node;
+        if (src->right_node) {
+          node->right_node = clone_subtree(src->right_node, node);
+        }
+        parent = node;
       }
-      parent_ = replace;
-      replace->right_ = this;
-    };
-
-    void SwapAndDelete(Node *child, RedBlackTree *tree) {
-      if (!parent_) {
-        tree->root_ = child;
-      } else if (parent_->left_ == this) {
-        parent_->left_ = child;
+    } catch (...) {
+      destroy_subtree(top);
+      throw;
+    }
+    return top;
+  }
+
+  Node* clone_node(const Node* src, Node* parent) {
+    Node* node = make_node(cast(src)->value());
+    node->parent_node = parent;
+    node->left_node = nullptr;
+    node->right_node = nullptr;
+    node->node_color = src->node_color;
+    return node;
+  }
+
+  // *this must be empty
+  void copy_from(const red_black_tree& other) {
+    if (!other.header_.parent_node) {
+      return;
+    }
+    Node* root = clone_subtree(other.header_.parent_node, &header_);
+    header_.parent_node = root;
+    header_.left_node = root->minimum();
+    header_.right_node = root->maximum();
+    size_ = other.size_;
+  }
+
+  // *this must be empty
+  void move_from(red_black_tree& other) {
+    for (Node* node = other.header_.left_node; node != &other.header_;
+         node = node->next()) {
+      insert_unique(std::move(cast(node)->value()));
+    }
+  }
+
+  // Exchanges nodes and sizes with other
+  void swap_content(red_black_tree& other) noexcept {
+    std::swap(header_.parent_node, other.header_.parent_node);
+    std::swap(header_.left_node, other.header_.left_node);
+    std::swap(header_.right_node, other.header_.right_node);
+    std::swap(size_, other.size_);
+    slabs_.swap(other.slabs_);
+    adopt_header();
+    other.adopt_header();
+  }
+
+  // Repoints root taken from other tree at header_
+  void adopt_header() noexcept {
+    if (header_.parent_node) {
+      header_.parent_node->parent_node = &header_;
+    } else {
+      header_.left_node = &header_;
+      header_.right_node = &header_;
+    }
+  }
+
+  template <typename K>
+  Node* lower_bound_node(const K& key) const {
+    Node* bound = end_node();
+    for (Node* node = header_.parent_node; node;) {
+      if (!comp_(key_of(node), key)) {
+        bound = node;
+        node = node->left_node;
       } else {
-        parent_->right_ = child;
+        node = node->right_node;
       }
-      if (child) {
-        child->parent_ = parent_;
+    }
+    return bound;
+  }
+
+  template <typename K>
+  Node* upper_bound_node(const K& key) const {
+    Node* bound = end_node();
+    for (Node* node = header_.parent_node; node;) {
+      if (comp_(key, key_of(node))) {
+        bound = node;
+        node = node->left_node;
+      } else {
+        node = node->right_node;
       }
-      if (left_ && left_ != child) {
-        child->left_ = left_;
-        left_->parent_ = child;
+    }
+    return bound;
+  }
+
+  template <typename K>
+  Node* find_node(const K& key) const {
+    Node* bound = lower_bound_node(key);
+    if (bound == &header_ || comp_(key, key_of(bound))) {
+      return end_node();
+    }
+    return bound;
+  }
+
+  // Returns black height of subtree or -1 if it is broken, counts its nodes
+  int black_height(const Node* node, size_type& count) const {
+    if (!node) {
+      return 0;
+    }
+    ++count;
+    const Node* left = node->left_node;
+    const Node* right = node->right_node;
+    if ((left && (left->parent_node != node ||
+                  comp_(key_of(node), key_of(left)))) ||
+        (right && (right->parent_node != node ||
+                   comp_(key_of(right), key_of(node))))) {
+      return -1;
+    }
+    if (node->node_color == color::kRed &&
+        ((left && left->node_color == color::kRed) ||
+         (right && right->node_color == color::kRed))) {
+      return -1;
+    }
+    int left_height = black_height(left, count);
+    int right_height = black_height(right, count);
+    if (left_height < 0 || left_height != right_height) {
+      return -1;
+    }
+    return left_height + (node->node_color == color::kBlack);
+  }
+
+  void rotate_left(Node* node) noexcept {
+    Node* child = node->right_node;
+    node->right_node = child->left_node;
+    if (child->left_node) {
+      child->left_node->parent_node = node;
+    }
+    child->parent_node = node->parent_node;
+    if (node == header_.parent_node) {
+      header_.parent_node = child;
+    } else if (node == node->parent_node->left_node) {
+      node->parent_node->left_node = child;
+    } else {
+      node->parent_node->right_node = child;
+    }
+    child->left_node = node;
+    node->parent_node = child;
+  }
+
+  void rotate_right(Node* node) noexcept {
+    Node* child = node->left_node;
+    node->left_node = child->right_node;
+    if (child->right_node) {
+      child->right_node->parent_node = node;
+    }
+    child->parent_node = node->parent_node;
+    if (node == header_.parent_node) {
+      header_.parent_node = child;
+    } else if (node == node->parent_node->right_node) {
+      node->parent_node->right_node = child;
+    } else {
+      node->parent_node->left_node = child;
+    }
+    child->right_node = node;
+    node->parent_node = child;
+  }
+
+  // Links node as left or right child of parent and restores balance
+  void link_node(Node* node, Node* parent, bool left) noexcept {
+    node->parent_node = parent;
+    node->left_node = nullptr;
+    node->right_node = nullptr;
+    node->node_color = color::kRed;
+    if (parent == &header_) {
+      header_.parent_node = node;
+      header_.left_node = node;
+      header_.right_node = node;
+    } else if (left) {
+      parent->left_node = node;
+      if (parent == header_.left_node) {
+        header_.left_node = node;
       }
-      if (right_ && right_ != child) {
-        child->right_ = right_;
-        right_->parent_ = child;
+    } else {
+      parent->right_node = node;
+      if (parent == header_.right_node) {
+        header_.right_node = node;
       }
-      parent_ = left_ = right_ = nullptr;
-      delete this;
-    };
-
-    void PrintHelper(std::string indent, bool last, int depth) {
-      if (depth < 10) {
-        std::cout << indent;
-        if (last) {
-          std::cout << "R----";
-          indent += "     ";
-        } else {
-          std::cout << "L----";
-          indent += "|    ";
+    }
+    ++size_;
+
+    while (node != header_.parent_node &&
+           node->parent_node->node_color == color::kRed) {
+      Node* parent = node->parent_node;
+      Node* grand = parent->parent_node;
+      if (parent == grand->left_node) {
+        Node* uncle = grand->right_node;
+        if (uncle && uncle->node_color == color::kRed) {
+          parent->node_color = color::kBlack;
+          uncle->node_color = color::kBlack;
+          grand->node_color = color::kRed;
+          node = grand;
+          continue;
+        }
+        if (node == parent->right_node) {
+          rotate_left(parent);
+          parent = node;
+        }
+        parent->node_color = color::kBlack;
+        grand->node_color = color::kRed;
+        rotate_right(grand);
+        break;
+      } else {
+        Node* uncle = grand->left_node;
+        if (uncle && uncle->node_color == color::kRed) {
+          parent->node_color = color::kBlack;
+          uncle->node_color = color::kBlack;
+          grand->node_color = color::kRed;
+          node = grand;
+          continue;
         }
-        std::string s_color = color_ == Color::kRed ? "R" : "B";
-        std::cout << "(" << key_ << ")"
-                  << "(" << s_color << ")";
-        // std::cout << "(" << (left_ ? left_->key_ : 0) << ", "
-        //           << (right_ ? right_->key_ : 0) << ", "
-        //           << (parent_ ? parent_->key_ : 0) << ")";
-        std::cout << std::endl;
-        if (left_ != nullptr) left_->PrintHelper(indent, false, depth + 1);
-        if (right_ != nullptr) right_->PrintHelper(indent, true, depth + 1);
+        if (node == parent->left_node) {
+          rotate_right(parent);
+          parent = node;
+        }
+        parent->node_color = color::kBlack;
+        grand->node_color = color::kRed;
+        rotate_left(grand);
+        break;
       }
-    };
-
-    void AfterInsertFix(RedBlackTree *tree) {
-      while (parent_ &&
-             parent_->color_ == Color::kRed) {  // It's wrong to be commy
-        Node *uncle = Uncle();
-        if (uncle && uncle->color_ == Color::kRed) {
-          FixCaseUncleIsCommy(tree);
-        } else {
-          FixCaseUncleIsBlack(tree);
+    }
+    header_.parent_node->node_color = color::kBlack;
+  }
+
+  // Unlinks node from the tree and restores balance
+  void unlink_node(Node* node) noexcept {
+    Node*& root = header_.parent_node;
+    // successor takes place of node with two children
+    Node* moved = node;
+    if (node->left_node && node->right_node) {
+      moved = node->right_node->minimum();
+    }
+    // child takes place of moved, fixup starts from it
+    Node* child = moved->left_node ? moved->left_node : moved->right_node;
+    Node* child_parent = moved->parent_node;
+
+    if (moved != node) {
+      node->left_node->parent_node = moved;
+      moved->left_node = node->left_node;
+      if (moved != node->right_node) {
+        if (child) {
+          child->parent_node = moved->parent_node;
         }
+        moved->parent_node->left_node = child;
+        moved->right_node = node->right_node;
+        node->right_node->parent_node = moved;
+      } else {
+        child_parent = moved;
+      }
+      replace_child(node, moved);
+      moved->parent_node = node->parent_node;
+      std::swap(moved->node_color, node->node_color);
+    } else {
+      if (child) {
+        child->parent_node = moved->parent_node;
+      }
+      replace_child(node, child);
+      if (header_.left_node == node) {
+        header_.left_node = child ? child->minimum() : node->parent_node;
       }
-    };
-    void FixCaseUncleIsCommy(RedBlackTree *tree) {
-      Node *uncle = Uncle();
-      parent_->color_ = Color::kBlack;
-      uncle->color_ = Color::kBlack;
-      Node *granny = Granny();
-      granny->color_ = Color::kRed;
-      granny->AfterInsertFix(tree);
-    };
-    void FixCaseUncleIsBlack(RedBlackTree *tree) {
-      Node *granny = Granny();
-      if (granny && this == parent_->right_ && parent_ == granny->left_) {
-        parent_->RotationLeft(tree);
-        FixCaseRollingUncleAgain(tree);
-        return;
-      } else if (granny && this == parent_->left_ &&
-                 parent_ == granny->right_) {
-        parent_->RotationRight(tree);
-        FixCaseRollingUncleAgain(tree);
-        return;
+      if (header_.right_node == node) {
+        header_.right_node = child ? child->maximum() : node->parent_node;
       }
-      parent_->FixCaseRollingUncleAgain(tree);
-    };
-    void FixCaseRollingUncleAgain(RedBlackTree *tree) {
-      color_ = Color::kBlack;
-      parent_->color_ = Color::kRed;
-      if (this == parent_->left_) {
-        parent_->RotationRight(tree);
+    }
+    --size_;
+
+    // Node now holds color of position that lost a node
+    if (node->node_color == color::kRed) {
+      return;
+    }
+    while (child != root &&
+           (!child || child->node_color == color::kBlack)) {
+      if (child == child_parent->left_node) {
+        Node* sibling = child_parent->right_node;
+        if (sibling->node_color == color::kRed) {
+          sibling->node_color = color::kBlack;
+          child_parent->node_color = color::kRed;
+          rotate_left(child_parent);
+          sibling = child_parent->right_node;
+        }
+        if (is_black(sibling->left_node) && is_black(sibling->right_node)) {
+          sibling->node_color = color::kRed;
+          child = child_parent;
+          child_parent = child_parent->parent_node;
+          continue;
+        }
+        if (is_black(sibling->right_node)) {
+          sibling->left_node->node_color = color::kBlack;
+          sibling->node_color = color::kRed;
+          rotate_right(sibling);
+          sibling = child_parent->right_node;
+        }
+        sibling->node_color = child_parent->node_color;
+        child_parent->node_color = color::kBlack;
+        sibling->right_node->node_color = color::kBlack;
+        rotate_left(child_parent);
       } else {
-        parent_->RotationLeft(tree);
+        Node* sibling = child_parent->left_node;
+        if (sibling->node_color == color::kRed) {
+          sibling->node_color = color::kBlack;
+          child_parent->node_color = color::kRed;
+          rotate_right(child_parent);
+          sibling = child_parent->left_node;
+        }
+        if (is_black(sibling->left_node) && is_black(sibling->right_node)) {
+          sibling->node_color = color::kRed;
+          child = child_parent;
+          child_parent = child_parent->parent_node;
+          continue;
+        }
+        if (is_black(sibling->left_node)) {
+          sibling->right_node->node_color = color::kBlack;
+          sibling->node_color = color::kRed;
+          rotate_left(sibling);
+          sibling = child_parent->left_node;
+        }
+        sibling->node_color = child_parent->node_color;
+        child_parent->node_color = color::kBlack;
+        sibling->left_node->node_color = color::kBlack;
+        rotate_right(child_parent);
       }
-    };
+      break;
+    }
+    if (child) {
+      child->node_color = color::kBlack;
+    }
+  }
 
-    void DeleteLeaf() {}
+  // Puts replacement in place of node in its parent
+  void replace_child(Node* node, Node* replacement) noexcept {
+    if (node == header_.parent_node) {
+      header_.parent_node = replacement;
+    } else if (node == node->parent_node->left_node) {
+      node->parent_node->left_node = replacement;
+    } else {
+      node->parent_node->right_node = replacement;
+    }
+  }
 
-    K key_;
-    V value_;
-    Node *parent_ = nullptr, *left_ = nullptr, *right_ = nullptr;
-    Color color_ = Color::kRed;
-  };
+  static bool is_black(const Node* node) noexcept {
+    return !node || node->node_color == color::kBlack;
+  }
 
-  Node *root_;
+  [[no_unique_address]] rebind_alloc al_;
+  [[no_unique_address]] Compare comp_;
+  size_type size_ = 0;
+  Node header_;
+  [[no_unique_address]] sp::node_slab<ValueNode, SlabSize> slabs_;
 };
-}  // namespace s21
+}  // namespace sp
 
-#endif  // SRC_CONTAINERS_S21_RED_BLACK_TREE_H_
\ No newline at end of file
+#endif  // SP_CONTAINERS_RED_BLACK_TREE_H_
@@ -16,7 +16,6 @@ class reverse_iterator {
   using reference = typename BidIt::reference;
 
   constexpr explicit reverse_iterator(const BidIt& it) : fwd_it_(it){};
-  constexpr virtual ~reverse_iterator() = default;
 
   constexpr pointer* base() const noexcept { return fwd_it_; }
 
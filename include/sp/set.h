@@ -1,11 +1,223 @@
-#ifndef SRC_CONTAINERS_S21_SET_H_
-#define SRC_CONTAINERS_S21_SET_H_
+#ifndef SP_CONTAINERS_SET_H_
+#define SP_CONTAINERS_SET_H_
 
-namespace s21 {
-template <typename T>
+#include <cstdint>           // int64_t
+#include <functional>        // std::less
+#include <initializer_list>  // std::initializer_list
+#include <memory>            // std::allocator
+#include <type_traits>       // std::is_convertible
+#include <utility>           // std::pair
+
+#include <sp/red_black_tree.h>
+
+namespace sp {
+// Key type must meet requirements of Erasable
+// Compare must induce strict weak ordering on keys, if it is transparent
+//  lookup methods accept any type comparable with keys
+// Allocator type must meet requirements of Allocator
+// SlabSize is number of nodes allocated at once, see sp::red_black_tree
+// Methods may have additional requirements on types
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>, int64_t SlabSize = 0>
 class set {
+  using tree_type = sp::red_black_tree<Key, Key, sp::identity_key, Compare,
+                                       Allocator, SlabSize>;
+
+  static constexpr bool kTransparent =
+      requires { typename Compare::is_transparent; };
+
  public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = Key&;
+  using const_reference = const Key&;
+  using size_type = int64_t;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Keys are never modified through iterators
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+  set() = default;
+
+  explicit set(const Compare& comp, const Allocator& al = Allocator())
+      : tree_(comp, al) {}
+
+  explicit set(const Allocator& al) : tree_(Compare(), al) {}
+
+  template <typename InputIterator>
+  set(InputIterator first, InputIterator last,
+      const Compare& comp = Compare(), const Allocator& al = Allocator())
+      : tree_(comp, al) {
+    insert(first, last);
+  }
+
+  set(std::initializer_list<Key> vals, const Compare& comp = Compare(),
+      const Allocator& al = Allocator())
+      : set(vals.begin(), vals.end(), comp, al) {}
+
+  set(const set& other) = default;
+  set(const set& other, const Allocator& al) : tree_(other.tree_, al) {}
+  set(set&& other) noexcept = default;
+  set(set&& other, const Allocator& al) : tree_(std::move(other.tree_), al) {}
+
+  set& operator=(const set& other) = default;
+  set& operator=(set&& other) = default;
+
+  set& operator=(std::initializer_list<Key> vals) {
+    clear();
+    insert(vals);
+    return *this;
+  }
+
+  ~set() = default;
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  }
+
+  key_compare key_comp() const { return tree_.key_comp(); }
+  value_compare value_comp() const { return tree_.key_comp(); }
+
+  iterator begin() const noexcept { return tree_.begin(); }
+  const_iterator cbegin() const noexcept { return tree_.begin(); }
+
+  iterator end() const noexcept { return tree_.end(); }
+  const_iterator cend() const noexcept { return tree_.end(); }
+
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+  //============================================================================
+
+  bool integrity() const { return tree_.integrity(); }
+
+  void clear() noexcept { tree_.clear(); }
+
+  // Key must meet additional requirements of CopyInsertable
+  std::pair<iterator, bool> insert(const Key& value) {
+    return tree_.insert_unique(value);
+  }
+
+  // Key must meet additional requirements of MoveInsertable
+  std::pair<iterator, bool> insert(Key&& value) {
+    return tree_.insert_unique(std::move(value));
+  }
+
+  // Key must meet additional requirements of EmplaceConstructible from
+  //  *first
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) {
+      tree_.emplace_unique(*first);
+    }
+  }
+
+  // Same as insert(vals.begin(), vals.end())
+  void insert(std::initializer_list<Key> vals) {
+    insert(vals.begin(), vals.end());
+  }
+
+  // Key must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.emplace_unique(std::forward<Args>(args)...);
+  }
+
+  iterator erase(const_iterator pos) noexcept { return tree_.erase(pos); }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    return tree_.erase(first, last);
+  }
+
+  size_type erase(const Key& key) { return tree_.erase_key(key); }
+
+  template <typename K>
+    requires(kTransparent && !std::is_convertible<K, const_iterator>::value)
+  size_type erase(K&& key) {
+    return tree_.erase_key(key);
+  }
+
+  void swap(set& other) noexcept(noexcept(tree_.swap(other.tree_))) {
+    tree_.swap(other.tree_);
+  }
+
+  //============================================================================
+  size_type count(const Key& key) const { return tree_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  size_type count(const K& key) const {
+    return tree_.contains(key);
+  }
+
+  iterator find(const Key& key) const { return tree_.find(key); }
+
+  template <typename K>
+    requires kTransparent
+  iterator find(const K& key) const {
+    return tree_.find(key);
+  }
+
+  bool contains(const Key& key) const { return tree_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  bool contains(const K& key) const {
+    return tree_.contains(key);
+  }
+
+  iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  }
+
+  iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  //============================================================================
+
+  // Key must meet additional requirements of EqualityComparable
+  bool operator==(const set& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    const_iterator second = other.begin();
+    for (auto first = begin(); first != end(); ++first, ++second) {
+      if (!(*first == *second)) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const set& other) const { return !(*this == other); }
+
  private:
+  tree_type tree_;
 };
-}  // namespace s21
-#endif  // SRC_CONTAINERS_S21_SET_H_
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_SET_H_
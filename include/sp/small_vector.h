@@ -0,0 +1,303 @@
+#ifndef SP_CONTAINERS_SMALL_VECTOR_H_
+#define SP_CONTAINERS_SMALL_VECTOR_H_
+
+#include <sp/vector.h>
+
+#include <algorithm>         // std::move, std::rotate
+#include <cstdint>           // int64_t
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::distance
+#include <memory>            // std::allocator, std::allocator_traits
+#include <type_traits>       // as name suggests
+#include <utility>           // std::move, std::swap
+
+namespace sp {
+// Serves first request of at most N elements from storage placed inside
+// allocator object itself, passes others to Upstream allocator.
+// Inline storage can only be deallocated by its owner, thus allocator
+// compares equal only to itself and is not meant to be used outside of
+// sp::small_vector
+template <typename T, int64_t N, class Upstream = std::allocator<T>>
+class inline_allocator {
+  static_assert(N > 0, "Inline storage must hold at least one element");
+  using up_traits = std::allocator_traits<Upstream>;
+
+ public:
+  using value_type = T;
+  using size_type = typename up_traits::size_type;
+
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  template <typename U>
+  struct rebind {
+    using other = inline_allocator<
+        U, N, typename up_traits::template rebind_alloc<U>>;
+  };
+
+  struct allocation_result {
+    T* ptr;
+    size_type count;
+  };
+
+  inline_allocator() noexcept(
+      std::is_nothrow_default_constructible<Upstream>::value)
+      : used_(false) {}
+
+  inline_allocator(const Upstream& up) noexcept : up_(up), used_(false) {}
+
+  // Copies get their own empty storage
+  inline_allocator(const inline_allocator& other) noexcept
+      : up_(up_traits::select_on_container_copy_construction(other.up_)),
+        used_(false) {}
+
+  inline_allocator& operator=(const inline_allocator& other) noexcept {
+    (void)other;
+    return *this;
+  }
+
+  ~inline_allocator() = default;
+
+  T* allocate(size_type n) { return allocate_at_least(n).ptr; }
+
+  allocation_result allocate_at_least(size_type n) {
+    if (!used_ && n <= static_cast<size_type>(N)) {
+      used_ = true;
+      return {storage(), static_cast<size_type>(N)};
+    }
+    return {up_traits::allocate(up_, n), n};
+  }
+
+  void deallocate(T* ptr, size_type n) {
+    if (ptr == storage()) {
+      used_ = false;
+    } else {
+      up_traits::deallocate(up_, ptr, n);
+    }
+  }
+
+  size_type max_size() const noexcept { return up_traits::max_size(up_); }
+
+  bool owns(const T* ptr) const noexcept { return ptr == storage(); }
+  const Upstream& upstream() const noexcept { return up_; }
+
+  bool operator==(const inline_allocator& other) const noexcept {
+    return this == &other;
+  }
+  bool operator!=(const inline_allocator& other) const noexcept {
+    return this != &other;
+  }
+
+ private:
+  T* storage() noexcept { return reinterpret_cast<T*>(storage_); }
+  const T* storage() const noexcept {
+    return reinterpret_cast<const T*>(storage_);
+  }
+
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+  Upstream up_;
+  bool used_;
+};
+
+// Vector keeping up to N elements inside the object, without touching
+// allocator. Spills to memory of Allocator once grown past N elements.
+// Has same interface and requirements on types as sp::vector, except that
+// move and swap are linear in size while elements are stored inline.
+// Copy assignment, insert, emplace and erase work in place on inline
+// elements even for types sp::vector reallocates for, so they only give
+// basic exception guarantee there: inline storage has no spare buffer to
+// build the result in
+template <typename T, int64_t N, class Allocator = std::allocator<T>,
+          class GrowthPolicy = sp::doubling_growth>
+class small_vector
+    : public sp::vector<T, sp::inline_allocator<T, N, Allocator>,
+                        GrowthPolicy> {
+  using base =
+      sp::vector<T, sp::inline_allocator<T, N, Allocator>, GrowthPolicy>;
+  using pointer_buffer = typename base::pointer_buffer;
+
+ public:
+  using typename base::const_iterator;
+  using typename base::const_reference;
+  using typename base::iterator;
+  using typename base::size_type;
+  using typename base::value_type;
+
+  static constexpr size_type kInlineCapacity = N;
+
+  using base::base;
+
+  small_vector() = default;
+
+  explicit small_vector(const Allocator& al) noexcept : base(al) {}
+
+  small_vector(const small_vector& other) = default;
+
+  // T must meet additional requirements of MoveInsertable into *this
+  small_vector(small_vector&& other) noexcept(
+      sp::is_trivially_relocatable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value)
+      : base(other.al_.upstream()) {
+    take(other);
+  }
+
+  // T must meet additional requirements of
+  //  CopyInsertable and CopyAssignable into *this
+  small_vector& operator=(const small_vector& other) {
+    if (this != &other) {
+      this->assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  small_vector& operator=(small_vector&& other) noexcept(
+      std::allocator_traits<Allocator>::is_always_equal::value &&
+      (sp::is_trivially_relocatable<T>::value ||
+       std::is_nothrow_move_constructible<T>::value)) {
+    if (this != &other) {
+      this->clear();
+      {
+        // Old buffer must go back first, so inline storage is free
+        pointer_buffer temp(&this->al_);
+        this->buf_.swap(temp);
+      }
+      take(other);
+    }
+    return *this;
+  }
+
+  ~small_vector() = default;
+
+  // True if elements are stored inside the object
+  bool is_inline() const noexcept { return this->al_.owns(this->buf_.ptr); }
+
+  // Moves elements back inline if they fit, does nothing if already there
+  void shrink_to_fit() {
+    if (!is_inline()) {
+      base::shrink_to_fit();
+    }
+  }
+
+  // T must meet additional requirements of CopyAssignable
+  //   and CopyInsertable into *this
+  iterator insert(const_iterator pos, const_reference value) {
+    return insert(pos, size_type(1), value);
+  }
+
+  // T must meet additional requirements of MoveAssignable
+  //   and MoveInsertable into *this
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, std::move(value));
+  }
+
+  // T must meet additional requirements of CopyAssignable
+  //   and CopyInsertable into *this
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
+    if constexpr (!base::kRotateInPlace) {
+      if (is_inline() && this->size_ + count <= this->buf_.cap) {
+        size_type ind = pos - this->cbegin();
+        this->fill(this->buf_.ptr + this->size_, count, value);
+        this->size_ += count;
+        return rotate_back(ind, count);
+      }
+    }
+    return base::insert(pos, count, value);
+  }
+
+  // T must meet additional requirements of Swappable, MoveAssignable,
+  //   MoveConstructible, EmplaceConstructible and MoveInsertable into *this
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    if constexpr (!base::kRotateInPlace) {
+      size_type count = std::distance(first, last);
+      if (is_inline() && this->size_ + count <= this->buf_.cap) {
+        size_type ind = pos - this->cbegin();
+        this->fill(this->buf_.ptr + this->size_, first, last);
+        this->size_ += count;
+        return rotate_back(ind, count);
+      }
+    }
+    return base::insert(pos, first, last);
+  }
+
+  // Same as insert(pos, values.begin(), values.end())
+  iterator insert(const_iterator pos, std::initializer_list<T> values) {
+    return insert(pos, values.begin(), values.end());
+  }
+
+  // T must meet additional requirements of EmplaceConstrutible from args,
+  //  MoveAssignable and MoveInsertable into *this
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    if constexpr (!base::kShiftInPlace) {
+      if (is_inline() && this->size_ < this->buf_.cap) {
+        size_type ind = pos - this->cbegin();
+        this->emplace_back(std::forward<Args>(args)...);
+        return rotate_back(ind, 1);
+      }
+    }
+    return base::emplace(pos, std::forward<Args>(args)...);
+  }
+
+  // Same as erase(pos, pos + 1)
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  // T must meet additional requirements of MoveAssignable
+  iterator erase(const_iterator first, const_iterator last) {
+    if constexpr (!base::kShiftInPlace) {
+      if (is_inline()) {
+        size_type start = first - this->cbegin();
+        size_type finish = last - this->cbegin();
+        size_type count = finish - start;
+        std::move(this->buf_.ptr + finish, this->buf_.ptr + this->size_,
+                  this->buf_.ptr + start);
+        this->destroy_content(this->buf_.ptr + this->size_ - count, count);
+        this->size_ -= count;
+        return this->begin() + start;
+      }
+    }
+    return base::erase(first, last);
+  }
+
+  // T must meet additional requirements of MoveInsertable into *this
+  void swap(small_vector& other) {
+    if (!is_inline() && !other.is_inline() &&
+        this->al_.upstream() == other.al_.upstream()) {
+      this->buf_.swap(other.buf_);
+      std::swap(this->size_, other.size_);
+    } else {
+      small_vector temp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(temp);
+    }
+  }
+
+ private:
+  // Takes heap buffer of other or relocates elements out of its inline
+  // storage, *this must not hold any memory
+  void take(small_vector& other) {
+    if (!other.is_inline() &&
+        this->al_.upstream() == other.al_.upstream()) {
+      this->buf_.swap(other.buf_);
+    } else if (other.size_) {
+      pointer_buffer temp(other.size_, &this->al_);
+      this->relocate(temp.ptr, other.buf_.ptr, other.size_);
+      this->buf_.swap(temp);
+    }
+    this->size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  // Moves last count elements to position ind
+  iterator rotate_back(size_type ind, size_type count) {
+    std::rotate(this->buf_.ptr + ind, this->buf_.ptr + this->size_ - count,
+                this->buf_.ptr + this->size_);
+    return this->begin() + ind;
+  }
+};
+}  // namespace sp
+#endif  // SP_CONTAINERS_SMALL_VECTOR_H_
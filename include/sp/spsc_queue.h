@@ -0,0 +1,204 @@
+#ifndef SP_CONTAINERS_SPSC_QUEUE_H_
+#define SP_CONTAINERS_SPSC_QUEUE_H_
+
+#include <algorithm>    // std::min
+#include <atomic>       // std::atomic, std::memory_order
+#include <bit>          // std::bit_ceil
+#include <cstdint>      // int64_t, uint64_t
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // std::length_error
+#include <type_traits>  // as name suggests
+#include <utility>      // std::forward, std::move
+
+#include <sp/concurrency.h>  // sp::kCacheLineSize, sp::spin_wait
+
+namespace sp {
+// Bounded lock-free queue for one producer and one consumer thread.
+//  Elements live in a power of two ring buffer, positions grow without
+//  wrapping and each side keeps its own on a separate cache line together
+//  with a cached copy of the other one, so that it reads the shared
+//  position only when the cached copy says queue is full or empty
+// push, emplace and try_ variants must be called only by producer, front,
+//  pop and try_pop only by consumer
+// T type must meet requirements of Erasable
+// Allocator type must meet requirements of Allocator
+template <typename T, typename Allocator = std::allocator<T>>
+class spsc_queue {
+  using al_traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = int64_t;
+  using allocator_type = Allocator;
+
+  // Capacity is rounded up to power of two
+  explicit spsc_queue(size_type capacity, const Allocator& al = Allocator())
+      : al_(al) {
+    if (capacity <= 0 ||
+        static_cast<uint64_t>(capacity) > al_traits::max_size(al_)) {
+      throw std::length_error("Invalid spsc_queue capacity");
+    }
+    cap_ = std::bit_ceil(static_cast<uint64_t>(capacity));
+    buf_ = al_traits::allocate(al_, cap_);
+  }
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  ~spsc_queue() {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      al_traits::destroy(al_, slot(head));
+    }
+    al_traits::deallocate(al_, buf_, cap_);
+  }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept { return al_; }
+
+  size_type capacity() const noexcept { return cap_; }
+
+  // Exact only when neither side is running
+  size_type size() const noexcept {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  // Consumer only, queue must not be empty
+  reference front() noexcept {
+    return *slot(head_.load(std::memory_order_relaxed));
+  }
+  //============================================================================
+
+  // Producer only, false if queue is full
+  // T must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == cap_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == cap_) {
+        return false;
+      }
+    }
+    al_traits::construct(al_, slot(tail), std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // T must meet additional requirements of CopyInsertable
+  bool try_push(const_reference value) { return try_emplace(value); }
+
+  // T must meet additional requirements of MoveInsertable
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  // Pushes as many elements as fit and publishes them at once, returns
+  //  iterator past the last pushed one. Pushed elements stay pushed if
+  //  construction throws
+  // T must meet additional requirements of EmplaceConstructible from
+  //  *first
+  template <typename InputIterator>
+  InputIterator try_push(InputIterator first, InputIterator last) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type end = tail;
+    try {
+      for (; first != last; ++first, ++end) {
+        if (end - head_cache_ == cap_) {
+          head_cache_ = head_.load(std::memory_order_acquire);
+          if (end - head_cache_ == cap_) {
+            break;
+          }
+        }
+        al_traits::construct(al_, slot(end), *first);
+      }
+    } catch (...) {
+      tail_.store(end, std::memory_order_release);
+      throw;
+    }
+    tail_.store(end, std::memory_order_release);
+    return first;
+  }
+
+  // Producer only, waits while queue is full
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    sp::spin_wait waiter;
+    while (!try_emplace(std::forward<Args>(args)...)) {
+      waiter.wait();
+    }
+  }
+
+  void push(const_reference value) { emplace(value); }
+  void push(T&& value) { emplace(std::move(value)); }
+
+  // Consumer only, queue must not be empty
+  void pop() noexcept {
+    size_type head = head_.load(std::memory_order_relaxed);
+    al_traits::destroy(al_, slot(head));
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Consumer only, moves front element to out, false if queue is empty
+  // T must meet additional requirements of MoveAssignable
+  bool try_pop(T& out) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    out = std::move(*slot(head));
+    al_traits::destroy(al_, slot(head));
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only, moves up to count elements to out and releases their
+  //  slots at once, returns number of moved elements
+  // T must meet additional requirements of MoveAssignable, or
+  //  MoveInsertable into container behind out
+  template <typename OutputIterator>
+  size_type try_pop(OutputIterator out, size_type count) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (tail_cache_ - head < count) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+    }
+    size_type end = head + std::min(count, tail_cache_ - head);
+    size_type pos = head;
+    try {
+      for (; pos != end; ++pos, ++out) {
+        *out = std::move(*slot(pos));
+        al_traits::destroy(al_, slot(pos));
+      }
+    } catch (...) {
+      head_.store(pos, std::memory_order_release);
+      throw;
+    }
+    head_.store(end, std::memory_order_release);
+    return end - head;
+  }
+
+ private:
+  T* slot(size_type pos) const noexcept { return buf_ + (pos & (cap_ - 1)); }
+
+  T* buf_ = nullptr;
+  size_type cap_ = 0;
+  [[no_unique_address]] Allocator al_;
+
+  // Consumer side
+  alignas(sp::kCacheLineSize) std::atomic<size_type> head_ = 0;
+  size_type tail_cache_ = 0;
+
+  // Producer side
+  alignas(sp::kCacheLineSize) std::atomic<size_type> tail_ = 0;
+  size_type head_cache_ = 0;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_SPSC_QUEUE_H_
@@ -1,60 +1,62 @@
-#ifndef SRC_CONTAINERS_S21_STACK_H_
-#define SRC_CONTAINERS_S21_STACK_H_
-#include "s21_list.h"
+#ifndef SP_CONTAINERS_STACK_H_
+#define SP_CONTAINERS_STACK_H_
 
-namespace s21 {
-template <typename T, typename containers = s21::list<T>>
+#include <initializer_list>  // std::initializer_list
+#include <utility>           // std::forward, std::move
 
+#include <sp/deque.h>
+
+namespace sp {
+// LIFO adaptor, elements are pushed to and popped from the back
+// Container must provide back, push_back, emplace_back, pop_back, empty,
+//  size and swap, sp::deque, sp::vector and sp::list do
+template <typename T, typename Container = sp::deque<T>>
 class stack {
  public:
-  typedef T value_type;
-  typedef T& reference;
-  typedef const T& const_reference;
-  typedef typename containers::iterator iterator;
-  typedef typename containers::const_iterator const_iterator;
-  typedef size_t size_type;
+  using container_type = Container;
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+  using reference = typename Container::reference;
+  using const_reference = typename Container::const_reference;
 
-  //  Default constructor
-  stack() : base() {}
+  stack() = default;
 
-  //  Initializer list constructor
-  stack(std::initializer_list<value_type> const& items) : base(items) {}
+  explicit stack(const Container& cont) : c_(cont) {}
+  explicit stack(Container&& cont) : c_(std::move(cont)) {}
 
-  //  Copy 
-  stack(const stack& other) : base(other.base) {}
+  template <typename InputIterator>
+  stack(InputIterator first, InputIterator last) : c_(first, last) {}
 
-  //  Move constructor
-  stack(stack&& other) : base(std::move(other.base)) {}
+  stack(std::initializer_list<value_type> vals) : c_(vals) {}
 
-  //  Assignment operator overload for moving an object
-  stack& operator=(stack&& s) {
-    base = std::move(s.base);
-    return *this;
-  }
+  //============================================================================
+  reference top() { return c_.back(); }
+  const_reference top() const { return c_.back(); }
+
+  bool empty() const { return c_.empty(); }
+  size_type size() const { return c_.size(); }
+  //============================================================================
 
-  //  Destructor: 
-  ~stack() = default;
+  void push(const value_type& value) { c_.push_back(value); }
+  void push(value_type&& value) { c_.push_back(std::move(value)); }
 
-//  Stack Element access:
-const_reference top() {
-  return base.back();
- }
+  template <typename... Args>
+  decltype(auto) emplace(Args&&... args) {
+    return c_.emplace_back(std::forward<Args>(args)...);
+  }
 
-// Stack Capacity:
-bool empty() {
-  return base.empty();
-}
+  void pop() { c_.pop_back(); }
 
-size_type size() {
-  return base.size();
-}
+  void swap(stack& other) noexcept(noexcept(c_.swap(other.c_))) {
+    c_.swap(other.c_);
+  }
 
-  void pop() { base.pop_back(); }
-  void push(const_reference value) { base.push_back(value); }
-  void swap(stack& other) { base.swap(other.base); }
+  bool operator==(const stack& other) const { return c_ == other.c_; }
+  bool operator!=(const stack& other) const { return !(*this == other); }
 
- private:
-  containers base;
+ protected:
+  Container c_;
 };
-}  // namespace s21
-#endif  // SRC_CONTAINERS_S21_STACK_H_
\ No newline at end of file
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_STACK_H_
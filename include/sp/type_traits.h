@@ -0,0 +1,56 @@
+#ifndef SP_CONTAINERS_TYPE_TRAITS_H_
+#define SP_CONTAINERS_TYPE_TRAITS_H_
+
+#include <type_traits>  // as name suggests
+
+namespace sp {
+// Type is trivially relocatable if moving an object to a new address and
+// ending lifetime of the original is equivalent to copying its bytes.
+// Trivially copyable types are relocatable by default, others may opt in
+// by specializing this trait, e.g. for types holding std::unique_ptr:
+//  template <>
+//  struct sp::is_trivially_relocatable<my_type> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// Type is bitwise comparable if two objects compare equal exactly when
+// their bytes do, so that equality of ranges reduces to memcmp. Scalars
+// without padding bits are by default, which leaves out floating point
+// types as +0.0 equals -0.0 and NaN equals nothing. Others may opt in by
+// specializing this trait:
+//  template <>
+//  struct sp::is_bitwise_comparable<my_type> : std::true_type {};
+template <typename T>
+struct is_bitwise_comparable
+    : std::bool_constant<std::is_scalar<T>::value &&
+                         std::has_unique_object_representations<T>::value> {
+};
+
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v =
+    is_bitwise_comparable<T>::value;
+
+// Exception safety guarantee containers keep when shifting elements of type
+// that may throw on move and copy.
+//  kStrong - operation either succeeds or has no effects, may reallocate
+//  kBasic - operation works in place, if it throws container stays valid,
+//           but values of shifted elements are unspecified
+enum class guarantee { kStrong, kBasic };
+
+// Strong by default, types may opt in basic guarantee by specializing, e.g.:
+//  template <>
+//  struct sp::exception_guarantee<my_type>
+//      : std::integral_constant<sp::guarantee, sp::guarantee::kBasic> {};
+template <typename T>
+struct exception_guarantee
+    : std::integral_constant<guarantee, guarantee::kStrong> {};
+
+template <typename T>
+inline constexpr guarantee exception_guarantee_v =
+    exception_guarantee<T>::value;
+}  // namespace sp
+#endif  // SP_CONTAINERS_TYPE_TRAITS_H_
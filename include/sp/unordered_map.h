@@ -0,0 +1,341 @@
+#ifndef SP_CONTAINERS_UNORDERED_MAP_H_
+#define SP_CONTAINERS_UNORDERED_MAP_H_
+
+#include <cstdint>           // int64_t
+#include <functional>        // std::hash, std::equal_to
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::next
+#include <memory>            // std::allocator
+#include <stdexcept>         // std::out_of_range
+#include <tuple>             // std::forward_as_tuple
+#include <type_traits>       // std::is_convertible
+#include <utility>           // std::pair, std::piecewise_construct
+
+#include <sp/hash_table.h>
+
+namespace sp {
+// Key type must meet requirements of Erasable
+// T type must meet requirements of Erasable
+// Hash must not throw, KeyEqual must be equivalence relation consistent
+//  with it. If both are transparent lookup methods accept any type they
+//  can take
+// Allocator type must meet requirements of Allocator
+// Keys and values are stored in flat array of sp::hash_table, thus both
+//  must be nothrow movable and any insertion invalidates all iterators
+//  and references
+// Methods may have additional requirements on types
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+  using table_type = sp::hash_table<Key, std::pair<const Key, T>,
+                                    sp::first_key, Hash, KeyEqual, Allocator>;
+
+  static constexpr bool kTransparent =
+      requires { typename Hash::is_transparent; } &&
+      requires { typename KeyEqual::is_transparent; };
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = int64_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  unordered_map() = default;
+
+  explicit unordered_map(size_type bucket_count, const Hash& hash = Hash(),
+                         const KeyEqual& eq = KeyEqual(),
+                         const Allocator& al = Allocator())
+      : table_(bucket_count, hash, eq, al) {}
+
+  explicit unordered_map(const Allocator& al)
+      : table_(0, Hash(), KeyEqual(), al) {}
+
+  template <typename InputIterator>
+  unordered_map(InputIterator first, InputIterator last,
+                size_type bucket_count = 0, const Hash& hash = Hash(),
+                const KeyEqual& eq = KeyEqual(),
+                const Allocator& al = Allocator())
+      : table_(bucket_count, hash, eq, al) {
+    insert(first, last);
+  }
+
+  unordered_map(std::initializer_list<value_type> vals,
+                size_type bucket_count = 0, const Hash& hash = Hash(),
+                const KeyEqual& eq = KeyEqual(),
+                const Allocator& al = Allocator())
+      : unordered_map(vals.begin(), vals.end(), bucket_count, hash, eq, al) {}
+
+  unordered_map(const unordered_map& other) = default;
+  unordered_map(const unordered_map& other, const Allocator& al)
+      : table_(other.table_, al) {}
+  unordered_map(unordered_map&& other) noexcept = default;
+  unordered_map(unordered_map&& other, const Allocator& al)
+      : table_(std::move(other.table_), al) {}
+
+  unordered_map& operator=(const unordered_map& other) = default;
+  unordered_map& operator=(unordered_map&& other) = default;
+
+  unordered_map& operator=(std::initializer_list<value_type> vals) {
+    clear();
+    insert(vals);
+    return *this;
+  }
+
+  ~unordered_map() = default;
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept {
+    return table_.get_allocator();
+  }
+
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  T& at(const Key& key) {
+    iterator pos = find(key);
+    if (pos == end()) {
+      throw std::out_of_range("Key is not present in unordered_map");
+    }
+    return pos->second;
+  }
+
+  const T& at(const Key& key) const {
+    const_iterator pos = find(key);
+    if (pos == end()) {
+      throw std::out_of_range("Key is not present in unordered_map");
+    }
+    return pos->second;
+  }
+
+  // T must meet additional requirements of DefaultConstructible, Key of
+  //  CopyConstructible
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  // T must meet additional requirements of DefaultConstructible, Key of
+  //  MoveConstructible
+  T& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  iterator begin() noexcept { return table_.begin(); }
+  const_iterator begin() const noexcept { return table_.begin(); }
+  const_iterator cbegin() const noexcept { return table_.begin(); }
+
+  iterator end() noexcept { return table_.end(); }
+  const_iterator end() const noexcept { return table_.end(); }
+  const_iterator cend() const noexcept { return table_.end(); }
+
+  bool empty() const noexcept { return table_.empty(); }
+  size_type size() const noexcept { return table_.size(); }
+  size_type max_size() const noexcept { return table_.max_size(); }
+  //============================================================================
+
+  bool integrity() const { return table_.integrity(); }
+
+  // Destroys all values, keeping slots allocated
+  void clear() noexcept { table_.clear(); }
+
+  // value_type must meet additional requirements of CopyInsertable
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return table_.insert_unique(value);
+  }
+
+  // value_type must meet additional requirements of MoveInsertable
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return table_.insert_unique(std::move(value));
+  }
+
+  // value_type must meet additional requirements of EmplaceConstructible
+  //  from *first
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) {
+      table_.emplace_unique(*first);
+    }
+  }
+
+  // Same as insert(vals.begin(), vals.end())
+  void insert(std::initializer_list<value_type> vals) {
+    reserve(size() + size_type(vals.size()));
+    insert(vals.begin(), vals.end());
+  }
+
+  // T must meet additional requirements of Assignable from value
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // T must meet additional requirements of Assignable from value
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+    auto result = try_emplace(std::move(key), std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  // value_type must meet additional requirements of EmplaceConstructible
+  //  from args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return table_.emplace_unique(std::forward<Args>(args)...);
+  }
+
+  // Constructs T from args only if key is not present, never moves from
+  //  arguments otherwise
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    auto pos = table_.find_position(key);
+    if (pos.found) {
+      return {table_.iterator_at(pos.index), false};
+    }
+    iterator inserted = table_.emplace_at(
+        pos, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {inserted, true};
+  }
+
+  // Same as above, but moves key
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    auto pos = table_.find_position(key);
+    if (pos.found) {
+      return {table_.iterator_at(pos.index), false};
+    }
+    iterator inserted = table_.emplace_at(
+        pos, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {inserted, true};
+  }
+
+  iterator erase(iterator pos) noexcept { return table_.erase(pos); }
+  iterator erase(const_iterator pos) noexcept { return table_.erase(pos); }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    return table_.erase(first, last);
+  }
+
+  size_type erase(const Key& key) { return table_.erase_key(key); }
+
+  template <typename K>
+    requires(kTransparent && !std::is_convertible<K, const_iterator>::value)
+  size_type erase(K&& key) {
+    return table_.erase_key(key);
+  }
+
+  void swap(unordered_map& other) noexcept(
+      noexcept(table_.swap(other.table_))) {
+    table_.swap(other.table_);
+  }
+
+  //============================================================================
+  size_type count(const Key& key) const { return table_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  size_type count(const K& key) const {
+    return table_.contains(key);
+  }
+
+  iterator find(const Key& key) { return table_.find(key); }
+  const_iterator find(const Key& key) const { return table_.find(key); }
+
+  template <typename K>
+    requires kTransparent
+  iterator find(const K& key) {
+    return table_.find(key);
+  }
+
+  template <typename K>
+    requires kTransparent
+  const_iterator find(const K& key) const {
+    return table_.find(key);
+  }
+
+  bool contains(const Key& key) const { return table_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  bool contains(const K& key) const {
+    return table_.contains(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    iterator pos = find(key);
+    return {pos, pos == end() ? pos : std::next(pos)};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    const_iterator pos = find(key);
+    return {pos, pos == end() ? pos : std::next(pos)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    iterator pos = find(key);
+    return {pos, pos == end() ? pos : std::next(pos)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    const_iterator pos = find(key);
+    return {pos, pos == end() ? pos : std::next(pos)};
+  }
+  //============================================================================
+
+  // Slots are reported as buckets, each holds at most one value
+  size_type bucket_count() const noexcept { return table_.capacity(); }
+
+  float load_factor() const noexcept {
+    return bucket_count() ? float(size()) / bucket_count() : 0.0f;
+  }
+
+  // Table grows when 7/8 of slots are used
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  // Rebuilds table with at least count slots, dropping erased ones
+  void rehash(size_type count) { table_.rehash(count); }
+
+  // Makes room for count values without rehashing
+  void reserve(size_type count) { table_.reserve(count); }
+
+  // Key and T must meet additional requirements of EqualityComparable
+  bool operator==(const unordered_map& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    for (const value_type& value : *this) {
+      auto pos = other.find(value.first);
+      if (pos == other.end() || !(pos->second == value.second)) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const unordered_map& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  table_type table_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_UNORDERED_MAP_H_
@@ -0,0 +1,240 @@
+#ifndef SP_CONTAINERS_UNORDERED_SET_H_
+#define SP_CONTAINERS_UNORDERED_SET_H_
+
+#include <cstdint>           // int64_t
+#include <functional>        // std::hash, std::equal_to
+#include <initializer_list>  // std::initializer_list
+#include <iterator>          // std::next
+#include <memory>            // std::allocator
+#include <type_traits>       // std::is_convertible
+#include <utility>           // std::pair
+
+#include <sp/hash_table.h>
+
+namespace sp {
+// Key type must meet requirements of Erasable
+// Hash must not throw, KeyEqual must be equivalence relation consistent
+//  with it. If both are transparent lookup methods accept any type they
+//  can take
+// Allocator type must meet requirements of Allocator
+// Keys are stored in flat array of sp::hash_table, thus they must be
+//  nothrow movable and any insertion invalidates all iterators and
+//  references
+// Methods may have additional requirements on types
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_set {
+  using table_type =
+      sp::hash_table<Key, Key, sp::identity_key, Hash, KeyEqual, Allocator>;
+
+  static constexpr bool kTransparent =
+      requires { typename Hash::is_transparent; } &&
+      requires { typename KeyEqual::is_transparent; };
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = Key&;
+  using const_reference = const Key&;
+  using size_type = int64_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  // Keys are never modified through iterators
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  unordered_set() = default;
+
+  explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(),
+                         const KeyEqual& eq = KeyEqual(),
+                         const Allocator& al = Allocator())
+      : table_(bucket_count, hash, eq, al) {}
+
+  explicit unordered_set(const Allocator& al)
+      : table_(0, Hash(), KeyEqual(), al) {}
+
+  template <typename InputIterator>
+  unordered_set(InputIterator first, InputIterator last,
+                size_type bucket_count = 0, const Hash& hash = Hash(),
+                const KeyEqual& eq = KeyEqual(),
+                const Allocator& al = Allocator())
+      : table_(bucket_count, hash, eq, al) {
+    insert(first, last);
+  }
+
+  unordered_set(std::initializer_list<Key> vals, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual(),
+                const Allocator& al = Allocator())
+      : unordered_set(vals.begin(), vals.end(), bucket_count, hash, eq, al) {}
+
+  unordered_set(const unordered_set& other) = default;
+  unordered_set(const unordered_set& other, const Allocator& al)
+      : table_(other.table_, al) {}
+  unordered_set(unordered_set&& other) noexcept = default;
+  unordered_set(unordered_set&& other, const Allocator& al)
+      : table_(std::move(other.table_), al) {}
+
+  unordered_set& operator=(const unordered_set& other) = default;
+  unordered_set& operator=(unordered_set&& other) = default;
+
+  unordered_set& operator=(std::initializer_list<Key> vals) {
+    clear();
+    insert(vals);
+    return *this;
+  }
+
+  ~unordered_set() = default;
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept {
+    return table_.get_allocator();
+  }
+
+  hasher hash_function() const { return table_.hash_function(); }
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  iterator begin() const noexcept { return table_.begin(); }
+  const_iterator cbegin() const noexcept { return table_.begin(); }
+
+  iterator end() const noexcept { return table_.end(); }
+  const_iterator cend() const noexcept { return table_.end(); }
+
+  bool empty() const noexcept { return table_.empty(); }
+  size_type size() const noexcept { return table_.size(); }
+  size_type max_size() const noexcept { return table_.max_size(); }
+  //============================================================================
+
+  bool integrity() const { return table_.integrity(); }
+
+  // Destroys all keys, keeping slots allocated
+  void clear() noexcept { table_.clear(); }
+
+  // Key must meet additional requirements of CopyInsertable
+  std::pair<iterator, bool> insert(const Key& value) {
+    return table_.insert_unique(value);
+  }
+
+  // Key must meet additional requirements of MoveInsertable
+  std::pair<iterator, bool> insert(Key&& value) {
+    return table_.insert_unique(std::move(value));
+  }
+
+  // Key must meet additional requirements of EmplaceConstructible from
+  //  *first
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) {
+      table_.emplace_unique(*first);
+    }
+  }
+
+  // Same as insert(vals.begin(), vals.end())
+  void insert(std::initializer_list<Key> vals) {
+    reserve(size() + size_type(vals.size()));
+    insert(vals.begin(), vals.end());
+  }
+
+  // Key must meet additional requirements of EmplaceConstructible from args
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return table_.emplace_unique(std::forward<Args>(args)...);
+  }
+
+  iterator erase(const_iterator pos) noexcept { return table_.erase(pos); }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    return table_.erase(first, last);
+  }
+
+  size_type erase(const Key& key) { return table_.erase_key(key); }
+
+  template <typename K>
+    requires(kTransparent && !std::is_convertible<K, const_iterator>::value)
+  size_type erase(K&& key) {
+    return table_.erase_key(key);
+  }
+
+  void swap(unordered_set& other) noexcept(
+      noexcept(table_.swap(other.table_))) {
+    table_.swap(other.table_);
+  }
+
+  //============================================================================
+  size_type count(const Key& key) const { return table_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  size_type count(const K& key) const {
+    return table_.contains(key);
+  }
+
+  iterator find(const Key& key) const { return table_.find(key); }
+
+  template <typename K>
+    requires kTransparent
+  iterator find(const K& key) const {
+    return table_.find(key);
+  }
+
+  bool contains(const Key& key) const { return table_.contains(key); }
+
+  template <typename K>
+    requires kTransparent
+  bool contains(const K& key) const {
+    return table_.contains(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) const {
+    iterator pos = find(key);
+    return {pos, pos == end() ? pos : std::next(pos)};
+  }
+
+  template <typename K>
+    requires kTransparent
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    iterator pos = find(key);
+    return {pos, pos == end() ? pos : std::next(pos)};
+  }
+  //============================================================================
+
+  // Slots are reported as buckets, each holds at most one key
+  size_type bucket_count() const noexcept { return table_.capacity(); }
+
+  float load_factor() const noexcept {
+    return bucket_count() ? float(size()) / bucket_count() : 0.0f;
+  }
+
+  // Table grows when 7/8 of slots are used
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  // Rebuilds table with at least count slots, dropping erased ones
+  void rehash(size_type count) { table_.rehash(count); }
+
+  // Makes room for count keys without rehashing
+  void reserve(size_type count) { table_.reserve(count); }
+
+  // Key must meet additional requirements of EqualityComparable
+  bool operator==(const unordered_set& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    for (const Key& key : *this) {
+      auto pos = other.find(key);
+      if (pos == other.end() || !(*pos == key)) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const unordered_set& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  table_type table_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_UNORDERED_SET_H_
@@ -1,10 +1,17 @@
 #ifndef SP_CONTAINERS_VECTOR_H_
 #define SP_CONTAINERS_VECTOR_H_
 
+#include <sp/bulk_algorithms.h>
+#include <sp/container_stats.h>
+#include <sp/growth_policy.h>
 #include <sp/pointer_iterator.h>  // iterator and std::distance
 #include <sp/reverse_iterator.h>
+#include <sp/type_traits.h>  // sp::is_trivially_relocatable, sp::guarantee
 
 #include <cstdint>      // int64_t
+#include <cstring>      // std::memcpy, std::memmove, std::memset
+#include <limits>       // std::numeric_limits
+#include <iterator>     // std::contiguous_iterator, std::to_address
 #include <ostream>      // operator<<
 #include <stdexcept>    // exceptions
 #include <type_traits>  // as name suggests
@@ -13,8 +20,11 @@
 namespace sp {
 // T type must meet requirements of Erasable
 // Allocator type must meet requirements of Allocator
+// GrowthPolicy type must meet requirements of growth policy, see
+//  sp/growth_policy.h
 // Methods may have additional reuirements on types
-template <typename T, class Allocator = std::allocator<T>>
+template <typename T, class Allocator = std::allocator<T>,
+          class GrowthPolicy = sp::doubling_growth>
 class vector {
   using al_traits = std::allocator_traits<Allocator>;
 
@@ -28,35 +38,38 @@ class vector {
   using difference_type = int64_t;
 
   using allocator_type = Allocator;
+  using growth_policy = GrowthPolicy;
 
   using iterator = sp::pointer_iterator<T, vector>;
   using const_iterator = sp::pointer_iterator<const T, vector>;
   using reverse_iterator = sp::reverse_iterator<iterator>;
   using const_reverse_iterator = sp::reverse_iterator<const_iterator>;
 
-  static constexpr size_type kCapMul = 2;
-
   // T has no additional requirements
   // Allocator type must meet additional requirements of DefaultConstructible
   constexpr vector() noexcept(
       std::is_nothrow_default_constructible<Allocator>::value)
-      : size_(0), buf_(&al_) {}
+      : size_(0) {}
 
   // No additional requirements on template types
   constexpr explicit vector(const Allocator& al) noexcept
-      : size_(0), al_(al), buf_(&al_) {}
+      : size_(0), al_(al) {}
 
   // T must meet additional requirements of DefaultInsertable into *this
   constexpr explicit vector(size_type size, const Allocator& al = Allocator())
-      : size_(size), al_(al), buf_(size, &al_) {
-    fill(buf_.ptr, size_);
+      : size_(size), al_(al) {
+    pointer_buffer temp(size_, &al_);
+    fill(temp.ptr, size_);
+    buf_.swap(temp);
   }
 
   // T must meet additional requirements of CopyInsertable into *this
   constexpr explicit vector(size_type size, const_reference value,
                             const Allocator& al = Allocator())
-      : size_(size), al_(al), buf_(size, &al_) {
-    fill(buf_.ptr, size_, value);
+      : size_(size), al_(al) {
+    pointer_buffer temp(size_, &al_);
+    fill(temp.ptr, size_, value);
+    buf_.swap(temp);
   };
 
   // T must meet additional requirements of
@@ -66,29 +79,36 @@ class vector {
   template <typename InputIterator>
   constexpr vector(const InputIterator& first, const InputIterator& last,
                    const Allocator& al = Allocator())
-      : size_(std::distance(first, last)), al_(al), buf_(size_, &al_) {
-    fill(buf_.ptr, first, last);
+      : size_(std::distance(first, last)), al_(al) {
+    pointer_buffer temp(size_, &al_);
+    fill(temp.ptr, first, last);
+    buf_.swap(temp);
   }
 
   // T must meet additional requirements of EmplaceConstructible
   constexpr vector(std::initializer_list<value_type> values,
                    const Allocator& al = Allocator())
-      : size_(values.size()), al_(al), buf_(size_, &al_) {
-    fill(buf_.ptr, values.begin(), values.end());
+      : size_(values.size()), al_(al) {
+    pointer_buffer temp(size_, &al_);
+    fill(temp.ptr, values.begin(), values.end());
+    buf_.swap(temp);
   }
 
   // T must meet additional requirements of CopyInsertable into *this
   constexpr vector(const vector& other)
       : size_(other.size_),
-        al_(al_traits::select_on_container_copy_construction(other.al_)),
-        buf_(other.buf_.cap, &al_) {
-    fill(buf_.ptr, other.begin(), other.end());
+        al_(al_traits::select_on_container_copy_construction(other.al_)) {
+    pointer_buffer temp(other.buf_.cap, &al_);
+    fill(temp.ptr, other.begin(), other.end());
+    buf_.swap(temp);
   }
 
   // T must meet additional requirements of CopyInsertable into *this
   constexpr vector(const vector& other, const Allocator& al)
-      : size_(other.size_), al_(al), buf_(size_, &al_) {
-    fill(buf_.ptr, other.buf_.ptr, other.buf_.ptr + other.size_);
+      : size_(other.size_), al_(al) {
+    pointer_buffer temp(size_, &al_);
+    fill(temp.ptr, other.buf_.ptr, other.buf_.ptr + other.size_);
+    buf_.swap(temp);
   };
 
   // No additional requirements on template types
@@ -96,18 +116,14 @@ class vector {
     if constexpr (!al_traits::is_always_equal::value) {
       al_ = std::move(other.al_);
     }
-    buf_.alc = &al_;
-    buf_.ptr = other.buf_.ptr;
-    buf_.cap = other.buf_.cap;
-    other.buf_.ptr = nullptr;
-    other.buf_.cap = 0;
+    buf_.swap(other.buf_);
     other.size_ = 0;
   }
 
   // T must meet additional requirements of MoveInsertable into *this
   constexpr vector(vector&& other, const Allocator& al) noexcept(
       al_traits::is_always_equal::value)
-      : size_(0), al_(al), buf_(0, &al_) {
+      : size_(0), al_(al) {
     if (al == other.al_) {
       swap(other);
     } else {
@@ -176,7 +192,12 @@ class vector {
   }
 
   // No additional requirements on template types
-  constexpr virtual ~vector() noexcept { clear(); }
+  constexpr ~vector() noexcept {
+    clear();
+    if (buf_.ptr) {
+      al_traits::deallocate(al_, buf_.ptr, buf_.cap);
+    }
+  }
 
   //============================================================================
   // No additional requirements on template types for all methods below
@@ -244,8 +265,11 @@ class vector {
   constexpr bool empty() const noexcept { return !size_; }
   constexpr size_type size() const noexcept { return size_; }
   constexpr size_type capacity() const noexcept { return buf_.cap; }
+  // Limited by size_type for single byte elements
   constexpr size_type max_size() const noexcept {
-    return al_traits::max_size(al_);
+    return static_cast<size_type>(
+        std::min<uint64_t>(al_traits::max_size(al_),
+                           std::numeric_limits<size_type>::max()));
   }
   //============================================================================
 
@@ -256,12 +280,19 @@ class vector {
       throw std::length_error("Invalid count provided");
     }
     if (count > buf_.cap) {
-      pointer_buffer temp(std::max(kCapMul * buf_.cap, count), &al_, buf_.ptr);
+      pointer_buffer temp(grow_cap(count), &al_, buf_.ptr);
       fill(temp.ptr, count, value);
       buf_.swap(temp);
       destroy_content(temp.ptr, size_);
       size_ = count;
     } else {
+      if constexpr (kBitwiseCopyable) {
+        if (!std::is_constant_evaluated()) {
+          sp::bulk_fill(buf_.ptr, count, value);
+          size_ = count;
+          return;
+        }
+      }
       for (size_type i = 0; i < count && i < size_; ++i) {
         buf_.ptr[i] = value;
       }
@@ -279,11 +310,22 @@ class vector {
       throw std::length_error("Invalid or too big range provided");
     }
     if (count > buf_.cap) {
-      pointer_buffer temp(std::max(kCapMul * buf_.cap, count), &al_, buf_.ptr);
+      pointer_buffer temp(grow_cap(count), &al_, buf_.ptr);
       fill(temp.ptr, first, last);
       buf_.swap(temp);
       destroy_content(temp.ptr, size_);
     } else {
+      if constexpr (kBulkCopy<InputIterator>) {
+        if (!std::is_constant_evaluated()) {
+          if (count) {
+            std::memmove(static_cast<void*>(buf_.ptr),
+                         static_cast<const void*>(std::to_address(first)),
+                         count * sizeof(T));
+          }
+          size_ = count;
+          return;
+        }
+      }
       for (size_type i = 0; i < count && i < size_; ++i, ++first) {
         buf_.ptr[i] = *first;
       }
@@ -319,58 +361,26 @@ class vector {
 
   // No additional requirements on template types
   constexpr void clear() noexcept {
-    for (; size_; --size_) {
-      al_traits::destroy(al_, buf_.ptr + size_ - 1);
-    }
+    destroy_content(buf_.ptr, size_);
+    size_ = 0;
   }
 
   // T must meet additional requirements of
   //  MoveInsertable and DefaultInsertable into *this
-  constexpr void resize(size_type count) {
-    if (count > max_size() || count < 0) {
-      throw std::length_error("Invalid count provided");
-    }
-    if (count == size_) {
-      return;
-    } else if (count >= buf_.cap) {
-      pointer_buffer temp(count, &al_, buf_.ptr);
-      move_from(temp.ptr, buf_.ptr, size_);
-      try {
-        fill(temp.ptr + size_, count - size_);
-      } catch (...) {
-        destroy_content(temp.ptr, size_);
-        throw;
-      }
-      buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
-      size_ = count;
-    } else {
-      move_end(count - size_);
-    }
-  }
+  constexpr void resize(size_type count) { resize_with(count); }
 
   // T must meet additional requirements of CopyInsertable into *this
   constexpr void resize(size_type count, const_reference value) {
-    if (count > max_size() || count < 0) {
-      throw std::length_error("Invalid count provided");
-    }
-    if (count == size_) {
-      return;
-    } else if (count >= buf_.cap) {
-      pointer_buffer temp(count, &al_, buf_.ptr);
-      move_from(temp.ptr, buf_.ptr, size_);
-      try {
-        fill(temp.ptr + size_, count - size_, value);
-      } catch (...) {
-        destroy_content(temp.ptr, size_);
-        throw;
-      }
-      buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
-      size_ = count;
-    } else {
-      move_end(count - size_, value);
-    }
+    resize_with(count, value);
+  }
+
+  // Same as resize(count), but new elements are default initialized, so
+  //  trivial ones are left uninitialized to be overwritten by caller.
+  //  Allocator providing construct still constructs them its own way
+  // T must meet additional requirements of
+  //  MoveInsertable and DefaultInsertable into *this
+  constexpr void resize_for_overwrite(size_type count) {
+    resize_with(count, default_init_t{});
   }
   //==============================================================================
 
@@ -391,7 +401,7 @@ class vector {
   // T must meet additional requirements of CopyAssignable
   //   and CopyInsertable into *this
   constexpr iterator insert(const_iterator pos, const_reference value) {
-    return insert(pos, 1, value);
+    return insert(pos, size_type(1), value);
   }
 
   // T must meet additional requirements of MoveAssignable
@@ -402,26 +412,32 @@ class vector {
 
   // T must meet additional requirements of CopyAssignable
   //   and CopyInsertable into *this
+  // Elements are rotated in place if T is nothrow swappable or
+  //   sp::exception_guarantee<T> is kBasic, otherwise vector is reallocated
+  //   to keep strong exception guarantee
   constexpr iterator insert(const_iterator pos, size_type count,
                             const_reference value) {
     size_type ind = pos - begin();
-    if (size_ + count >= buf_.cap || !std::is_nothrow_swappable<T>::value) {
-      pointer_buffer temp(std::max(kCapMul * buf_.cap, size_ + count), &al_,
-                          buf_.ptr);
+    if (size_ + count > buf_.cap || !kRotateInPlace) {
+      pointer_buffer temp(grow_cap(size_ + count), &al_, buf_.ptr);
       fill(temp.ptr + ind, count, value);
       try {
-        split_buffer(temp.ptr, ind, count);
+        relocate_split(temp.ptr, ind, count);
       } catch (...) {
         destroy_content(temp.ptr + ind, count);
         throw;
       }
       buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
-    } else if constexpr (std::is_nothrow_swappable<T>::value) {
+    } else if constexpr (kRotateInPlace) {
       fill(buf_.ptr + size_, count, value);
-      std::reverse(buf_.ptr + ind, buf_.ptr + size_ + count);
-      std::reverse(buf_.ptr + ind, buf_.ptr + ind + count);
-      std::reverse(buf_.ptr + ind + count, buf_.ptr + size_ + count);
+      try {
+        std::reverse(buf_.ptr + ind, buf_.ptr + size_ + count);
+        std::reverse(buf_.ptr + ind, buf_.ptr + ind + count);
+        std::reverse(buf_.ptr + ind + count, buf_.ptr + size_ + count);
+      } catch (...) {
+        destroy_content(buf_.ptr + size_, count);
+        throw;
+      }
     }
     size_ += count;
     return begin() + ind;
@@ -433,23 +449,38 @@ class vector {
   constexpr iterator insert(const_iterator pos, InputIt first, InputIt last) {
     size_type ind = pos - begin();
     size_type count = std::distance(first, last);
-    if (count + size_ >= buf_.cap || !std::is_nothrow_swappable<T>::value) {
-      pointer_buffer temp(std::max(kCapMul * buf_.cap, size_ + count), &al_,
-                          buf_.ptr);
+    if (size_ + count > buf_.cap || !kRotateInPlace) {
+      pointer_buffer temp(grow_cap(size_ + count), &al_, buf_.ptr);
       fill(temp.ptr + ind, first, last);
       try {
-        split_buffer(temp.ptr, ind, count);
+        relocate_split(temp.ptr, ind, count);
       } catch (...) {
         destroy_content(temp.ptr + ind, count);
         throw;
       }
       buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
-    } else if constexpr (std::is_nothrow_swappable<T>::value) {
+    } else if constexpr (kRotateInPlace) {
+      if constexpr (kBulkCopy<InputIt>) {
+        if (!std::is_constant_evaluated() && count) {
+          std::memmove(static_cast<void*>(buf_.ptr + ind + count),
+                       static_cast<const void*>(buf_.ptr + ind),
+                       (size_ - ind) * sizeof(T));
+          std::memcpy(static_cast<void*>(buf_.ptr + ind),
+                      static_cast<const void*>(std::to_address(first)),
+                      count * sizeof(T));
+          size_ += count;
+          return begin() + ind;
+        }
+      }
       fill(buf_.ptr + size_, first, last);
-      std::reverse(buf_.ptr + ind, buf_.ptr + size_ + count);
-      std::reverse(buf_.ptr + ind, buf_.ptr + ind + count);
-      std::reverse(buf_.ptr + ind + count, buf_.ptr + size_ + count);
+      try {
+        std::reverse(buf_.ptr + ind, buf_.ptr + size_ + count);
+        std::reverse(buf_.ptr + ind, buf_.ptr + ind + count);
+        std::reverse(buf_.ptr + ind + count, buf_.ptr + size_ + count);
+      } catch (...) {
+        destroy_content(buf_.ptr + size_, count);
+        throw;
+      }
     }
     size_ += count;
     return begin() + ind;
@@ -461,41 +492,27 @@ class vector {
     return insert(pos, values.begin(), values.end());
   }
 
-  // T must meet additional requirements of MoveAssignable
-  constexpr iterator erase(const_iterator pos) noexcept(
-      std::is_nothrow_move_assignable<T>::value) {
-    size_type ind = pos - begin();
-    if constexpr (std::is_nothrow_move_assignable<T>::value) {
-      for (size_type i = ind; i < size_ - 1; ++i) {
-        buf_.ptr[i] = std::move(buf_.ptr[i + 1]);
-      }
-      al_traits::destroy(al_, buf_.ptr + size_ - 1);
-    } else {
-      pointer_buffer temp(buf_.cap, &al_, buf_.ptr);
-      split_buffer(temp.ptr, ind + 1, -1);
-      buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
-    }
-    --size_;
-    return begin() + ind;
+  // Same as erase(pos, pos + 1)
+  constexpr iterator erase(const_iterator pos) noexcept(kNothrowShift) {
+    return erase(pos, pos + 1);
   }
 
   // T must meet additional requirements of MoveAssignable
-  constexpr iterator erase(const_iterator first, const_iterator last) noexcept(
-      std::is_nothrow_move_assignable<T>::value) {
+  // Elements are shifted in place if it can not throw or
+  //  sp::exception_guarantee<T> is kBasic, otherwise vector is reallocated
+  //  to keep strong exception guarantee
+  constexpr iterator erase(const_iterator first,
+                           const_iterator last) noexcept(kNothrowShift) {
     size_type start = first - begin();
     size_type finish = last - begin();
     size_type count = finish - start;
-    if constexpr (std::is_nothrow_move_assignable<T>::value) {
-      for (size_type i = start; i < size_ - count; ++i) {
-        buf_.ptr[i] = std::move(buf_.ptr[i + count]);
-      }
+    if (finish == size_ || kShiftInPlace) {
+      shift_left(buf_.ptr + start, buf_.ptr + finish, size_ - finish);
       destroy_content(buf_.ptr + size_ - count, count);
     } else {
       pointer_buffer temp(buf_.cap, &al_, buf_.ptr);
-      split_buffer(temp.ptr, finish, -count);
+      relocate_split(temp.ptr, finish, -count);
       buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
     }
     size_ -= count;
     return begin() + start;
@@ -503,29 +520,35 @@ class vector {
 
   // T must meet additional requirements of EmplaceConstrutible from args,
   //  MoveAssignable and MoveInsertable into *this
+  // Elements are shifted in place if it can not throw or
+  //  sp::exception_guarantee<T> is kBasic, otherwise vector is reallocated
+  //  to keep strong exception guarantee
   template <typename... Args>
   constexpr iterator emplace(const_iterator pos, Args&&... args) {
     size_type ind = pos - begin();
-    if (size_ == buf_.cap || !std::is_nothrow_move_assignable<T>::value) {
-      pointer_buffer temp(std::max(kCapMul * buf_.cap, size_type(1)), &al_,
-                          buf_.ptr);
+    if (size_ == buf_.cap || !kShiftInPlace) {
+      pointer_buffer temp(grow_cap(size_ + 1), &al_, buf_.ptr);
       al_traits::construct(al_, temp.ptr + ind, std::forward<Args>(args)...);
       try {
-        split_buffer(temp.ptr, ind, 1);
+        relocate_split(temp.ptr, ind, 1);
       } catch (...) {
         al_traits::destroy(al_, temp.ptr + ind);
         throw;
       }
       buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
-    } else if constexpr (std::is_nothrow_move_assignable<T>::value) {
+    } else if (ind == size_) {
+      al_traits::construct(al_, buf_.ptr + size_, std::forward<Args>(args)...);
+    } else if constexpr (kShiftInPlace) {
       T emp(std::forward<Args>(args)...);
       al_traits::construct(al_, buf_.ptr + size_,
                            std::move(buf_.ptr[size_ - 1]));
-      for (size_type i = size_ - 1; i > ind; --i) {
-        buf_.ptr[i] = std::move(buf_.ptr[i - 1]);
+      try {
+        shift_right(buf_.ptr + ind + 1, buf_.ptr + ind, size_ - ind - 1);
+        move_assign(buf_.ptr + ind, emp);
+      } catch (...) {
+        al_traits::destroy(al_, buf_.ptr + size_);
+        throw;
       }
-      buf_.ptr[ind] = std::move(emp);
     }
     ++size_;
     return begin() + ind;
@@ -536,17 +559,15 @@ class vector {
   template <typename... Args>
   constexpr T& emplace_back(Args&&... args) {
     if (size_ >= buf_.cap) {
-      pointer_buffer temp(std::max(kCapMul * buf_.cap, size_type(1)), &al_,
-                          buf_.ptr);
+      pointer_buffer temp(grow_cap(size_ + 1), &al_, buf_.ptr);
       al_traits::construct(al_, temp.ptr + size_, std::forward<Args>(args)...);
       try {
-        move_from(temp.ptr, buf_.ptr, size_);
+        relocate(temp.ptr, buf_.ptr, size_);
       } catch (...) {
         al_traits::destroy(al_, temp.ptr + size_);
         throw;
       }
       buf_.swap(temp);
-      destroy_content(temp.ptr, size_);
     } else {
       al_traits::construct(al_, buf_.ptr + size_, std::forward<Args>(args)...);
     }
@@ -570,6 +591,12 @@ class vector {
   // T must meet additional requirements of EqualityComparable
   constexpr bool operator==(const vector& other) const noexcept {
     if (size_ != other.size_) return false;
+    if constexpr (std::is_arithmetic<T>::value ||
+                  sp::is_bitwise_comparable<T>::value) {
+      if (!std::is_constant_evaluated()) {
+        return sp::bulk_equal(buf_.ptr, other.buf_.ptr, size_);
+      }
+    }
     for (size_type i = 0; i < size_; ++i)
       if (buf_.ptr[i] != other.buf_.ptr[i]) return false;
     return true;
@@ -598,36 +625,157 @@ class vector {
   }
 
  private:
-  struct pointer_buffer {
-    constexpr explicit pointer_buffer(Allocator* al = nullptr)
-        : alc(al), ptr(nullptr), cap(0) {}
+  // Shares buffer management of vector, see sp/small_vector.h
+  template <typename, int64_t, class, class>
+  friend class small_vector;
+
+  // Elements can be shifted inside buffer without exceptions
+  static constexpr bool kNothrowShift =
+      std::is_nothrow_move_assignable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value ||
+      std::is_nothrow_copy_assignable<T>::value;
+
+  static constexpr bool kShiftInPlace =
+      kNothrowShift ||
+      sp::exception_guarantee<T>::value == sp::guarantee::kBasic;
+
+  static constexpr bool kRotateInPlace =
+      std::is_nothrow_swappable<T>::value ||
+      sp::exception_guarantee<T>::value == sp::guarantee::kBasic;
+
+  // Relocation bypasses allocator construct and destroy, so it is only used
+  // when allocator does not provide its own
+  static constexpr bool kRelocatable =
+      sp::is_trivially_relocatable<T>::value &&
+      !requires(Allocator& al, pointer p) { al.destroy(p); } &&
+      !requires(Allocator& al, pointer p, T&& val) {
+        al.construct(p, std::move(val));
+      };
+
+  // Copies may be made bytewise, bypassing allocator construct and destroy,
+  // when neither is provided by allocator
+  static constexpr bool kBitwiseCopyable =
+      std::is_trivially_copyable<T>::value &&
+      !requires(Allocator& al, pointer p) { al.destroy(p); } &&
+      !requires(Allocator& al, pointer p, const T& val) {
+        al.construct(p, val);
+      };
+
+  // Allocator constructs elements without arguments its own way, e.g.
+  //  sp::default_init_allocator, so they must not be zeroed instead
+  static constexpr bool kAllocatorDefaultConstructs =
+      requires(Allocator& al, pointer p) { al.construct(p); };
+
+  // Marks elements to be default initialized instead of value initialized
+  struct default_init_t {};
+
+  // Range of It is copied with memcpy, see kBitwiseCopyable
+  template <typename It>
+  static constexpr bool kBulkCopy =
+      kBitwiseCopyable && std::contiguous_iterator<It> &&
+      std::is_same<std::iter_value_t<It>, T>::value;
+
+  // Elements constructed from Args are filled with memset or sp::bulk_fill.
+  // Value initialized scalars are zero bytes, except for member pointers
+  template <typename... Args>
+  static constexpr bool kBulkFill =
+      kBitwiseCopyable &&
+      ((sizeof...(Args) == 0 && !kAllocatorDefaultConstructs &&
+        (std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+         std::is_pointer<T>::value)) ||
+       (sizeof...(Args) == 1 &&
+        (std::is_same<std::remove_cvref_t<Args>, T>::value && ...)));
+
+  // Adds amount to counter of vector stats, see sp/container_stats.h
+  static constexpr void record(std::atomic<int64_t> container_stats::*counter,
+                               int64_t amount = 1) noexcept {
+    sp::record_stat<vector>(counter, amount);
+  }
+
+  // Counter of elements constructed from reference of Ref type
+  template <typename Ref>
+  static constexpr std::atomic<int64_t> container_stats::*kConstructStat =
+      std::is_rvalue_reference<Ref&&>::value ? &container_stats::moves
+                                             : &container_stats::copies;
+
+  // Memory held by vector, freed by its destructor. Does not keep pointer
+  // to allocator to keep vector as small as possible
+  struct buffer {
+    constexpr void swap(buffer& other) noexcept {
+      std::swap(ptr, other.ptr);
+      std::swap(cap, other.cap);
+    }
+
+    pointer ptr = nullptr;
+    size_type cap = 0;
+  };
+
+  // Memory freed on scope exit unless swapped into vector
+  struct pointer_buffer : buffer {
+    constexpr explicit pointer_buffer(Allocator* al = nullptr) : alc(al) {}
     constexpr pointer_buffer(size_type size, Allocator* al,
                              pointer hint = nullptr)
-        : alc(al), cap(size) {
-      if (cap < 0) {
+        : alc(al) {
+      if (size < 0) {
         throw std::invalid_argument("Invalid memory buffer length");
       }
-      ptr = (cap) ? al_traits::allocate(*alc, size, hint) : nullptr;
+      this->cap = size;
+      this->ptr = (size) ? allocate(hint) : nullptr;
+      if constexpr (kStatsEnabled) {
+        if (size) {
+          record(&container_stats::allocations);
+          record(&container_stats::allocated_bytes, this->cap * sizeof(T));
+          record(&container_stats::wasted_bytes,
+                 (this->cap - size) * sizeof(T));
+          if (hint) {
+            record(&container_stats::reallocations);
+          }
+        }
+      }
     }
     constexpr pointer_buffer(const pointer_buffer&) = delete;
     constexpr pointer_buffer(pointer_buffer&& other) = delete;
     constexpr pointer_buffer& operator=(const pointer_buffer&) = delete;
     constexpr pointer_buffer& operator=(pointer_buffer&& other) = delete;
-    constexpr ~pointer_buffer() { al_traits::deallocate(*alc, ptr, cap); }
-
-    constexpr void swap(pointer_buffer& other) noexcept {
-      std::swap(ptr, other.ptr);
-      std::swap(cap, other.cap);
+    constexpr ~pointer_buffer() {
+      al_traits::deallocate(*alc, this->ptr, this->cap);
+    }
+
+    // Allocators providing allocate_at_least(n), that returns
+    //  std::allocation_result-like {ptr, count}, may give more memory than
+    //  asked, in which case cap is set to actual capacity
+    constexpr pointer allocate(pointer hint) {
+      if constexpr (requires { alc->allocate_at_least(this->cap); }) {
+        auto result = alc->allocate_at_least(this->cap);
+        this->cap = static_cast<size_type>(result.count);
+        return result.ptr;
+      } else {
+        return al_traits::allocate(*alc, this->cap, hint);
+      }
     }
 
     Allocator* alc;
-    pointer ptr;
-    size_type cap;
   };
 
   template <typename... Args>
   constexpr void fill(pointer arr, size_type count, Args&&... args) noexcept(
       std::is_nothrow_constructible<T, Args...>::value) {
+    if constexpr (kStatsEnabled && sizeof...(Args) == 1 &&
+                  (std::is_same<std::remove_cvref_t<Args>, T>::value && ...)) {
+      record(kConstructStat<Args...>, count);
+    }
+    if constexpr (kBulkFill<Args...>) {
+      if (!std::is_constant_evaluated()) {
+        if constexpr (sizeof...(Args) == 0) {
+          if (count) {
+            std::memset(static_cast<void*>(arr), 0, count * sizeof(T));
+          }
+        } else {
+          sp::bulk_fill(arr, count, args...);
+        }
+        return;
+      }
+    }
     size_type i = 0;
     try {
       for (; i < count; ++i) {
@@ -641,16 +789,57 @@ class vector {
     }
   }
 
+  // Default initializes count elements, trivial ones are left as they are.
+  //  Allocator construct, if provided, and constant evaluation construct
+  //  them as usual
+  constexpr void fill(pointer arr, size_type count, default_init_t) noexcept(
+      std::is_nothrow_default_constructible<T>::value) {
+    if constexpr (!kAllocatorDefaultConstructs) {
+      if (!std::is_constant_evaluated()) {
+        if constexpr (!std::is_trivially_default_constructible<T>::value) {
+          size_type i = 0;
+          try {
+            for (; i < count; ++i) {
+              ::new (static_cast<void*>(arr + i)) T;
+            }
+          } catch (...) {
+            destroy_content(arr, i);
+            if constexpr (!std::is_nothrow_default_constructible<T>::value) {
+              throw;
+            }
+          }
+        }
+        return;
+      }
+    }
+    fill(arr, count);
+  }
+
   template <typename InIt>
   constexpr void fill(pointer arr, InIt first, InIt last) noexcept(
       std::is_nothrow_copy_constructible<T>::value) {
+    if constexpr (kBulkCopy<InIt>) {
+      if (!std::is_constant_evaluated()) {
+        if (first != last) {
+          std::memcpy(static_cast<void*>(arr),
+                      static_cast<const void*>(std::to_address(first)),
+                      (last - first) * sizeof(T));
+        }
+        record(&container_stats::copies, last - first);
+        return;
+      }
+    }
     InIt i = first;
+    [[maybe_unused]] pointer start = arr;
     try {
       for (; i != last; ++i, ++arr) al_traits::construct(al_, arr, *i);
     } catch (...) {
       for (; i != first; --i) al_traits::destroy(al_, --arr);
       if constexpr (!std::is_nothrow_copy_constructible<T>::value) throw;
     }
+    if constexpr (kStatsEnabled) {
+      record(kConstructStat<decltype(*first)>, arr - start);
+    }
   }
 
   constexpr void move_from(
@@ -668,13 +857,70 @@ class vector {
         throw;
       }
     }
+    record(std::is_nothrow_move_constructible<T>::value
+               ? &container_stats::moves
+               : &container_stats::copies,
+           count);
   }
 
   constexpr void resize_buffer(size_type n_size) {
-    pointer_buffer temp(n_size, &al_);
-    move_from(temp.ptr, buf_.ptr, size_);
+    pointer_buffer temp(n_size, &al_, buf_.ptr);
+    relocate(temp.ptr, buf_.ptr, size_);
     buf_.swap(temp);
-    destroy_content(temp.ptr, size_);
+  }
+
+  // Moves count elements from source to dest and ends their lifetime at
+  // source. Trivially relocatable types are copied bytewise
+  constexpr void relocate(
+      pointer dest, pointer source,
+      size_type count) noexcept(kRelocatable ||
+                                std::is_nothrow_move_constructible<T>::value) {
+    if constexpr (kRelocatable) {
+      if (!std::is_constant_evaluated()) {
+        if (count) {
+          std::memcpy(static_cast<void*>(dest),
+                      static_cast<const void*>(source), count * sizeof(T));
+        }
+        record(&container_stats::moves, count);
+        return;
+      }
+    }
+    move_from(dest, source, count);
+    destroy_content(source, count);
+  }
+
+  // Capacity of buffer able to hold required elements as set by growth
+  // policy, current one if they already fit
+  constexpr size_type grow_cap(size_type required) const noexcept {
+    size_type cap = (required > buf_.cap)
+                        ? GrowthPolicy::grow(buf_.cap, required, sizeof(T))
+                        : buf_.cap;
+    record(&container_stats::wasted_bytes, (cap - required) * sizeof(T));
+    return cap;
+  }
+
+  // Resizes vector, new elements are constructed from args
+  template <typename... Args>
+  constexpr void resize_with(size_type count, const Args&... args) {
+    if (count > max_size() || count < 0) {
+      throw std::length_error("Invalid count provided");
+    }
+    if (count == size_) {
+      return;
+    } else if (count > buf_.cap) {
+      pointer_buffer temp(count, &al_, buf_.ptr);
+      fill(temp.ptr + size_, count - size_, args...);
+      try {
+        relocate(temp.ptr, buf_.ptr, size_);
+      } catch (...) {
+        destroy_content(temp.ptr + size_, count - size_);
+        throw;
+      }
+      buf_.swap(temp);
+      size_ = count;
+    } else {
+      move_end(count - size_, args...);
+    }
   }
 
   template <typename... Args>
@@ -700,16 +946,67 @@ class vector {
     }
   }
 
+  // Same as split_buffer, but also ends lifetime of every element in buf_,
+  // erased ones included
+  constexpr void relocate_split(pointer dest, size_type ind,
+                                size_type offset) {
+    if constexpr (kRelocatable) {
+      if (!std::is_constant_evaluated()) {
+        size_type lim = std::min(ind, ind + offset);
+        destroy_content(buf_.ptr + lim, ind - lim);
+        relocate(dest, buf_.ptr, lim);
+        relocate(dest + ind + offset, buf_.ptr + ind, size_ - ind);
+        return;
+      }
+    }
+    split_buffer(dest, ind, offset);
+    destroy_content(buf_.ptr, size_);
+  }
+
+  // Gives dest value of source, the way which can not throw is preferred.
+  // Element is move constructed in place of destroyed one if T is not
+  // nothrow move assignable but is nothrow move constructible
+  constexpr void move_assign(pointer dest,
+                             reference source) noexcept(kNothrowShift) {
+    if constexpr (std::is_nothrow_move_assignable<T>::value) {
+      *dest = std::move(source);
+    } else if constexpr (std::is_nothrow_move_constructible<T>::value) {
+      al_traits::destroy(al_, dest);
+      al_traits::construct(al_, dest, std::move(source));
+    } else if constexpr (std::is_nothrow_copy_assignable<T>::value) {
+      *dest = source;
+    } else {
+      *dest = std::move(source);
+    }
+  }
+
+  // Moves count elements from source to dest, dest must precede source
+  constexpr void shift_left(pointer dest, pointer source,
+                            size_type count) noexcept(kNothrowShift) {
+    for (size_type i = 0; i < count; ++i) {
+      move_assign(dest + i, source[i]);
+    }
+  }
+
+  // Moves count elements from source to dest, source must precede dest
+  constexpr void shift_right(pointer dest, pointer source,
+                             size_type count) noexcept(kNothrowShift) {
+    for (; count; --count) {
+      move_assign(dest + count - 1, source[count - 1]);
+    }
+  }
+
   constexpr void destroy_content(pointer ptr, size_type count) noexcept(
       std::is_nothrow_destructible<T>::value) {
+    record(&container_stats::destructions, count);
     for (; count; --count) {
       al_traits::destroy(al_, ptr + count - 1);
     }
   }
 
   size_type size_;
-  allocator_type al_;
-  pointer_buffer buf_;
+  [[no_unique_address]] allocator_type al_;
+  buffer buf_;
 };
 }  // namespace sp
 #endif  // SP_CONTAINERS_VECTOR_H_
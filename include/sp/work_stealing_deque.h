@@ -0,0 +1,218 @@
+#ifndef SP_CONTAINERS_WORK_STEALING_DEQUE_H_
+#define SP_CONTAINERS_WORK_STEALING_DEQUE_H_
+
+#include <atomic>       // std::atomic, std::memory_order
+#include <bit>          // std::bit_ceil
+#include <cstdint>      // int64_t, uint64_t
+#include <memory>       // std::allocator, std::allocator_traits
+#include <stdexcept>    // std::length_error
+#include <type_traits>  // as name suggests
+
+#include <sp/concurrency.h>  // sp::kCacheLineSize
+
+namespace sp {
+// Chase-Lev work-stealing deque. Owner thread pushes and pops at the
+//  bottom like a stack, any other thread steals from the top, so owner
+//  runs its freshest tasks while thieves take the oldest ones. Only the
+//  last element is contended, the owner never takes a lock and a thief
+//  performs a single compare-and-swap
+// Buffer grows by doubling when owner pushes to a full one. Thieves may
+//  still read the old buffer, so replaced buffers are kept until the
+//  deque is destroyed, taking at most as much memory as the current one
+// push, pop and reserve must be called only by owner, steal by any thread
+// T type must meet requirements of TriviallyCopyable, usually pointer
+//  or handle of a task, as thieves may copy it while owner overwrites it
+// Allocator type must meet requirements of Allocator
+template <typename T, typename Allocator = std::allocator<T>>
+class work_stealing_deque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Work stealing deque holds trivially copyable elements");
+
+ public:
+  using value_type = T;
+  using size_type = int64_t;
+  using allocator_type = Allocator;
+
+  // Capacity of the first buffer when none is given
+  static constexpr size_type kDefaultCapacity = 32;
+
+  // Capacity is rounded up to power of two
+  explicit work_stealing_deque(size_type capacity = kDefaultCapacity,
+                               const Allocator& al = Allocator())
+      : al_(al) {
+    if (capacity <= 0) {
+      throw std::length_error("Invalid work_stealing_deque capacity");
+    }
+    ring_.store(make_ring(std::bit_ceil(static_cast<uint64_t>(capacity)),
+                          nullptr),
+                std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  ~work_stealing_deque() {
+    ring* current = ring_.load(std::memory_order_relaxed);
+    while (current) {
+      ring* retired = current->retired;
+      free_ring(current);
+      current = retired;
+    }
+  }
+
+  //============================================================================
+  allocator_type get_allocator() const noexcept { return al_; }
+
+  // Both are exact only when no thread is running
+  size_type size() const noexcept {
+    size_type size = bottom_.load(std::memory_order_relaxed) -
+                     top_.load(std::memory_order_relaxed);
+    return size < 0 ? 0 : size;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  size_type capacity() const noexcept {
+    return ring_.load(std::memory_order_relaxed)->cap;
+  }
+  //============================================================================
+
+  // Owner only, grows buffer up front to hold count elements
+  void reserve(size_type count) {
+    ring* current = ring_.load(std::memory_order_relaxed);
+    if (count > current->cap) {
+      grow(current, std::bit_ceil(static_cast<uint64_t>(count)));
+    }
+  }
+
+  // Owner only, amortized O(1)
+  void push(const T& value) {
+    size_type bottom = bottom_.load(std::memory_order_relaxed);
+    size_type top = top_.load(std::memory_order_acquire);
+    ring* current = ring_.load(std::memory_order_relaxed);
+    if (bottom - top >= current->cap) {
+      current = grow(current, current->cap * 2);
+    }
+    current->at(bottom).store(value, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only, takes the most recently pushed element, false if deque
+  //  is empty or a thief took the last element first
+  bool pop(T& out) noexcept {
+    size_type bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* current = ring_.load(std::memory_order_relaxed);
+    // Publishing reservation of bottom element before reading top orders
+    // owner against thieves, which read them the other way around
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    size_type top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    T value = current->at(bottom).load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // Last element, race thieves for it
+      bool won = top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      if (!won) {
+        return false;
+      }
+    }
+    out = value;
+    return true;
+  }
+
+  // Any thread, takes the least recently pushed element, false if deque
+  //  is empty or another thread took it first
+  bool steal(T& out) noexcept {
+    size_type top = top_.load(std::memory_order_seq_cst);
+    size_type bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return false;
+    }
+    ring* current = ring_.load(std::memory_order_acquire);
+    T value = current->at(top).load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    out = value;
+    return true;
+  }
+
+ private:
+  // Power of two buffer with the one it replaced
+  struct ring {
+    std::atomic<T>& at(size_type pos) noexcept {
+      return slots[pos & (cap - 1)];
+    }
+
+    std::atomic<T>* slots;
+    size_type cap;
+    ring* retired;
+  };
+
+  using al_traits = std::allocator_traits<Allocator>;
+  using ring_allocator = typename al_traits::template rebind_alloc<ring>;
+  using ring_traits = std::allocator_traits<ring_allocator>;
+  using slot_allocator =
+      typename al_traits::template rebind_alloc<std::atomic<T>>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  ring* make_ring(size_type capacity, ring* retired) {
+    slot_allocator slot_al(al_);
+    ring_allocator ring_al(al_);
+    std::atomic<T>* slots = slot_traits::allocate(slot_al, capacity);
+    ring* made = nullptr;
+    try {
+      made = ring_traits::allocate(ring_al, 1);
+    } catch (...) {
+      slot_traits::deallocate(slot_al, slots, capacity);
+      throw;
+    }
+    for (size_type i = 0; i < capacity; ++i) {
+      slot_traits::construct(slot_al, slots + i);
+    }
+    ring_traits::construct(ring_al, made, ring{slots, capacity, retired});
+    return made;
+  }
+
+  void free_ring(ring* old) noexcept {
+    slot_allocator slot_al(al_);
+    ring_allocator ring_al(al_);
+    for (size_type i = 0; i < old->cap; ++i) {
+      slot_traits::destroy(slot_al, old->slots + i);
+    }
+    slot_traits::deallocate(slot_al, old->slots, old->cap);
+    ring_traits::destroy(ring_al, old);
+    ring_traits::deallocate(ring_al, old, 1);
+  }
+
+  // Copies live elements to a bigger buffer and publishes it, old one
+  //  stays readable for thieves
+  ring* grow(ring* current, size_type capacity) {
+    ring* bigger = make_ring(capacity, current);
+    size_type bottom = bottom_.load(std::memory_order_relaxed);
+    size_type top = top_.load(std::memory_order_relaxed);
+    for (size_type pos = top; pos < bottom; ++pos) {
+      bigger->at(pos).store(current->at(pos).load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+    }
+    ring_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  // Thieves side
+  alignas(sp::kCacheLineSize) std::atomic<size_type> top_ = 0;
+
+  // Owner side
+  alignas(sp::kCacheLineSize) std::atomic<size_type> bottom_ = 0;
+  std::atomic<ring*> ring_ = nullptr;
+  [[no_unique_address]] Allocator al_;
+};
+}  // namespace sp
+
+#endif  // SP_CONTAINERS_WORK_STEALING_DEQUE_H_
@@ -1,12 +1,23 @@
 #include <gtest/gtest.h>
 #include <sp/array.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <random>
+#include <ranges>
 #include <sstream>
+#include <string>
 
 template <typename T, int64_t N>
 using TargetArray = sp::array<T, N>;
 
+static_assert(std::contiguous_iterator<TargetArray<int, 3>::iterator> &&
+                  std::contiguous_iterator<TargetArray<int, 3>::const_iterator>,
+              "Array iterators must be contiguous");
+static_assert(std::ranges::contiguous_range<TargetArray<int, 3>>,
+              "Array must be contiguous range");
+
 constexpr int constexpr_check(int val) {
   TargetArray<int, 7> arr1 = {1, 2, 3, 4, 5, 0, 0};
   TargetArray<int, 7> arr2 = {1, 2, 3, 4, 5, 6, 7};
@@ -191,6 +202,77 @@ TEST(ArrayTest, valid_constexpr_2) {
   ASSERT_EQ(cexper, -7);
 }
 
+TEST(ArrayTest, fill_bulk) {
+  TargetArray<float, 1000> floats;
+  floats.fill(0.0f);
+  ASSERT_TRUE(std::all_of(floats.begin(), floats.end(),
+                          [](float val) { return val == 0.0f; }));
+  floats.fill(1.5f);
+  ASSERT_TRUE(std::all_of(floats.begin(), floats.end(),
+                          [](float val) { return val == 1.5f; }));
+
+  struct pixel {
+    char r, g, b;
+  };
+  TargetArray<pixel, 33> pixels;
+  pixels.fill({1, 2, 3});
+  ASSERT_EQ(pixels[32].b, 3);
+  ASSERT_EQ(pixels[0].r, 1);
+}
+
+TEST(ArrayTest, swap_bulk) {
+  TargetArray<double, 517> arr1;
+  TargetArray<double, 517> arr2;
+  for (int i = 0; i < arr1.size(); ++i) {
+    arr1[i] = i;
+    arr2[i] = -i;
+  }
+  arr1.swap(arr2);
+  for (int i = 0; i < arr1.size(); ++i) {
+    ASSERT_EQ(arr1[i], -i);
+    ASSERT_EQ(arr2[i], i);
+  }
+
+  TargetArray<std::string, 3> strings1{"a", "b", "c"};
+  TargetArray<std::string, 3> strings2{"d", "e", "f"};
+  strings1.swap(strings2);
+  ASSERT_EQ(strings1[2], "f");
+  ASSERT_EQ(strings2[0], "a");
+}
+
+TEST(ArrayTest, swap_self) {
+  TargetArray<double, 517> arr;
+  for (int i = 0; i < arr.size(); ++i) {
+    arr[i] = i;
+  }
+  arr.swap(arr);
+  for (int i = 0; i < arr.size(); ++i) {
+    ASSERT_EQ(arr[i], i);
+  }
+}
+
+TEST(ArrayTest, equal_bulk) {
+  TargetArray<int, 300> ints1;
+  ints1.fill(7);
+  TargetArray<int, 300> ints2(ints1);
+  ASSERT_EQ(ints1, ints2);
+  ASSERT_EQ(ints1.mismatch(ints2), 300);
+  ints2[250] = 8;
+  ASSERT_NE(ints1, ints2);
+  ASSERT_EQ(ints1.mismatch(ints2), 250);
+
+  // floats compare by value, not by bytes
+  TargetArray<float, 100> floats1;
+  floats1.fill(0.0f);
+  TargetArray<float, 100> floats2;
+  floats2.fill(-0.0f);
+  ASSERT_EQ(floats1, floats2);
+  floats2[99] = std::nanf("");
+  floats1[99] = floats2[99];
+  ASSERT_FALSE(floats1 == floats2);
+  ASSERT_EQ(floats1.mismatch(floats2), 99);
+}
+
 TEST(ArrayTest, stream) {
   TargetArray<int, 7> arr{1, 2, 3, 4, 5, 6, 7};
   std::stringstream stream;
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/btree.h"
+#include "test_helpers.h"
+
+template <typename T, typename Al = std::allocator<T>>
+using TargetBtree =
+    sp::btree<T, T, sp::identity_key, std::less<T>, Al>;
+
+TEST(BtreeTest, empty) {
+  TargetBtree<int> tree;
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.size(), 0);
+  ASSERT_EQ(tree.begin(), tree.end());
+  ASSERT_EQ(tree.find(1), tree.end());
+  ASSERT_EQ(tree.lower_bound(1), tree.end());
+  ASSERT_EQ(tree.erase_key(1), 0);
+  ASSERT_TRUE(tree.integrity());
+}
+
+TEST(BtreeTest, node_size) {
+  using tree = TargetBtree<int>;
+  ASSERT_GE(tree::kSlots, 32);
+  ASSERT_LE(tree::kSlots * sizeof(int), std::size_t(tree::kNodeBytes));
+}
+
+TEST(BtreeTest, insert_ascending) {
+  TargetBtree<int> tree;
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(tree.insert_unique(i).second);
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_EQ(tree.size(), 10000);
+  int expected = 0;
+  for (int val : tree) {
+    ASSERT_EQ(val, expected++);
+  }
+}
+
+TEST(BtreeTest, insert_duplicate) {
+  TargetBtree<int> tree;
+  for (int i = 0; i < 100; ++i) {
+    tree.insert_unique(i);
+  }
+  auto first = tree.find(50);
+  auto second = tree.insert_unique(50);
+  ASSERT_FALSE(second.second);
+  ASSERT_EQ(first, second.first);
+  ASSERT_FALSE(tree.emplace_unique(50).second);
+  ASSERT_EQ(tree.size(), 100);
+}
+
+TEST(BtreeTest, iterate_backwards) {
+  TargetBtree<int> tree;
+  std::vector<int> expected;
+  for (int i = 999; i >= 0; --i) {
+    tree.insert_unique(i * 2);
+    expected.push_back(i * 2);
+  }
+  std::vector<int> values;
+  for (auto pos = tree.end(); pos != tree.begin();) {
+    values.push_back(*--pos);
+  }
+  ASSERT_EQ(values, expected);
+}
+
+TEST(BtreeTest, random_insert_erase) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> values(0, 3000);
+  TargetBtree<int> tree;
+  std::set<int> expected;
+  for (int i = 0; i < 50000; ++i) {
+    int val = values(gen);
+    if (gen() % 3) {
+      ASSERT_EQ(tree.insert_unique(val).second, expected.insert(val).second);
+    } else {
+      ASSERT_EQ(tree.erase_key(val), int64_t(expected.erase(val)));
+    }
+    if (i % 500 == 0) {
+      ASSERT_TRUE(tree.integrity());
+    }
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_EQ(tree.size(), int64_t(expected.size()));
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(BtreeTest, erase_returns_next) {
+  std::mt19937 gen(7);
+  TargetBtree<int> tree;
+  std::set<int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    tree.insert_unique(i);
+    expected.insert(i);
+  }
+  while (!expected.empty()) {
+    auto value = std::next(expected.begin(), gen() % expected.size());
+    auto next = tree.erase(tree.find(*value));
+    value = expected.erase(value);
+    if (value == expected.end()) {
+      ASSERT_EQ(next, tree.end());
+    } else {
+      ASSERT_EQ(*next, *value);
+    }
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_TRUE(tree.empty());
+}
+
+TEST(BtreeTest, erase_range) {
+  TargetBtree<int> tree;
+  for (int i = 0; i < 1000; ++i) {
+    tree.insert_unique(i);
+  }
+  auto pos = tree.erase(tree.find(100), tree.find(900));
+  ASSERT_EQ(*pos, 900);
+  ASSERT_EQ(tree.size(), 200);
+  ASSERT_TRUE(tree.integrity());
+  pos = tree.erase(tree.begin(), tree.end());
+  ASSERT_EQ(pos, tree.end());
+  ASSERT_TRUE(tree.empty());
+  ASSERT_TRUE(tree.integrity());
+}
+
+TEST(BtreeTest, bounds) {
+  TargetBtree<int> tree;
+  for (int i = 0; i < 1000; ++i) {
+    tree.insert_unique(i * 10);
+  }
+  for (int i = -5; i < 10005; i += 5) {
+    int lower = (std::max(i, 0) + 9) / 10 * 10;
+    int upper = (std::max(i + 1, 0) + 9) / 10 * 10;
+    auto lower_pos = tree.lower_bound(i);
+    auto upper_pos = tree.upper_bound(i);
+    if (lower >= 10000) {
+      ASSERT_EQ(lower_pos, tree.end());
+    } else {
+      ASSERT_EQ(*lower_pos, lower);
+    }
+    if (upper >= 10000) {
+      ASSERT_EQ(upper_pos, tree.end());
+    } else {
+      ASSERT_EQ(*upper_pos, upper);
+    }
+    ASSERT_EQ(tree.contains(i), i >= 0 && i < 10000 && i % 10 == 0);
+  }
+}
+
+TEST(BtreeTest, small_nodes) {
+  using big = std::array<int, 32>;
+  ASSERT_EQ(TargetBtree<big>::kSlots, 3);
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> values(0, 1000);
+  TargetBtree<big> tree;
+  std::set<big> expected;
+  for (int i = 0; i < 20000; ++i) {
+    big val{values(gen)};
+    if (gen() % 2) {
+      ASSERT_EQ(tree.insert_unique(val).second, expected.insert(val).second);
+    } else if (auto pos = tree.lower_bound(val); pos != tree.end()) {
+      auto next = tree.erase(pos);
+      auto expected_next = expected.erase(expected.lower_bound(val));
+      ASSERT_EQ(next == tree.end(), expected_next == expected.end());
+      if (next != tree.end()) {
+        ASSERT_EQ(*next, *expected_next);
+      }
+    }
+    if (i % 200 == 0) {
+      ASSERT_TRUE(tree.integrity());
+    }
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(BtreeTest, copy_move_swap) {
+  TargetBtree<safe> tree1;
+  for (int i = 0; i < 500; ++i) {
+    tree1.insert_unique(safe(std::to_string(i)));
+  }
+  TargetBtree<safe> tree2(tree1);
+  ASSERT_TRUE(tree2.integrity());
+  ASSERT_TRUE(std::equal(tree1.begin(), tree1.end(), tree2.begin(),
+                         tree2.end()));
+
+  TargetBtree<safe> tree3(std::move(tree1));
+  ASSERT_TRUE(tree1.empty());
+  ASSERT_TRUE(tree1.integrity());
+  ASSERT_EQ(tree3.size(), 500);
+  ASSERT_TRUE(tree3.integrity());
+
+  TargetBtree<safe> tree4;
+  tree4.swap(tree3);
+  ASSERT_TRUE(tree3.empty());
+  ASSERT_EQ(tree4.size(), 500);
+  ASSERT_TRUE(tree4.integrity());
+
+  tree1 = tree4;
+  tree3 = std::move(tree4);
+  ASSERT_EQ(tree1.size(), 500);
+  ASSERT_EQ(tree3.size(), 500);
+  ASSERT_TRUE(tree1.integrity());
+  ASSERT_TRUE(tree3.integrity());
+}
+
+TEST(BtreeTest, strings) {
+  std::mt19937 gen(3);
+  TargetBtree<std::string> tree;
+  std::set<std::string> expected;
+  for (int i = 0; i < 20000; ++i) {
+    std::string val(20, 'a' + gen() % 26);
+    val += std::to_string(gen() % 2000);
+    if (gen() % 4) {
+      ASSERT_EQ(tree.emplace_unique(val).second, expected.insert(val).second);
+    } else {
+      ASSERT_EQ(tree.erase_key(val), int64_t(expected.erase(val)));
+    }
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(BtreeTest, releases_nodes) {
+  alloc_record record;
+  {
+    recording_allocator<safe> al(&record);
+    TargetBtree<safe, recording_allocator<safe>> tree1(std::less<safe>(),
+                                                       al);
+    for (int i = 0; i < 2000; ++i) {
+      tree1.insert_unique(safe(std::to_string(i)));
+    }
+    for (int i = 0; i < 2000; i += 3) {
+      tree1.erase_key(safe(std::to_string(i)));
+    }
+    TargetBtree<safe, recording_allocator<safe>> tree2(tree1);
+    ASSERT_TRUE(tree2.integrity());
+  }
+  ASSERT_EQ(record.live, 0);
+}
+
+// copy constructor throws on every 100th call, move never throws
+struct copy_throwing {
+  explicit copy_throwing(int val) : value(val) {}
+  copy_throwing(const copy_throwing& other) : value(other.value) {
+    if (!(++count % 100)) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  copy_throwing(copy_throwing&& other) noexcept = default;
+
+  bool operator<(const copy_throwing& other) const {
+    return value < other.value;
+  }
+
+  int value;
+  static inline int count = 0;
+};
+
+TEST(BtreeTest, copy_throwing) {
+  alloc_record record;
+  recording_allocator<copy_throwing> al(&record);
+  using tree_type =
+      TargetBtree<copy_throwing, recording_allocator<copy_throwing>>;
+  tree_type tree1(std::less<copy_throwing>(), al);
+  for (int i = 0; i < 1000; ++i) {
+    tree1.emplace_unique(i);
+  }
+  int64_t live = record.live;
+  ASSERT_THROW(tree_type tree2(tree1), std::runtime_error);
+  ASSERT_EQ(record.live, live);
+  tree_type tree3(std::less<copy_throwing>(), al);
+  copy_throwing value(-1);
+  copy_throwing::count = 99;
+  ASSERT_THROW(tree3.insert_unique(value), std::runtime_error);
+  ASSERT_TRUE(tree3.empty());
+  ASSERT_TRUE(tree3.integrity());
+  ASSERT_EQ(record.live, live);
+}
+
+TEST(BtreeTest, split_alloc_throwing) {
+  alloc_record record;
+  recording_allocator<int> al(&record);
+  TargetBtree<int, recording_allocator<int>> tree(std::less<int>(), al);
+  // second allocation of an insert happens only when root is split
+  int value = 0;
+  for (;; ++value) {
+    record.fail_at = record.calls + 2;
+    int64_t live = record.live;
+    try {
+      tree.emplace_unique(value);
+    } catch (const std::bad_alloc&) {
+      ASSERT_EQ(record.live, live);
+      break;
+    }
+  }
+  ASSERT_EQ(tree.size(), value);
+  ASSERT_TRUE(tree.integrity());
+
+  record.fail_at = 0;
+  tree.emplace_unique(value);
+  ASSERT_EQ(tree.size(), value + 1);
+  ASSERT_TRUE(tree.integrity());
+}
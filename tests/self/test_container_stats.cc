@@ -0,0 +1,100 @@
+// Built as its own target with SP_CONTAINERS_STATS defined, see CMakeLists
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sp/container_stats.h"
+#include "sp/list.h"
+#include "sp/vector.h"
+
+namespace {
+struct sample {
+  int value;
+};
+
+struct named {
+  std::string name;
+};
+
+using SampleVector = sp::vector<sample>;
+using NamedVector = sp::vector<named>;
+using NamedList = sp::list<named>;
+}  // namespace
+
+static_assert(sp::kStatsEnabled, "Stats must be enabled by macro");
+
+TEST(ContainerStatsTest, vector_allocations) {
+  sp::container_stats& stats = sp::stats_of<SampleVector>();
+  stats.reset();
+  SampleVector vec;
+  vec.reserve(10);
+  ASSERT_EQ(stats.allocations, 1);
+  ASSERT_EQ(stats.allocated_bytes, 10 * sizeof(sample));
+  ASSERT_EQ(stats.reallocations, 0);
+
+  for (int i = 0; i < 11; ++i) {
+    vec.push_back({i});
+  }
+  ASSERT_EQ(stats.allocations, 2);
+  ASSERT_EQ(stats.allocated_bytes, 30 * sizeof(sample));
+  ASSERT_EQ(stats.reallocations, 1);
+  ASSERT_EQ(stats.wasted_bytes, 9 * sizeof(sample));
+  ASSERT_EQ(stats.moves, 10);
+  ASSERT_EQ(stats.copies, 0);
+
+  vec.shrink_to_fit();
+  ASSERT_EQ(stats.reallocations, 2);
+}
+
+TEST(ContainerStatsTest, vector_elements) {
+  sp::container_stats& stats = sp::stats_of<NamedVector>();
+  stats.reset();
+  {
+    NamedVector vec(int64_t(3), named{"copied"});
+    ASSERT_EQ(stats.copies, 3);
+    NamedVector copy(vec);
+    ASSERT_EQ(stats.copies, 6);
+    copy.reserve(10);
+    ASSERT_EQ(stats.moves, 3);
+    ASSERT_EQ(stats.destructions, 3);
+    copy.erase(copy.begin());
+    ASSERT_EQ(stats.destructions, 4);
+  }
+  ASSERT_EQ(stats.destructions, 9);
+}
+
+TEST(ContainerStatsTest, list_nodes) {
+  sp::container_stats& stats = sp::stats_of<NamedList>();
+  stats.reset();
+  NamedList list(int64_t(3), named{"node"});
+  list.push_back({"back"});
+  ASSERT_EQ(stats.node_allocations, 4);
+  list.pop_front();
+  ASSERT_EQ(stats.node_deallocations, 1);
+  list.clear();
+  ASSERT_EQ(stats.node_deallocations, 4);
+  ASSERT_EQ(stats.allocations, 0);
+}
+
+TEST(ContainerStatsTest, registry) {
+  SampleVector vec(int64_t(5));
+  NamedList list(int64_t(2));
+  auto entries = sp::stats_registry::instance().entries();
+  ASSERT_NE(std::find_if(entries.begin(), entries.end(),
+                         [](const auto& entry) {
+                           return entry.second ==
+                                  &sp::stats_of<SampleVector>();
+                         }),
+            entries.end());
+  ASSERT_NE(std::find_if(entries.begin(), entries.end(),
+                         [](const auto& entry) {
+                           return entry.second == &sp::stats_of<NamedList>();
+                         }),
+            entries.end());
+
+  sp::stats_registry::instance().reset();
+  ASSERT_EQ(sp::stats_of<SampleVector>().allocations, 0);
+  ASSERT_EQ(sp::stats_of<NamedList>().node_allocations, 0);
+}
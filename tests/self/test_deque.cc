@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/deque.h"
+#include "test_helpers.h"
+
+template <typename T>
+using TargetDeque = sp::deque<T>;
+
+TEST(DequeTest, ctor_default) {
+  TargetDeque<safe> deq;
+  ASSERT_TRUE(deq.empty());
+  ASSERT_EQ(deq.size(), 0);
+  ASSERT_EQ(deq.capacity(), 0);
+  ASSERT_EQ(deq.begin(), deq.end());
+}
+
+TEST(DequeTest, ctor_count_range) {
+  TargetDeque<safe> deq1(5);
+  ASSERT_EQ(deq1.size(), 5);
+  ASSERT_EQ(deq1.capacity(), 8);
+
+  TargetDeque<std::string> deq2(3, "abc");
+  ASSERT_EQ(deq2, TargetDeque<std::string>({"abc", "abc", "abc"}));
+
+  std::vector<int> from{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  TargetDeque<int> deq3(from.begin(), from.end());
+  ASSERT_EQ(deq3.size(), 9);
+  ASSERT_EQ(deq3.capacity(), 16);
+  ASSERT_TRUE(std::equal(deq3.begin(), deq3.end(), from.begin()));
+}
+
+TEST(DequeTest, ctor_copy_move) {
+  TargetDeque<std::string> deq1{"a", "b", "c"};
+  deq1.push_front("z");
+  TargetDeque<std::string> deq2(deq1);
+  ASSERT_EQ(deq1, deq2);
+
+  TargetDeque<std::string> deq3(std::move(deq1));
+  ASSERT_TRUE(deq1.empty());
+  ASSERT_EQ(deq3, deq2);
+
+  deq1 = deq3;
+  deq3 = std::move(deq2);
+  ASSERT_EQ(deq1, deq3);
+  deq1 = {"x"};
+  ASSERT_EQ(deq1.front(), "x");
+  ASSERT_EQ(deq1.size(), 1);
+}
+
+TEST(DequeTest, wraparound) {
+  TargetDeque<int> deq;
+  deq.reserve(8);
+  for (int i = 0; i < 100; ++i) {
+    deq.push_back(i);
+    if (deq.size() == 6) {
+      deq.pop_front();
+      deq.pop_front();
+    }
+  }
+  // never outgrows first buffer, although it wrapped many times
+  ASSERT_EQ(deq.capacity(), 8);
+  ASSERT_EQ(deq.front(), 96);
+  ASSERT_EQ(deq.back(), 99);
+  for (int i = 0; i < deq.size(); ++i) {
+    ASSERT_EQ(deq[i], 96 + i);
+  }
+}
+
+TEST(DequeTest, grow_both_ends) {
+  TargetDeque<std::string> deq;
+  std::deque<std::string> expected;
+  for (int i = 0; i < 50; ++i) {
+    if (i % 3) {
+      deq.push_front(std::to_string(i));
+      expected.push_front(std::to_string(i));
+    } else {
+      deq.emplace_back(std::to_string(i));
+      expected.emplace_back(std::to_string(i));
+    }
+  }
+  ASSERT_EQ(deq.capacity(), 64);
+  ASSERT_TRUE(std::equal(deq.begin(), deq.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(DequeTest, emplace_self_reference) {
+  TargetDeque<std::string> deq{"first", "second", "third", "fourth"};
+  deq.shrink_to_fit();
+  ASSERT_EQ(deq.capacity(), 4);
+  deq.emplace_back(deq.front());
+  deq.shrink_to_fit();
+  ASSERT_EQ(deq.capacity(), 8);
+  deq.push_back("6");
+  deq.push_back("7");
+  deq.push_back("8");
+  deq.emplace_front(deq.back());
+  ASSERT_EQ(deq.size(), 9);
+  ASSERT_EQ(deq.front(), "8");
+  ASSERT_EQ(deq[5], "first");
+}
+
+TEST(DequeTest, random_against_std) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> op(0, 3);
+  TargetDeque<int> deq;
+  std::deque<int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    switch (op(gen)) {
+      case 0:
+        deq.push_back(i);
+        expected.push_back(i);
+        break;
+      case 1:
+        deq.push_front(i);
+        expected.push_front(i);
+        break;
+      case 2:
+        if (!expected.empty()) {
+          deq.pop_back();
+          expected.pop_back();
+        }
+        break;
+      default:
+        if (!expected.empty()) {
+          deq.pop_front();
+          expected.pop_front();
+        }
+    }
+    ASSERT_EQ(deq.size(), static_cast<int64_t>(expected.size()));
+  }
+  ASSERT_TRUE(std::equal(deq.begin(), deq.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(DequeTest, throwing_growth) {
+  TargetDeque<throwing> deq;
+  TargetDeque<throwing> copy;
+  deq.reserve(16);
+  copy.reserve(16);
+  for (int i = 0; i < 19; ++i) {
+    deq.emplace_back(std::to_string(i));
+    copy.emplace_back(std::to_string(i));
+    if (i % 8 == 0) {
+      deq.pop_front();
+      copy.pop_front();
+    }
+  }
+  // elements are copied as their move may throw, every fifth copy fails
+  throwing::count = 0;
+  ASSERT_THROW(deq.emplace_front("front"), std::runtime_error);
+  ASSERT_EQ(deq, copy);
+  ASSERT_EQ(deq.capacity(), 16);
+  throwing::count = 0;
+  ASSERT_THROW(deq.emplace_back(deq.front()), std::runtime_error);
+  ASSERT_EQ(deq, copy);
+}
+
+TEST(DequeTest, relocatable) {
+  TargetDeque<relocatable> deq;
+  for (int i = 0; i < 20; ++i) {
+    deq.emplace_front(i);
+    deq.emplace_back(-i);
+  }
+  ASSERT_EQ(deq.size(), 40);
+  ASSERT_EQ(deq.front(), relocatable(19));
+  ASSERT_EQ(deq.back(), relocatable(-19));
+  deq.shrink_to_fit();
+  ASSERT_EQ(deq.capacity(), 64);
+  deq.resize(10);
+  deq.shrink_to_fit();
+  ASSERT_EQ(deq.capacity(), 16);
+  ASSERT_EQ(deq[9], relocatable(10));
+}
+
+TEST(DequeTest, iterators) {
+  TargetDeque<int> deq;
+  for (int i = 0; i < 6; ++i) {
+    deq.push_front(i);
+  }
+  deq.push_back(-1);
+  TargetDeque<int>::const_iterator first = deq.begin();
+  ASSERT_EQ(deq.end() - first, 7);
+  ASSERT_EQ(first[2], 3);
+  ASSERT_EQ(*(first + 6), -1);
+  ASSERT_TRUE(first < deq.cend());
+  std::sort(deq.begin(), deq.end());
+  ASSERT_TRUE(std::is_sorted(deq.cbegin(), deq.cend()));
+  ASSERT_EQ(deq.front(), -1);
+}
+
+TEST(DequeTest, access) {
+  const TargetDeque<int> deq{1, 2, 3};
+  ASSERT_EQ(deq.at(2), 3);
+  ASSERT_THROW(deq.at(3), std::out_of_range);
+  ASSERT_THROW(deq.at(-1), std::out_of_range);
+}
+
+TEST(DequeTest, clear_swap) {
+  TargetDeque<safe> deq1(4);
+  TargetDeque<safe> deq2;
+  deq1.swap(deq2);
+  ASSERT_TRUE(deq1.empty());
+  ASSERT_EQ(deq2.size(), 4);
+  deq2.clear();
+  ASSERT_TRUE(deq2.empty());
+  ASSERT_EQ(deq2.capacity(), 4);
+  deq2.push_front(safe("a"));
+  ASSERT_EQ(deq2.back(), safe("a"));
+}
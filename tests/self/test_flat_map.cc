@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/flat_map.h"
+#include "test_helpers.h"
+
+template <typename K, typename T, typename Compare = std::less<K>>
+using TargetMap = sp::flat_map<K, T, Compare>;
+
+TEST(FlatMapTest, ctor_default) {
+  TargetMap<int, safe> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.size(), 0);
+  ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatMapTest, ctor_init_list) {
+  TargetMap<int, std::string> map{{3, "three"}, {1, "one"}, {2, "two"},
+                                  {1, "uno"}};
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_EQ(map.begin()->second, "one");
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_TRUE(map.integrity());
+}
+
+TEST(FlatMapTest, ctor_containers) {
+  sp::vector<int> keys{1, 2, 3};
+  sp::vector<std::string> values{"one", "two", "three"};
+  const int* data = keys.data();
+  TargetMap<int, std::string> map1(std::move(keys), std::move(values));
+  ASSERT_EQ(map1.keys().data(), data);
+  ASSERT_EQ(map1.at(2), "two");
+
+  TargetMap<int, std::string> map2(sp::vector<int>{3, 1, 3},
+                                   sp::vector<std::string>{"c", "a", "x"});
+  ASSERT_EQ(map2.size(), 2);
+  ASSERT_EQ(map2.at(3), "c");
+  ASSERT_TRUE(map2.integrity());
+
+  auto parts = std::move(map2).extract();
+  ASSERT_EQ(parts.keys.size(), 2);
+  ASSERT_EQ(parts.values[0], "a");
+  ASSERT_TRUE(map2.empty());
+
+  sp::vector<int> longer{1, 2};
+  sp::vector<int> shorter{1};
+  ASSERT_THROW((TargetMap<int, int>(longer, shorter)), std::invalid_argument);
+}
+
+TEST(FlatMapTest, ctor_copy_move) {
+  TargetMap<std::string, safe> map1{{"a", safe("1")}, {"b", safe("2")}};
+  TargetMap<std::string, safe> map2(map1);
+  ASSERT_EQ(map1, map2);
+
+  TargetMap<std::string, safe> map3(std::move(map1));
+  ASSERT_TRUE(map1.empty());
+  ASSERT_EQ(map3, map2);
+
+  map1 = map3;
+  map3 = std::move(map2);
+  ASSERT_EQ(map1, map3);
+  ASSERT_TRUE(map1.integrity());
+}
+
+TEST(FlatMapTest, at) {
+  TargetMap<int, int> map{{1, 10}};
+  ASSERT_EQ(map.at(1), 10);
+  ASSERT_THROW(map.at(2), std::out_of_range);
+  const auto& cmap = map;
+  ASSERT_THROW(cmap.at(2), std::out_of_range);
+}
+
+TEST(FlatMapTest, subscript) {
+  TargetMap<std::string, int> map;
+  map["one"] = 1;
+  ++map["one"];
+  map["zero"];
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map["one"], 2);
+  ASSERT_EQ(map.at("zero"), 0);
+}
+
+TEST(FlatMapTest, insert) {
+  TargetMap<int, std::string> map;
+  auto result = map.insert({1, "one"});
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(result.first->second, "one");
+
+  result = map.insert({1, "uno"});
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, "one");
+
+  result = map.insert_or_assign(1, "uno");
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(map.at(1), "uno");
+}
+
+TEST(FlatMapTest, insert_range_merges) {
+  TargetMap<int, std::string> map{{2, "two"}, {4, "four"}};
+  std::vector<std::pair<int, std::string>> from{
+      {5, "five"}, {1, "one"}, {4, "vier"}, {1, "uno"}, {3, "three"}};
+  map.insert(from.begin(), from.end());
+  ASSERT_EQ(map.size(), 5);
+  ASSERT_EQ(map.at(1), "one");
+  ASSERT_EQ(map.at(4), "four");
+  ASSERT_TRUE(std::is_sorted(map.keys().begin(), map.keys().end()));
+  ASSERT_TRUE(map.integrity());
+
+  TargetMap<int, std::string> copy(map.begin(), map.end());
+  ASSERT_EQ(copy, map);
+}
+
+TEST(FlatMapTest, try_emplace_keeps_argument) {
+  TargetMap<int, std::string> map{{1, "one"}};
+  std::string value("moved");
+  ASSERT_FALSE(map.try_emplace(1, std::move(value)).second);
+  ASSERT_EQ(value, "moved");
+  ASSERT_TRUE(map.try_emplace(2, std::move(value)).second);
+  ASSERT_EQ(map.at(2), "moved");
+}
+
+TEST(FlatMapTest, emplace_throwing) {
+  TargetMap<int, throwing> map;
+  throwing value("value");
+  for (int i = 0; i < 20; ++i) {
+    throwing::count = 0;
+    try {
+      map.try_emplace(i, value);
+    } catch (...) {
+    }
+    ASSERT_TRUE(map.integrity());
+  }
+  ASSERT_GT(map.size(), 0);
+}
+
+// Copy and move may throw, only the countdown-th one after reset does
+class throwing_once {
+ public:
+  explicit throwing_once(const std::string& name) : id_(name) {}
+  throwing_once(const throwing_once& other) : id_(other.id_) { tick(); }
+  throwing_once(throwing_once&& other) : id_(std::move(other.id_)) {
+    tick();
+  }
+  throwing_once& operator=(const throwing_once&) = default;
+  throwing_once& operator=(throwing_once&&) = default;
+
+  bool operator==(const throwing_once& other) const {
+    return id_ == other.id_;
+  }
+
+  static int countdown;
+
+ private:
+  static void tick() {
+    if (--countdown == 0) {
+      throw std::runtime_error("Countdown reached");
+    }
+  }
+
+  std::string id_;
+};
+inline int throwing_once::countdown = 0;
+
+TEST(FlatMapTest, insert_range_throwing) {
+  TargetMap<std::string, throwing_once> original;
+  for (char key : {'b', 'd', 'f'}) {
+    original.try_emplace(std::string(32, key), std::string(1, key));
+  }
+  std::vector<std::pair<std::string, throwing_once>> from;
+  for (char key : {'a', 'c', 'e'}) {
+    from.emplace_back(std::string(32, key),
+                      throwing_once(std::string(1, key)));
+  }
+  int thrown = 0;
+  // Throws on operation number start, which walks through all the stages
+  for (int start = 1; start < 40; ++start) {
+    throwing_once::countdown = 0;
+    TargetMap<std::string, throwing_once> map(original);
+    throwing_once::countdown = start;
+    try {
+      map.insert(from.begin(), from.end());
+      ASSERT_EQ(map.size(), 6);
+    } catch (...) {
+      ++thrown;
+      ASSERT_EQ(map.keys(), original.keys());
+      ASSERT_EQ(map.values(), original.values());
+    }
+    ASSERT_TRUE(map.integrity());
+  }
+  ASSERT_GT(thrown, 0);
+}
+
+TEST(FlatMapTest, erase) {
+  TargetMap<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  ASSERT_EQ(map.erase(50), 1);
+  ASSERT_EQ(map.erase(50), 0);
+  auto pos = map.erase(map.find(10));
+  ASSERT_EQ(pos->first, 11);
+  map.erase(map.lower_bound(60), map.end());
+  ASSERT_EQ(map.size(), 58);
+  ASSERT_TRUE(map.integrity());
+}
+
+TEST(FlatMapTest, iterator) {
+  TargetMap<int, int> map{{1, 10}, {2, 20}, {3, 30}};
+  for (auto [key, value] : map) {
+    value += key;
+  }
+  ASSERT_EQ(map.at(2), 22);
+  auto pos = map.end() - 1;
+  ASSERT_EQ((*pos).first, 3);
+  ASSERT_EQ(pos[-2].second, 11);
+  ASSERT_EQ(map.end() - map.begin(), 3);
+  TargetMap<int, int>::const_iterator cpos = pos;
+  ASSERT_EQ(cpos, pos);
+  ASSERT_LT(map.cbegin(), cpos);
+}
+
+TEST(FlatMapTest, lookup) {
+  TargetMap<int, int> map{{10, 1}, {20, 2}, {30, 3}};
+  ASSERT_EQ(map.count(20), 1);
+  ASSERT_EQ(map.count(25), 0);
+  ASSERT_TRUE(map.contains(30));
+  ASSERT_EQ(map.find(25), map.end());
+  ASSERT_EQ(map.lower_bound(15)->first, 20);
+  ASSERT_EQ(map.upper_bound(20)->first, 30);
+  auto range = map.equal_range(20);
+  ASSERT_EQ(range.first->first, 20);
+  ASSERT_EQ(range.second->first, 30);
+}
+
+TEST(FlatMapTest, heterogeneous_lookup) {
+  TargetMap<std::string, int, std::less<>> map{{"alpha", 1}, {"beta", 2}};
+  std::string_view key("beta");
+  ASSERT_EQ(map.find(key)->second, 2);
+  ASSERT_TRUE(map.contains("alpha"));
+  ASSERT_EQ(map.count(std::string_view("gamma")), 0);
+  ASSERT_EQ(map.lower_bound(std::string_view("b"))->first, "beta");
+  ASSERT_EQ(map.erase(key), 1);
+  ASSERT_EQ(map.size(), 1);
+}
+
+TEST(FlatMapTest, matches_std) {
+  TargetMap<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 503;
+    if (i % 4 == 3) {
+      ASSERT_EQ(map.erase(key), int64_t(expected.erase(key)));
+    } else {
+      map[key] += i;
+      expected[key] += i;
+    }
+  }
+  ASSERT_TRUE(map.integrity());
+  ASSERT_EQ(map.size(), int64_t(expected.size()));
+  auto pos = expected.begin();
+  for (const auto& [key, value] : map) {
+    ASSERT_EQ(key, pos->first);
+    ASSERT_EQ(value, pos->second);
+    ++pos;
+  }
+}
+
+TEST(FlatMapTest, swap) {
+  TargetMap<int, int> map1{{1, 1}};
+  TargetMap<int, int> map2{{2, 2}, {3, 3}};
+  map1.swap(map2);
+  ASSERT_EQ(map1.size(), 2);
+  ASSERT_EQ(map2.begin()->first, 1);
+  ASSERT_TRUE(map1.integrity());
+  ASSERT_TRUE(map2.integrity());
+}
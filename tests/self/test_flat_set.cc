@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/branchless_search.h"
+#include "sp/flat_set.h"
+#include "test_helpers.h"
+
+template <typename K, typename Compare = std::less<K>>
+using TargetSet = sp::flat_set<K, Compare>;
+
+TEST(FlatSetTest, ctor_default) {
+  TargetSet<safe> set;
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.size(), 0);
+  ASSERT_EQ(set.begin(), set.end());
+}
+
+TEST(FlatSetTest, ctor_range) {
+  std::vector<int> from{5, 3, 5, 1, 3};
+  TargetSet<int> set(from.begin(), from.end());
+  ASSERT_EQ(set.size(), 3);
+  ASSERT_EQ(*set.begin(), 1);
+  ASSERT_TRUE(set.integrity());
+}
+
+TEST(FlatSetTest, ctor_container) {
+  sp::vector<int> sorted{1, 2, 3, 4};
+  const int* data = sorted.data();
+  TargetSet<int> set1(std::move(sorted));
+  ASSERT_EQ(set1.keys().data(), data);
+  ASSERT_EQ(set1.size(), 4);
+
+  TargetSet<int> set2(sp::vector<int>{4, 2, 4, 1});
+  ASSERT_EQ(set2, TargetSet<int>({1, 2, 4}));
+  ASSERT_TRUE(set2.integrity());
+
+  sp::vector<int> keys = std::move(set2).extract();
+  ASSERT_EQ(keys.size(), 3);
+  ASSERT_TRUE(set2.empty());
+}
+
+TEST(FlatSetTest, ctor_copy_move) {
+  TargetSet<std::string> set1{"a", "b", "c"};
+  TargetSet<std::string> set2(set1);
+  ASSERT_EQ(set1, set2);
+
+  TargetSet<std::string> set3(std::move(set1));
+  ASSERT_TRUE(set1.empty());
+  ASSERT_EQ(set3, set2);
+
+  set1 = set3;
+  set3 = std::move(set2);
+  ASSERT_EQ(set1, set3);
+}
+
+TEST(FlatSetTest, insert) {
+  TargetSet<safe> set;
+  ASSERT_TRUE(set.insert(safe("one")).second);
+  auto result = set.insert(safe("one"));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, safe("one"));
+  ASSERT_TRUE(set.emplace("two").second);
+  ASSERT_EQ(set.size(), 2);
+}
+
+TEST(FlatSetTest, insert_range_merges) {
+  TargetSet<std::string> set{"b", "d", "f"};
+  std::vector<std::string> from{"g", "a", "d", "c", "a", "b"};
+  set.insert(from.begin(), from.end());
+  ASSERT_EQ(set, TargetSet<std::string>({"a", "b", "c", "d", "f", "g"}));
+  ASSERT_TRUE(set.integrity());
+  set.insert({});
+  ASSERT_EQ(set.size(), 6);
+}
+
+TEST(FlatSetTest, insert_range_keeps_first) {
+  // compares only by length, so equivalent keys are distinguishable
+  auto shorter = [](const std::string& lhs, const std::string& rhs) {
+    return lhs.size() < rhs.size();
+  };
+  sp::flat_set<std::string, decltype(shorter)> set({"bb"}, shorter);
+  std::vector<std::string> from{"a", "cc", "b", "ddd", "eee"};
+  set.insert(from.begin(), from.end());
+  ASSERT_EQ(set.size(), 3);
+  auto pos = set.begin();
+  ASSERT_EQ(*pos++, "a");
+  ASSERT_EQ(*pos++, "bb");
+  ASSERT_EQ(*pos++, "ddd");
+}
+
+TEST(FlatSetTest, insert_range_throwing) {
+  TargetSet<throwing> set;
+  throwing::count = 0;
+  set.emplace("0");
+  set.emplace("1");
+  std::vector<throwing> from;
+  from.reserve(10);
+  for (int i = 2; i < 10; ++i) {
+    from.emplace_back(std::to_string(i));
+  }
+  throwing::count = 0;
+  TargetSet<throwing> copy(set);
+  throwing::count = 0;
+  ASSERT_ANY_THROW(set.insert(from.begin(), from.end()));
+  ASSERT_EQ(set, copy);
+}
+
+TEST(FlatSetTest, erase) {
+  TargetSet<int> set{1, 2, 3, 4, 5};
+  ASSERT_EQ(set.erase(3), 1);
+  ASSERT_EQ(set.erase(3), 0);
+  ASSERT_EQ(*set.erase(set.begin()), 2);
+  set.erase(set.find(4), set.end());
+  ASSERT_EQ(set, TargetSet<int>({2}));
+  ASSERT_TRUE(set.integrity());
+}
+
+TEST(FlatSetTest, lookup) {
+  TargetSet<int> set{10, 20, 30};
+  ASSERT_EQ(set.count(20), 1);
+  ASSERT_FALSE(set.contains(25));
+  ASSERT_EQ(*set.lower_bound(15), 20);
+  ASSERT_EQ(*set.upper_bound(20), 30);
+  ASSERT_EQ(set.find(40), set.end());
+  auto range = set.equal_range(20);
+  ASSERT_EQ(range.second - range.first, 1);
+}
+
+TEST(FlatSetTest, heterogeneous_lookup) {
+  TargetSet<std::string, std::less<>> set{"alpha", "beta"};
+  ASSERT_TRUE(set.contains(std::string_view("beta")));
+  ASSERT_EQ(*set.find("alpha"), "alpha");
+  ASSERT_EQ(set.erase(std::string_view("alpha")), 1);
+  ASSERT_EQ(set.size(), 1);
+}
+
+TEST(FlatSetTest, branchless_bounds) {
+  std::mt19937 gen(42);
+  for (int size = 0; size < 70; ++size) {
+    std::vector<int> keys(size);
+    for (auto& key : keys) {
+      key = int(gen() % 40);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (int key = -1; key <= 41; ++key) {
+      ASSERT_EQ(sp::branchless_lower_bound(keys.begin(), keys.end(), key,
+                                           std::less<int>()),
+                std::lower_bound(keys.begin(), keys.end(), key));
+      ASSERT_EQ(sp::branchless_upper_bound(keys.begin(), keys.end(), key,
+                                           std::less<int>()),
+                std::upper_bound(keys.begin(), keys.end(), key));
+    }
+  }
+}
+
+TEST(FlatSetTest, matches_std) {
+  TargetSet<int> set;
+  std::set<int> expected;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 701;
+    if (i % 3 == 2) {
+      ASSERT_EQ(set.erase(key), int64_t(expected.erase(key)));
+    } else {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ASSERT_TRUE(set.integrity());
+  ASSERT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+}
@@ -0,0 +1,228 @@
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/hash_table.h"
+#include "test_helpers.h"
+
+template <typename T, typename Hash = std::hash<T>,
+          typename Al = std::allocator<T>>
+using TargetTable = sp::hash_table<T, T, sp::identity_key, Hash,
+                                   std::equal_to<T>, Al>;
+
+// sends every key to the same probe sequence and control tag
+struct constant_hash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+TEST(HashTableTest, empty) {
+  TargetTable<int> table;
+  ASSERT_TRUE(table.empty());
+  ASSERT_EQ(table.size(), 0);
+  ASSERT_EQ(table.capacity(), 0);
+  ASSERT_EQ(table.begin(), table.end());
+  ASSERT_EQ(table.find(1), table.end());
+  ASSERT_EQ(table.erase_key(1), 0);
+  ASSERT_TRUE(table.integrity());
+}
+
+TEST(HashTableTest, group_width) {
+  int width = TargetTable<int>::kWidth;
+  ASSERT_TRUE(width == 8 || width == 16 || width == 32);
+}
+
+TEST(HashTableTest, insert_many) {
+  TargetTable<int> table;
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(table.insert_unique(i).second);
+  }
+  ASSERT_TRUE(table.integrity());
+  ASSERT_EQ(table.size(), 10000);
+  ASSERT_LE(table.size() * 8, table.capacity() * 7);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(*table.find(i), i);
+  }
+  ASSERT_FALSE(table.contains(10000));
+  int64_t count = 0;
+  for (auto pos = table.begin(); pos != table.end(); ++pos) {
+    ++count;
+  }
+  ASSERT_EQ(count, 10000);
+}
+
+TEST(HashTableTest, insert_duplicate) {
+  TargetTable<int> table;
+  for (int i = 0; i < 100; ++i) {
+    table.insert_unique(i);
+  }
+  auto first = table.find(50);
+  auto second = table.insert_unique(50);
+  ASSERT_FALSE(second.second);
+  ASSERT_EQ(first, second.first);
+  ASSERT_FALSE(table.emplace_unique(50).second);
+  ASSERT_EQ(table.size(), 100);
+}
+
+TEST(HashTableTest, random_insert_erase) {
+  std::mt19937 gen(7);
+  TargetTable<int> table;
+  std::set<int> expected;
+  for (int i = 0; i < 50000; ++i) {
+    int val = gen() % 3000;
+    if (gen() % 3) {
+      ASSERT_EQ(table.insert_unique(val).second, expected.insert(val).second);
+    } else {
+      ASSERT_EQ(table.erase_key(val), int64_t(expected.erase(val)));
+    }
+    if (i % 5000 == 0) {
+      ASSERT_TRUE(table.integrity());
+    }
+  }
+  ASSERT_TRUE(table.integrity());
+  ASSERT_EQ(table.size(), int64_t(expected.size()));
+  for (int val : table) {
+    ASSERT_TRUE(expected.count(val));
+  }
+}
+
+TEST(HashTableTest, erase_while_iterating) {
+  TargetTable<int> table;
+  for (int i = 0; i < 1000; ++i) {
+    table.insert_unique(i);
+  }
+  int visited = 0;
+  for (auto pos = table.begin(); pos != table.end(); ++visited) {
+    pos = *pos % 2 ? table.erase(pos) : std::next(pos);
+  }
+  ASSERT_EQ(visited, 1000);
+  ASSERT_EQ(table.size(), 500);
+  ASSERT_TRUE(table.integrity());
+  ASSERT_EQ(table.erase(table.begin(), table.end()), table.end());
+  ASSERT_TRUE(table.empty());
+  ASSERT_TRUE(table.integrity());
+}
+
+TEST(HashTableTest, churn_keeps_capacity) {
+  TargetTable<int> table;
+  for (int i = 0; i < 100; ++i) {
+    table.insert_unique(i);
+  }
+  int64_t capacity = table.capacity();
+  for (int i = 100; i < 100000; ++i) {
+    table.erase_key(i - 100);
+    table.insert_unique(i);
+  }
+  ASSERT_EQ(table.size(), 100);
+  ASSERT_LE(table.capacity(), capacity * 2 + 1);
+  ASSERT_TRUE(table.integrity());
+}
+
+TEST(HashTableTest, colliding_hash) {
+  TargetTable<int, constant_hash> table;
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_TRUE(table.insert_unique(i).second);
+  }
+  for (int i = 0; i < 300; i += 2) {
+    ASSERT_EQ(table.erase_key(i), 1);
+  }
+  ASSERT_TRUE(table.integrity());
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_EQ(table.contains(i), i % 2 == 1);
+  }
+}
+
+TEST(HashTableTest, reserve_rehash) {
+  TargetTable<int> table;
+  table.reserve(1000);
+  int64_t capacity = table.capacity();
+  ASSERT_GE(capacity * 7, 1000 * 8 - 8);
+  for (int i = 0; i < 1000; ++i) {
+    table.insert_unique(i);
+  }
+  ASSERT_EQ(table.capacity(), capacity);
+  for (int i = 0; i < 990; ++i) {
+    table.erase_key(i);
+  }
+  table.rehash(0);
+  ASSERT_LT(table.capacity(), 32);
+  ASSERT_EQ(table.size(), 10);
+  ASSERT_TRUE(table.integrity());
+  table.clear();
+  table.rehash(0);
+  ASSERT_EQ(table.capacity(), 0);
+  ASSERT_TRUE(table.integrity());
+}
+
+TEST(HashTableTest, copy_move_swap) {
+  TargetTable<std::string> table1;
+  for (int i = 0; i < 500; ++i) {
+    table1.insert_unique(std::to_string(i));
+  }
+  TargetTable<std::string> table2(table1);
+  ASSERT_TRUE(table2.integrity());
+  for (const auto& val : table1) {
+    ASSERT_TRUE(table2.contains(val));
+  }
+
+  TargetTable<std::string> table3(std::move(table1));
+  ASSERT_TRUE(table1.empty());
+  ASSERT_TRUE(table1.integrity());
+  ASSERT_EQ(table3.size(), 500);
+  ASSERT_TRUE(table3.integrity());
+
+  TargetTable<std::string> table4;
+  table4.swap(table3);
+  ASSERT_TRUE(table3.empty());
+  ASSERT_EQ(table4.size(), 500);
+  ASSERT_TRUE(table4.integrity());
+
+  table1 = table4;
+  table3 = std::move(table4);
+  ASSERT_EQ(table1.size(), 500);
+  ASSERT_EQ(table3.size(), 500);
+  ASSERT_TRUE(table1.integrity());
+  ASSERT_TRUE(table3.integrity());
+}
+
+TEST(HashTableTest, strings) {
+  std::mt19937 gen(3);
+  TargetTable<std::string> table;
+  std::set<std::string> expected;
+  for (int i = 0; i < 20000; ++i) {
+    std::string val(20, 'a' + gen() % 26);
+    val += std::to_string(gen() % 2000);
+    if (gen() % 4) {
+      ASSERT_EQ(table.emplace_unique(val).second,
+                expected.insert(val).second);
+    } else {
+      ASSERT_EQ(table.erase_key(val), int64_t(expected.erase(val)));
+    }
+  }
+  ASSERT_TRUE(table.integrity());
+  ASSERT_EQ(table.size(), int64_t(expected.size()));
+}
+
+TEST(HashTableTest, releases_memory) {
+  alloc_record record;
+  {
+    recording_allocator<std::string> al(&record);
+    TargetTable<std::string, std::hash<std::string>,
+                recording_allocator<std::string>>
+        table1(0, std::hash<std::string>(), std::equal_to<std::string>(), al);
+    for (int i = 0; i < 2000; ++i) {
+      table1.insert_unique(std::to_string(i));
+    }
+    for (int i = 0; i < 2000; i += 3) {
+      table1.erase_key(std::to_string(i));
+    }
+    auto table2(table1);
+    ASSERT_TRUE(table2.integrity());
+    table1.clear();
+    ASSERT_TRUE(table1.integrity());
+  }
+  ASSERT_EQ(record.live, 0);
+}
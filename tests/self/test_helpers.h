@@ -1,10 +1,14 @@
 #ifndef SP_TESTS_TEST_HELPERS_H_
 #define SP_TESTS_TEST_HELPERS_H_
 
+#include <cstdint>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <string>
 
+#include <sp/type_traits.h>
+
 enum class constructed { kDef, kParam, kCopy, kMove };
 
 class safe {
@@ -31,6 +35,7 @@ class safe {
 
   bool operator==(const safe& other) const { return other.id_ == id_; }
   bool operator!=(const safe& other) const { return other.id_ != id_; }
+  bool operator<(const safe& other) const { return id_ < other.id_; }
 
   friend std::ostream& operator<<(std::ostream& os, const safe& obj) {
     os << obj.id_;
@@ -100,7 +105,29 @@ class throwing : public safe {
 
   static int count;
 };
-int throwing::count = 0;
+inline int throwing::count = 0;
+
+// not_safe dummy, opts in basic exception guarantee
+class basic_not_safe : public not_safe {
+ public:
+  basic_not_safe() : not_safe() {}
+  explicit basic_not_safe(const std::string& name) : not_safe(name) {}
+};
+
+template <>
+struct sp::exception_guarantee<basic_not_safe>
+    : std::integral_constant<sp::guarantee, sp::guarantee::kBasic> {};
+
+// exception throwing dummy, opts in basic exception guarantee
+class basic_throwing : public throwing {
+ public:
+  basic_throwing() : throwing() {}
+  explicit basic_throwing(const std::string& name) : throwing(name) {}
+};
+
+template <>
+struct sp::exception_guarantee<basic_throwing>
+    : std::integral_constant<sp::guarantee, sp::guarantee::kBasic> {};
 
 // - DefaultConstructible dummy
 class no_def : public safe {
@@ -113,6 +140,104 @@ class no_def : public safe {
   virtual ~no_def() = default;
 };
 
+// trivially relocatable dummy, holds resource only by std::unique_ptr
+class relocatable {
+ public:
+  relocatable() : birth(constructed::kDef), value_(new int()) {}
+  explicit relocatable(int value)
+      : birth(constructed::kParam), value_(new int(value)) {}
+  relocatable(relocatable&& other) noexcept
+      : birth(constructed::kMove), value_(std::move(other.value_)) {}
+  relocatable& operator=(relocatable&& other) noexcept {
+    value_ = std::move(other.value_);
+    return *this;
+  }
+  ~relocatable() = default;
+
+  bool operator==(const relocatable& other) const {
+    return *other.value_ == *value_;
+  }
+  bool operator!=(const relocatable& other) const {
+    return *other.value_ != *value_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const relocatable& obj) {
+    os << *obj.value_;
+    return os;
+  }
+  const constructed birth;
+
+ private:
+  std::unique_ptr<int> value_;
+};
+
+template <>
+struct sp::is_trivially_relocatable<relocatable> : std::true_type {};
+
+// allocator rounding every request up to multiple of 8 elements and
+// reporting it through allocate_at_least
+template <typename T>
+class rounding_allocator {
+ public:
+  using value_type = T;
+
+  struct allocation_result {
+    T* ptr;
+    std::size_t count;
+  };
+
+  rounding_allocator() = default;
+  template <typename U>
+  rounding_allocator(const rounding_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) { return allocate_at_least(n).ptr; }
+  allocation_result allocate_at_least(std::size_t n) {
+    n = (n + 7) / 8 * 8;
+    return {std::allocator<T>().allocate(n), n};
+  }
+  void deallocate(T* ptr, std::size_t n) {
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  bool operator==(const rounding_allocator&) const noexcept { return true; }
+};
+
+// allocator recording requests it served, call number fail_at throws
+struct alloc_record {
+  std::size_t obj_size = 0;
+  int64_t calls = 0;
+  int64_t live = 0;
+  int64_t fail_at = 0;
+};
+
+template <typename T>
+class recording_allocator {
+ public:
+  using value_type = T;
+
+  recording_allocator(alloc_record* record) noexcept : record_(record) {}
+  template <typename U>
+  recording_allocator(const recording_allocator<U>& other) noexcept
+      : record_(other.record_) {}
+
+  T* allocate(std::size_t n) {
+    record_->obj_size = sizeof(T);
+    if (++record_->calls == record_->fail_at) {
+      throw std::bad_alloc();
+    }
+    ++record_->live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* ptr, std::size_t n) {
+    --record_->live;
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  bool operator==(const recording_allocator&) const noexcept { return true; }
+
+  alloc_record* record_;
+};
+
 // // + safe assignment operators
 // class safe_assign : public safe {
 //  public:
@@ -1,29 +1,42 @@
+#include <algorithm>
 #include <list>
+#include <iterator>
 #include <random>
+#include <ranges>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 #include <sp/pool_allocator.h>
 #include <sp/reserving_allocator.h>
 
 #include "gtest/gtest.h"
-// #include "sp/list.h"
+#include "sp/list.h"
 #include "test_helpers.h"
 
-template <typename T, typename Al = std::allocator<T>>
-using TargetList = std::list<T, Al>;
+template <typename T, typename Al = std::allocator<T>, int64_t SlabSize = 0>
+using TargetList = sp::list<T, Al, SlabSize>;
 
-std::random_device ran_dev;
-std::mt19937 gen(ran_dev());
+static_assert(std::bidirectional_iterator<TargetList<int>::iterator> &&
+                  std::bidirectional_iterator<TargetList<int>::const_iterator>,
+              "List iterators must be bidirectional");
+static_assert(std::ranges::bidirectional_range<TargetList<int>> &&
+                  std::ranges::common_range<const TargetList<int>>,
+              "List must be bidirectional common range");
+
+static std::random_device ran_dev;
+static std::mt19937 gen(ran_dev());
 
 #ifdef MAX_SIZE
-std::uniform_int_distribution<dstd::size_t> uid(1, MAX_SIZE);
+static std::uniform_int_distribution<int64_t> uid(1, MAX_SIZE);
 #else
-std::uniform_int_distribution<int64_t> uid(1, 100);
+static std::uniform_int_distribution<int64_t> uid(1, 100);
 #endif
 
 #ifdef LOOP_COUNT
 constexpr int loop = LOOP_COUNT;
 #else
-// constexpr int loop = 15;
+constexpr int loop = 15;
 #endif
 
 TEST(ListTest, ctor_default) {
@@ -151,94 +164,455 @@ TEST(ListTest, ctor_move) {
 //   ASSERT_EQ(lst2.back(), safe("not default"));
 // }
 
-// TEST(ListTest, comparison_1) {
-//   int64_t size = uid(gen);
-//   TargetList<safe> lst1(size, safe("equal"));
-//   TargetList<safe> lst2(size, safe("equal"));
+TEST(ListTest, comparison_1) {
+  int64_t size = uid(gen);
+  TargetList<safe> lst1(size, safe("equal"));
+  TargetList<safe> lst2(size, safe("equal"));
 
-//   ASSERT_TRUE(lst1 == lst2);
-//   ASSERT_FALSE(lst1 != lst2);
-//   ASSERT_TRUE(lst2 == lst1);
-//   ASSERT_FALSE(lst2 != lst1);
-// }
+  ASSERT_TRUE(lst1 == lst2);
+  ASSERT_FALSE(lst1 != lst2);
+  ASSERT_TRUE(lst2 == lst1);
+  ASSERT_FALSE(lst2 != lst1);
+}
 
-// TEST(ListTest, comparison_2) {
-//   TargetList<safe> lst1(uid(gen), safe("not equal"));
-//   TargetList<safe> lst2(uid(gen), safe("equal"));
+TEST(ListTest, comparison_2) {
+  TargetList<safe> lst1(uid(gen), safe("not equal"));
+  TargetList<safe> lst2(uid(gen), safe("equal"));
 
-//   ASSERT_FALSE(lst1 == lst2);
-//   ASSERT_TRUE(lst1 != lst2);
-//   ASSERT_FALSE(lst2 == lst1);
-//   ASSERT_TRUE(lst2 != lst1);
-// }
+  ASSERT_FALSE(lst1 == lst2);
+  ASSERT_TRUE(lst1 != lst2);
+  ASSERT_FALSE(lst2 == lst1);
+  ASSERT_TRUE(lst2 != lst1);
+}
 
-// TEST(ListTest, comparison_3) {
-//   TargetList<safe> lst1(uid(gen), safe("not equal"));
-//   TargetList<safe> lst2;
+TEST(ListTest, comparison_3) {
+  TargetList<safe> lst1(uid(gen), safe("not equal"));
+  TargetList<safe> lst2;
 
-//   ASSERT_FALSE(lst1 == lst2);
-//   ASSERT_TRUE(lst1 != lst2);
-//   ASSERT_FALSE(lst2 == lst1);
-//   ASSERT_TRUE(lst2 != lst1);
-// }
+  ASSERT_FALSE(lst1 == lst2);
+  ASSERT_TRUE(lst1 != lst2);
+  ASSERT_FALSE(lst2 == lst1);
+  ASSERT_TRUE(lst2 != lst1);
+}
 
-// TEST(ListTest, comparison_self) {
-//   TargetList<safe> lst(uid(gen), safe("not equal"));
+TEST(ListTest, comparison_self) {
+  TargetList<safe> lst(uid(gen), safe("not equal"));
 
-//   ASSERT_TRUE(lst == lst);
-//   ASSERT_FALSE(lst != lst);
-// }
+  ASSERT_TRUE(lst == lst);
+  ASSERT_FALSE(lst != lst);
+}
 
-// TEST(ListTest, comparison_empty) {
-//   TargetList<safe> lst1;
-//   TargetList<safe> lst2;
+TEST(ListTest, comparison_empty) {
+  TargetList<safe> lst1;
+  TargetList<safe> lst2;
 
-//   ASSERT_TRUE(lst1 == lst2);
-//   ASSERT_FALSE(lst1 != lst2);
-// }
+  ASSERT_TRUE(lst1 == lst2);
+  ASSERT_FALSE(lst1 != lst2);
+}
 
-// TEST(ListTest, clear) {
-//   for (int i = 0; i < loop; i++) {
-//     TargetList<safe> lst(uid(gen), safe("dirty"));
+TEST(ListTest, clear) {
+  for (int i = 0; i < loop; i++) {
+    TargetList<safe> lst(uid(gen), safe("dirty"));
 
-//     lst.clear();
-//     ASSERT_EQ(lst.size(), 0);
-//   }
-// }
+    lst.clear();
+    ASSERT_EQ(lst.size(), 0);
+  }
+}
 
-// TEST(ListTest, insert_movable) {
-//   for (int i = 0; i < loop; i++) {
-//     TargetList<not_safe> lst(uid(gen), not_safe("default"));
-//     std::uniform_int_distribution<int64_t> uid_lst(0, lst.size());
-//     int64_t pos = uid_lst(gen);
-//     auto insert_pos = lst.begin();
-//     for (int64_t i = 0; i < pos; ++i, ++insert_pos) {};
-//     insert_pos = lst.insert(insert_pos, not_safe("inserted"));
-//     ASSERT_EQ(*insert_pos, not_safe("inserted"));
-//   }
-// }
+TEST(ListTest, insert_movable) {
+  for (int i = 0; i < loop; i++) {
+    TargetList<not_safe> lst(uid(gen), not_safe("default"));
+    std::uniform_int_distribution<int64_t> uid_lst(0, lst.size());
+    int64_t pos = uid_lst(gen);
+    auto insert_pos = lst.begin();
+    for (int64_t i = 0; i < pos; ++i, ++insert_pos) {};
+    insert_pos = lst.insert(insert_pos, not_safe("inserted"));
+    ASSERT_EQ(*insert_pos, not_safe("inserted"));
+  }
+}
 
-// TEST(ListTest, insert_empty_movable) {
-//   TargetList<not_safe> lst;
-//   auto insert_pos = lst.insert(lst.begin(), not_safe("inserted"));
-//   ASSERT_EQ(insert_pos, lst.begin());
-// }
+TEST(ListTest, insert_empty_movable) {
+  TargetList<not_safe> lst;
+  auto insert_pos = lst.insert(lst.begin(), not_safe("inserted"));
+  ASSERT_EQ(insert_pos, lst.begin());
+}
 
-// TEST(ListTest, insert_begin_movable) {
-//   TargetList<not_safe> lst(uid(gen), not_safe("default"));
-//   auto insert_pos = lst.insert(lst.begin(), not_safe("inserted"));
-//   ASSERT_EQ(*insert_pos, not_safe("inserted"));
-//   ASSERT_EQ(*lst.begin(), not_safe("inserted"));
-//   ASSERT_EQ(lst.begin(), insert_pos);
-// }
+TEST(ListTest, insert_begin_movable) {
+  TargetList<not_safe> lst(uid(gen), not_safe("default"));
+  auto insert_pos = lst.insert(lst.begin(), not_safe("inserted"));
+  ASSERT_EQ(*insert_pos, not_safe("inserted"));
+  ASSERT_EQ(*lst.begin(), not_safe("inserted"));
+  ASSERT_EQ(lst.begin(), insert_pos);
+}
 
-// TEST(ListTest, stream) {
-//   TargetList<not_safe> lst{
-//       not_safe("Aileen"), not_safe("Anna"),  not_safe("Louie"),
-//       not_safe("Noel"),   not_safe("Grace"),
-//   };
-//   std::stringstream stream;
-//   std::string ASSERTed("Aileen Anna Louie Noel Grace");
-//   stream << lst;
-//   ASSERT_EQ(ASSERTed, stream.str());
-// }
+TEST(ListTest, stream) {
+  TargetList<not_safe> lst{
+      not_safe("Aileen"), not_safe("Anna"),  not_safe("Louie"),
+      not_safe("Noel"),   not_safe("Grace"),
+  };
+  std::stringstream stream;
+  std::string ASSERTed("Aileen Anna Louie Noel Grace");
+  stream << lst;
+  ASSERT_EQ(ASSERTed, stream.str());
+}
+
+TEST(ListTest, node_size) {
+  struct expected {
+    void* prev;
+    void* next;
+    double data;
+  };
+  alloc_record record;
+  recording_allocator<double> al(&record);
+  TargetList<double, recording_allocator<double>> lst(3, 1.0, al);
+  ASSERT_EQ(record.obj_size, sizeof(expected));
+}
+
+TEST(ListTest, swap) {
+  TargetList<safe> lst1(uid(gen), safe("first"));
+  TargetList<safe> lst2(uid(gen), safe("second"));
+  int64_t size1 = lst1.size();
+  int64_t size2 = lst2.size();
+
+  lst1.swap(lst2);
+
+  ASSERT_EQ(lst1.size(), size2);
+  ASSERT_EQ(lst2.size(), size1);
+  ASSERT_EQ(lst1.front(), safe("second"));
+  ASSERT_EQ(lst2.back(), safe("first"));
+  ASSERT_TRUE(lst1.integrity());
+  ASSERT_TRUE(lst2.integrity());
+}
+
+TEST(ListTest, swap_empty) {
+  TargetList<safe> lst1(uid(gen), safe("first"));
+  TargetList<safe> lst2;
+  int64_t size = lst1.size();
+
+  lst1.swap(lst2);
+  ASSERT_TRUE(lst1.empty());
+  ASSERT_EQ(lst1.begin(), lst1.end());
+  ASSERT_EQ(lst2.size(), size);
+  ASSERT_TRUE(lst2.integrity());
+
+  lst1.swap(lst2);
+  ASSERT_TRUE(lst2.empty());
+  ASSERT_EQ(lst2.begin(), lst2.end());
+  ASSERT_EQ(lst1.size(), size);
+  ASSERT_TRUE(lst1.integrity());
+}
+
+TEST(ListTest, ctor_move_empty) {
+  TargetList<safe> lst1;
+  TargetList<safe> lst2(std::move(lst1));
+
+  ASSERT_TRUE(lst2.empty());
+  ASSERT_EQ(lst2.begin(), lst2.end());
+  ASSERT_EQ(lst1.begin(), lst1.end());
+}
+
+TEST(ListTest, ctor_throwing) {
+  std::vector<throwing> from(10);
+  ASSERT_THROW(TargetList<throwing> lst(from.begin(), from.end()),
+               std::runtime_error);
+}
+
+TEST(ListTest, insert_count) {
+  TargetList<safe> lst{safe("first"), safe("last")};
+  auto pos = lst.insert(++lst.cbegin(), int64_t(3), safe("inserted"));
+  ASSERT_EQ(lst.size(), 5);
+  ASSERT_EQ(*pos, safe("inserted"));
+  ASSERT_EQ(*--pos, safe("first"));
+  ASSERT_EQ(lst.back(), safe("last"));
+  ASSERT_TRUE(lst.integrity());
+}
+
+TEST(ListTest, insert_range_throwing) {
+  TargetList<throwing> lst(int64_t(3), throwing("kept"));
+  std::vector<throwing> from(10);
+  ASSERT_THROW(lst.insert(lst.cend(), from.begin(), from.end()),
+               std::runtime_error);
+  ASSERT_EQ(lst.size(), 3);
+  ASSERT_TRUE(lst.integrity());
+}
+
+TEST(ListTest, push_pop) {
+  TargetList<std::string> lst;
+  lst.push_back("middle");
+  lst.push_front("front");
+  lst.emplace_back(3, 'b');
+  ASSERT_EQ(lst.size(), 3);
+  ASSERT_EQ(lst.front(), "front");
+  ASSERT_EQ(lst.back(), "bbb");
+
+  lst.pop_front();
+  ASSERT_EQ(lst.front(), "middle");
+  lst.pop_back();
+  ASSERT_EQ(lst.back(), "middle");
+  lst.pop_back();
+  ASSERT_TRUE(lst.empty());
+  ASSERT_TRUE(lst.integrity());
+}
+
+TEST(ListTest, erase) {
+  TargetList<int> lst{0, 1, 2, 3, 4, 5};
+  auto pos = lst.erase(++lst.cbegin());
+  ASSERT_EQ(*pos, 2);
+  pos = lst.erase(pos, --lst.cend());
+  ASSERT_EQ(*pos, 5);
+  ASSERT_EQ(lst, TargetList<int>({0, 5}));
+  ASSERT_TRUE(lst.integrity());
+}
+
+TEST(ListTest, slab_chunks) {
+  alloc_record record;
+  recording_allocator<double> al(&record);
+  TargetList<double, recording_allocator<double>, 16> lst(100, 1.0, al);
+  ASSERT_EQ(record.calls, 7);
+  ASSERT_EQ(lst.size(), 100);
+  ASSERT_TRUE(lst.integrity());
+
+  lst.clear();
+  ASSERT_EQ(record.live, 0);
+  lst.push_back(2.0);
+  ASSERT_EQ(record.live, 1);
+  ASSERT_EQ(lst.front(), 2.0);
+}
+
+TEST(ListTest, slab_reuse) {
+  alloc_record record;
+  recording_allocator<std::string> al(&record);
+  TargetList<std::string, recording_allocator<std::string>, 8> lst(
+      8, std::string("node"), al);
+  std::string* erased = &lst.front();
+  lst.pop_front();
+  lst.erase(++lst.cbegin(), lst.cend());
+  ASSERT_EQ(lst.size(), 1);
+
+  lst.insert(lst.cend(), int64_t(6), std::string("reused"));
+  lst.push_front("front");
+  ASSERT_EQ(record.calls, 1);
+  ASSERT_EQ(&lst.front(), erased);
+  ASSERT_EQ(lst.size(), 8);
+
+  lst.push_back("spilled");
+  ASSERT_EQ(record.live, 2);
+  ASSERT_TRUE(lst.integrity());
+}
+
+TEST(ListTest, slab_move) {
+  alloc_record record;
+  recording_allocator<safe> al(&record);
+  TargetList<safe, recording_allocator<safe>, 4> lst1(10, safe("moved"), al);
+  TargetList<safe, recording_allocator<safe>, 4> lst2(std::move(lst1));
+  lst1.push_back(safe("new"));
+
+  ASSERT_EQ(lst2.size(), 10);
+  ASSERT_EQ(lst2.back(), safe("moved"));
+  ASSERT_EQ(lst1.front(), safe("new"));
+  ASSERT_EQ(record.live, 4);
+}
+
+TEST(ListTest, slab_throwing) {
+  std::vector<throwing> from(10);
+  ASSERT_THROW((TargetList<throwing, std::allocator<throwing>, 4>(
+                   from.begin(), from.end())),
+               std::runtime_error);
+}
+
+TEST(ListTest, splice_all) {
+  TargetList<safe> lst1{safe("1"), safe("4")};
+  TargetList<safe> lst2{safe("2"), safe("3")};
+  const safe* spliced = &lst2.front();
+
+  lst1.splice(++lst1.cbegin(), lst2);
+  ASSERT_TRUE(lst2.empty());
+  ASSERT_TRUE(lst2.integrity());
+  ASSERT_EQ(lst1, TargetList<safe>({safe("1"), safe("2"), safe("3"),
+                                    safe("4")}));
+  ASSERT_EQ(&*++lst1.cbegin(), spliced);
+  ASSERT_TRUE(lst1.integrity());
+}
+
+TEST(ListTest, splice_one) {
+  TargetList<int> lst1{1, 2, 3};
+  TargetList<int> lst2{4, 5, 6};
+
+  lst1.splice(lst1.cbegin(), lst2, ++lst2.cbegin());
+  ASSERT_EQ(lst1, TargetList<int>({5, 1, 2, 3}));
+  ASSERT_EQ(lst2, TargetList<int>({4, 6}));
+
+  lst1.splice(lst1.cend(), lst1, lst1.cbegin());
+  ASSERT_EQ(lst1, TargetList<int>({1, 2, 3, 5}));
+  lst1.splice(lst1.cbegin(), lst1, lst1.cbegin());
+  ASSERT_EQ(lst1, TargetList<int>({1, 2, 3, 5}));
+  ASSERT_TRUE(lst1.integrity());
+  ASSERT_TRUE(lst2.integrity());
+}
+
+TEST(ListTest, splice_range) {
+  TargetList<int> lst1{1, 2, 3};
+  TargetList<int> lst2{4, 5, 6, 7};
+
+  lst1.splice(lst1.cend(), lst2, ++lst2.cbegin(), --lst2.cend());
+  ASSERT_EQ(lst1, TargetList<int>({1, 2, 3, 5, 6}));
+  ASSERT_EQ(lst2, TargetList<int>({4, 7}));
+
+  lst1.splice(lst1.cbegin(), lst1, --lst1.cend(), lst1.cend());
+  ASSERT_EQ(lst1, TargetList<int>({6, 1, 2, 3, 5}));
+  ASSERT_TRUE(lst1.integrity());
+  ASSERT_TRUE(lst2.integrity());
+}
+
+TEST(ListTest, merge) {
+  using keyed = std::pair<int, int>;
+  auto by_key = [](const keyed& a, const keyed& b) {
+    return a.first < b.first;
+  };
+  TargetList<keyed> lst1{{1, 0}, {3, 0}, {3, 1}, {8, 0}};
+  TargetList<keyed> lst2{{0, 2}, {3, 2}, {9, 2}};
+
+  lst1.merge(lst2, by_key);
+  ASSERT_TRUE(lst2.empty());
+  ASSERT_EQ(lst1, TargetList<keyed>({{0, 2}, {1, 0}, {3, 0}, {3, 1}, {3, 2},
+                                     {8, 0}, {9, 2}}));
+  ASSERT_TRUE(lst1.integrity());
+}
+
+TEST(ListTest, merge_default) {
+  TargetList<int> lst1{1, 4, 7};
+  lst1.merge(TargetList<int>{0, 2, 9});
+  ASSERT_EQ(lst1, TargetList<int>({0, 1, 2, 4, 7, 9}));
+}
+
+TEST(ListTest, reverse) {
+  TargetList<int> lst{1, 2, 3, 4};
+  lst.reverse();
+  ASSERT_EQ(lst, TargetList<int>({4, 3, 2, 1}));
+  ASSERT_TRUE(lst.integrity());
+
+  TargetList<int> empty;
+  empty.reverse();
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(empty.begin(), empty.end());
+}
+
+TEST(ListTest, unique) {
+  TargetList<int> lst{1, 1, 2, 2, 2, 1, 3, 3};
+  ASSERT_EQ(lst.unique(), 4);
+  ASSERT_EQ(lst, TargetList<int>({1, 2, 1, 3}));
+
+  ASSERT_EQ(lst.unique([](int a, int b) { return b - a < 2; }), 2);
+  ASSERT_EQ(lst, TargetList<int>({1, 3}));
+  ASSERT_TRUE(lst.integrity());
+}
+
+TEST(ListTest, sort) {
+  for (int i = 0; i < loop; i++) {
+    std::uniform_int_distribution<int> values(-50, 50);
+    std::vector<int> expected(uid(gen));
+    for (int& val : expected) {
+      val = values(gen);
+    }
+    TargetList<int> lst(expected.begin(), expected.end());
+    const int* first = &lst.front();
+
+    lst.sort();
+    std::sort(expected.begin(), expected.end());
+    ASSERT_TRUE(std::equal(lst.begin(), lst.end(), expected.begin(),
+                           expected.end()));
+    ASSERT_TRUE(std::find_if(lst.begin(), lst.end(), [first](const int& x) {
+                  return &x == first;
+                }) != lst.end());
+    ASSERT_TRUE(lst.integrity());
+  }
+}
+
+TEST(ListTest, sort_stable) {
+  using keyed = std::pair<int, int>;
+  std::vector<keyed> expected;
+  for (int i = 0; i < 300; ++i) {
+    expected.emplace_back(i * 7 % 10, i);
+  }
+  TargetList<keyed> lst(expected.begin(), expected.end());
+  auto by_key = [](const keyed& a, const keyed& b) {
+    return a.first < b.first;
+  };
+
+  lst.sort(by_key);
+  std::stable_sort(expected.begin(), expected.end(), by_key);
+  ASSERT_TRUE(std::equal(lst.begin(), lst.end(), expected.begin(),
+                         expected.end()));
+  ASSERT_EQ(lst.back(), expected.back());
+}
+
+TEST(ListTest, sort_throwing) {
+  TargetList<int> lst;
+  for (int i = 0; i < 100; ++i) {
+    lst.push_back((i * 37) % 100);
+  }
+  int calls = 0;
+  ASSERT_THROW(lst.sort([&calls](int a, int b) {
+    if (++calls == 150) {
+      throw std::runtime_error("comparison failed");
+    }
+    return a < b;
+  }),
+               std::runtime_error);
+  ASSERT_EQ(lst.size(), 100);
+  ASSERT_TRUE(lst.integrity());
+  std::vector<int> values(lst.begin(), lst.end());
+  std::sort(values.begin(), values.end());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+}
+
+TEST(ListTest, slab_splice) {
+  alloc_record record;
+  recording_allocator<safe> al(&record);
+  using slab_list = TargetList<safe, recording_allocator<safe>, 4>;
+  slab_list lst1(3, safe("kept"), al);
+  {
+    slab_list lst2(6, safe("spliced"), al);
+    slab_list lst3(2, safe("single"), al);
+    lst1.splice(lst1.cend(), lst2);
+    lst1.splice(lst1.cbegin(), lst3, lst3.cbegin());
+    lst2.push_back(safe("fresh"));
+    ASSERT_EQ(lst2.size(), 1);
+    ASSERT_EQ(lst3.size(), 1);
+  }
+  ASSERT_EQ(lst1.size(), 10);
+  ASSERT_EQ(lst1.front(), safe("single"));
+  ASSERT_EQ(lst1.back(), safe("spliced"));
+  ASSERT_TRUE(lst1.integrity());
+  ASSERT_EQ(record.live, 3);
+
+  lst1.clear();
+  ASSERT_EQ(record.live, 0);
+}
+
+TEST(ListTest, slab_merge) {
+  alloc_record record;
+  recording_allocator<int> al(&record);
+  using slab_list = TargetList<int, recording_allocator<int>, 2>;
+  slab_list lst1({1, 3, 5}, al);
+  {
+    slab_list lst2({0, 2, 4, 6}, al);
+    lst1.merge(lst2);
+  }
+  ASSERT_EQ(lst1, slab_list({0, 1, 2, 3, 4, 5, 6}, al));
+  lst1.push_back(7);
+  ASSERT_EQ(record.live, 4);
+}
+
+TEST(ListTest, ranges) {
+  TargetList<int> lst{1, 2, 3, 4};
+  TargetList<int>::const_iterator pos = std::ranges::find(lst, 3);
+  ASSERT_EQ(*pos, 3);
+  ASSERT_EQ(pos, std::ranges::next(lst.begin(), 2));
+
+  std::vector<int> reversed;
+  std::ranges::copy(lst | std::views::reverse, std::back_inserter(reversed));
+  ASSERT_EQ(reversed, std::vector<int>({4, 3, 2, 1}));
+}
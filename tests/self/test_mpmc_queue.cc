@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/mpmc_queue.h"
+#include "test_helpers.h"
+
+TEST(MpmcQueueTest, ctor) {
+  sp::mpmc_queue<safe> queue(3);
+  ASSERT_EQ(queue.capacity(), 4);
+  ASSERT_TRUE(queue.empty());
+  ASSERT_THROW(sp::mpmc_queue<int>(-1), std::length_error);
+}
+
+TEST(MpmcQueueTest, push_pop) {
+  sp::mpmc_queue<std::string> queue(2);
+  queue.push("a");
+  ASSERT_TRUE(queue.try_emplace(2, 'b'));
+  ASSERT_FALSE(queue.try_push("c"));
+  ASSERT_EQ(queue.size(), 2);
+
+  std::string out;
+  queue.pop(out);
+  ASSERT_EQ(out, "a");
+  std::string c = "c";
+  ASSERT_TRUE(queue.try_push(c));
+  ASSERT_TRUE(queue.try_pop(out));
+  ASSERT_EQ(out, "bb");
+  ASSERT_TRUE(queue.try_pop(out));
+  ASSERT_EQ(out, "c");
+  ASSERT_FALSE(queue.try_pop(out));
+}
+
+TEST(MpmcQueueTest, batch) {
+  sp::mpmc_queue<int> queue(8);
+  std::vector<int> from(12);
+  for (int i = 0; i < 12; ++i) {
+    from[i] = i;
+  }
+  auto rest = queue.try_push(from.begin(), from.end());
+  ASSERT_EQ(rest - from.begin(), 8);
+
+  std::vector<int> to;
+  ASSERT_EQ(queue.try_pop(std::back_inserter(to), 5), 5);
+  ASSERT_EQ(queue.try_push(rest, from.end()), from.end());
+  ASSERT_EQ(queue.try_pop(std::back_inserter(to), 100), 7);
+  ASSERT_EQ(to, from);
+  ASSERT_EQ(queue.try_pop(std::back_inserter(to), 100), 0);
+}
+
+TEST(MpmcQueueTest, throwing_copy) {
+  sp::mpmc_queue<relocatable> relocatables(2);
+  relocatables.push(relocatable(1));
+  relocatable out;
+  relocatables.pop(out);
+  ASSERT_EQ(out, relocatable(1));
+
+  sp::mpmc_queue<std::string> queue(4);
+  std::vector<std::string> from{"a", "b", "c"};
+  // string copies may throw, so batch falls back to pushing one by one
+  ASSERT_EQ(queue.try_push(from.begin(), from.end()), from.end());
+  ASSERT_EQ(queue.size(), 3);
+}
+
+TEST(MpmcQueueTest, threads) {
+  constexpr int kThreads = 4;
+  constexpr int kCount = 20000;
+  sp::mpmc_queue<int> queue(32);
+  std::atomic<int> popped = 0;
+  std::vector<std::vector<int>> seen(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&queue, t] {
+      for (int i = t * kCount; i < (t + 1) * kCount; i += 2) {
+        int batch[2] = {i, i + 1};
+        int* pos = batch;
+        while (pos != batch + 2) {
+          pos = queue.try_push(pos, batch + 2);
+        }
+      }
+    });
+    threads.emplace_back([&queue, &popped, &seen, t] {
+      while (popped.load() < kThreads * kCount) {
+        int value = 0;
+        if (t % 2) {
+          popped += queue.try_pop(std::back_inserter(seen[t]), 3);
+        } else if (queue.try_pop(value)) {
+          seen[t].push_back(value);
+          ++popped;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::vector<int> all;
+  for (auto& part : seen) {
+    all.insert(all.end(), part.begin(), part.end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(static_cast<int>(all.size()), kThreads * kCount);
+  for (int i = 0; i < kThreads * kCount; ++i) {
+    ASSERT_EQ(all[i], i);
+  }
+}
@@ -0,0 +1,165 @@
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/priority_queue.h"
+#include "test_helpers.h"
+
+template <typename T, typename Compare = std::less<T>, int Arity = 4>
+using TargetQueue = sp::priority_queue<T, sp::vector<T>, Compare, Arity>;
+
+TEST(PriorityQueueTest, ctor) {
+  TargetQueue<int> queue1;
+  ASSERT_TRUE(queue1.empty());
+  ASSERT_EQ(queue1.size(), 0);
+
+  TargetQueue<int> queue2{3, 1, 4, 1, 5, 9, 2, 6};
+  ASSERT_EQ(queue2.size(), 8);
+  ASSERT_EQ(queue2.top(), 9);
+  ASSERT_TRUE(queue2.integrity());
+
+  TargetQueue<int, std::greater<int>> queue3(std::greater<int>(),
+                                             sp::vector<int>{5, 3, 8, 1});
+  ASSERT_EQ(queue3.top(), 1);
+  ASSERT_TRUE(queue3.integrity());
+}
+
+TEST(PriorityQueueTest, push_pop) {
+  TargetQueue<std::string> queue;
+  queue.push("b");
+  std::string d = "d";
+  queue.push(d);
+  queue.emplace(2, 'c');
+  queue.push("a");
+  ASSERT_EQ(queue.top(), "d");
+  queue.pop();
+  ASSERT_EQ(queue.top(), "cc");
+  queue.pop();
+  queue.pop();
+  ASSERT_EQ(queue.top(), "a");
+  queue.pop();
+  ASSERT_TRUE(queue.empty());
+}
+
+template <int Arity>
+void random_against_std() {
+  std::mt19937 gen(Arity);
+  std::uniform_int_distribution<int> op(0, 4);
+  std::uniform_int_distribution<int> val(0, 1000);
+  TargetQueue<int, std::less<int>, Arity> queue;
+  std::priority_queue<int> expected;
+  for (int i = 0; i < 3000; ++i) {
+    int value = val(gen);
+    switch (op(gen)) {
+      case 0:
+      case 1:
+        queue.push(value);
+        expected.push(value);
+        break;
+      case 2:
+        if (!expected.empty()) {
+          queue.pop();
+          expected.pop();
+        }
+        break;
+      case 3:
+        if (!expected.empty()) {
+          queue.replace_top(value);
+          expected.pop();
+          expected.push(value);
+        }
+        break;
+      default: {
+        expected.push(value);
+        ASSERT_EQ(queue.pop_push(value), expected.top());
+        expected.pop();
+      }
+    }
+    ASSERT_EQ(queue.size(), static_cast<int64_t>(expected.size()));
+    if (!expected.empty()) {
+      ASSERT_EQ(queue.top(), expected.top());
+    }
+  }
+  ASSERT_TRUE(queue.integrity());
+}
+
+TEST(PriorityQueueTest, random_arities) {
+  random_against_std<2>();
+  random_against_std<3>();
+  random_against_std<4>();
+  random_against_std<8>();
+}
+
+TEST(PriorityQueueTest, push_range) {
+  TargetQueue<int> queue{50, 40};
+  // few elements are sifted up one by one
+  queue.push_range(std::vector<int>{45});
+  ASSERT_TRUE(queue.integrity());
+  // many elements rebuild the heap
+  std::vector<int> many(1000);
+  for (int i = 0; i < 1000; ++i) {
+    many[i] = (i * 7919) % 1000;
+  }
+  queue.push_range(many);
+  ASSERT_EQ(queue.size(), 1003);
+  ASSERT_TRUE(queue.integrity());
+
+  int previous = queue.top();
+  while (!queue.empty()) {
+    ASSERT_LE(queue.top(), previous);
+    previous = queue.top();
+    queue.pop();
+  }
+}
+
+TEST(PriorityQueueTest, push_range_throwing) {
+  TargetQueue<throwing> queue;
+  // descending order is never sifted, so only reallocation counts
+  for (char name : {'x', 'm', 'c'}) {
+    throwing::count = 0;
+    queue.emplace(std::string(1, name));
+  }
+  std::vector<throwing> range;
+  range.reserve(6);
+  for (char name : {'z', 'a', 'y', 'b', 'w', 'd'}) {
+    range.emplace_back(std::string(1, name));
+  }
+  // fifth copy throws while container reallocates for second element
+  throwing::count = 0;
+  ASSERT_THROW(queue.push_range(range), std::runtime_error);
+  ASSERT_EQ(queue.size(), 3);
+  ASSERT_TRUE(queue.integrity());
+  ASSERT_EQ(queue.top(), throwing("x"));
+}
+
+TEST(PriorityQueueTest, pop_push) {
+  TargetQueue<safe> queue{safe("b"), safe("d"), safe("c")};
+  // greater than top, heap is not touched
+  ASSERT_EQ(queue.pop_push(safe("e")), safe("e"));
+  ASSERT_EQ(queue.top(), safe("d"));
+  ASSERT_EQ(queue.pop_push(safe("a")), safe("d"));
+  ASSERT_EQ(queue.top(), safe("c"));
+  ASSERT_EQ(queue.size(), 3);
+
+  queue.replace_top("z");
+  ASSERT_EQ(queue.top(), safe("z"));
+  queue.replace_top("0");
+  ASSERT_EQ(queue.top(), safe("b"));
+  ASSERT_TRUE(queue.integrity());
+
+  TargetQueue<int> empty;
+  ASSERT_EQ(empty.pop_push(7), 7);
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST(PriorityQueueTest, swap) {
+  TargetQueue<int, std::greater<int>> queue1{3, 2, 1};
+  TargetQueue<int, std::greater<int>> queue2{7};
+  queue1.swap(queue2);
+  ASSERT_EQ(queue1.top(), 7);
+  ASSERT_EQ(queue2.top(), 1);
+  ASSERT_EQ(queue2.size(), 3);
+}
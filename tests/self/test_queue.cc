@@ -1,12 +1,12 @@
-#include <gmock/gmock.h>
-#include <gtest/gtest.h>
-
-#include "../s21_containers.h"
 #include <queue>
+#include <string>
 
+#include "gtest/gtest.h"
+#include "sp/list.h"
+#include "sp/queue.h"
 
-TEST(front, test0) {
-  s21::queue<int> test;
+TEST(QueueTest, front) {
+  sp::queue<int> test;
   test.push(1);
   test.push(2);
 
@@ -16,8 +16,8 @@ TEST(front, test0) {
   ASSERT_EQ(test.front(), testS.front());
 }
 
-TEST(back, test0) {
-  s21::queue<int> test;
+TEST(QueueTest, back) {
+  sp::queue<int> test;
   test.push(1);
   test.push(2);
 
@@ -27,32 +27,27 @@ TEST(back, test0) {
   ASSERT_EQ(test.back(), testS.back());
 }
 
-TEST(empty, test0) { 
-  s21::queue <int> test;
+TEST(QueueTest, empty) {
+  sp::queue<int> test;
+  std::queue<int> testS;
+  ASSERT_EQ(test.empty(), testS.empty());
   test.push(1);
   test.pop();
-  std::queue<int> testS;
   testS.push(1);
   testS.pop();
   ASSERT_EQ(test.empty(), testS.empty());
 }
 
-TEST(empty, test1) {
-  s21::queue<int> test;
+TEST(QueueTest, size) {
+  sp::queue<int> test;
   std::queue<int> testS;
-  ASSERT_EQ(test.empty(), testS.empty());
+  ASSERT_EQ(test.size(), static_cast<int64_t>(testS.size()));
 }
 
-TEST(size, test1) {
-  s21::queue<int> test;
-  std::queue<int> testS;
-  ASSERT_EQ(test.size(), testS.size());
-}
-
-TEST(swap, test1) {
-  s21::queue<int> test;
+TEST(QueueTest, swap) {
+  sp::queue<int> test;
   test.push(1);
-  s21::queue<int> other;
+  sp::queue<int> other;
   other.push(3);
   test.swap(other);
   std::queue<int> testS;
@@ -63,8 +58,23 @@ TEST(swap, test1) {
   ASSERT_EQ(test.back(), testS.back());
 }
 
-int main(int argc, char **argv) {
-  ::testing::InitGoogleTest(&argc, argv);
+TEST(QueueTest, fifo_order) {
+  sp::queue<std::string> test{"a", "b"};
+  ASSERT_EQ(test.emplace(3, 'c'), "ccc");
+  for (int i = 0; i < 100; ++i) {
+    test.push(test.front());
+    test.pop();
+  }
+  ASSERT_EQ(test.size(), 3);
+  ASSERT_EQ(test.front(), "b");
+  ASSERT_EQ(test.back(), "a");
+}
 
-  return RUN_ALL_TESTS();
-}
\ No newline at end of file
+TEST(QueueTest, list_container) {
+  sp::queue<int, sp::list<int>> test(sp::list<int>{1, 2, 3});
+  test.push(4);
+  test.pop();
+  ASSERT_EQ(test.front(), 2);
+  ASSERT_EQ(test.back(), 4);
+  ASSERT_EQ(test, (sp::queue<int, sp::list<int>>{2, 3, 4}));
+}
@@ -1,9 +1,95 @@
-#include <gmock/gmock.h>
-#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 
-#include "../s21_containers.h"
-int main(int argc, char **argv) {
-  ::testing::InitGoogleTest(&argc, argv);
+#include "gtest/gtest.h"
+#include "sp/set.h"
+#include "test_helpers.h"
 
-  return RUN_ALL_TESTS();
-}
\ No newline at end of file
+template <typename K, typename Compare = std::less<K>>
+using TargetSet = sp::set<K, Compare>;
+
+TEST(SetTest, ctor_default) {
+  TargetSet<safe> set;
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.size(), 0);
+  ASSERT_EQ(set.begin(), set.end());
+}
+
+TEST(SetTest, ctor_range) {
+  std::vector<int> from{5, 3, 5, 1, 3};
+  TargetSet<int> set(from.begin(), from.end());
+  ASSERT_EQ(set.size(), 3);
+  ASSERT_EQ(*set.begin(), 1);
+  ASSERT_TRUE(set.integrity());
+}
+
+TEST(SetTest, ctor_copy_move) {
+  TargetSet<std::string> set1{"a", "b", "c"};
+  TargetSet<std::string> set2(set1);
+  ASSERT_EQ(set1, set2);
+
+  TargetSet<std::string> set3(std::move(set1));
+  ASSERT_TRUE(set1.empty());
+  ASSERT_EQ(set3, set2);
+
+  set1 = set3;
+  set3 = std::move(set2);
+  ASSERT_EQ(set1, set3);
+}
+
+TEST(SetTest, insert) {
+  TargetSet<safe> set;
+  ASSERT_TRUE(set.insert(safe("one")).second);
+  auto result = set.insert(safe("one"));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, safe("one"));
+  ASSERT_TRUE(set.emplace("two").second);
+  ASSERT_EQ(set.size(), 2);
+}
+
+TEST(SetTest, erase) {
+  TargetSet<int> set{1, 2, 3, 4, 5};
+  ASSERT_EQ(set.erase(3), 1);
+  ASSERT_EQ(set.erase(3), 0);
+  ASSERT_EQ(*set.erase(set.begin()), 2);
+  set.erase(set.find(4), set.end());
+  ASSERT_EQ(set, TargetSet<int>({2}));
+  ASSERT_TRUE(set.integrity());
+}
+
+TEST(SetTest, lookup) {
+  TargetSet<int> set{10, 20, 30};
+  ASSERT_EQ(set.count(20), 1);
+  ASSERT_FALSE(set.contains(25));
+  ASSERT_EQ(*set.lower_bound(15), 20);
+  ASSERT_EQ(*set.upper_bound(20), 30);
+  ASSERT_EQ(set.find(40), set.end());
+}
+
+TEST(SetTest, heterogeneous_lookup) {
+  TargetSet<std::string, std::less<>> set{"alpha", "beta"};
+  ASSERT_TRUE(set.contains(std::string_view("beta")));
+  ASSERT_EQ(*set.find("alpha"), "alpha");
+  ASSERT_EQ(set.erase(std::string_view("alpha")), 1);
+  ASSERT_EQ(set.size(), 1);
+}
+
+TEST(SetTest, matches_std) {
+  TargetSet<int> set;
+  std::set<int> expected;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 701;
+    if (i % 3 == 2) {
+      ASSERT_EQ(set.erase(key), int64_t(expected.erase(key)));
+    } else {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ASSERT_TRUE(set.integrity());
+  ASSERT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+}
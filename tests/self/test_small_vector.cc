@@ -0,0 +1,195 @@
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sp/pool_allocator.h"
+#include "sp/small_vector.h"
+#include "test_helpers.h"
+
+template <typename T, int64_t N, typename Al = std::allocator<T>>
+using TargetVector = sp::small_vector<T, N, Al>;
+
+TEST(SmallVectorTest, ctor_default) {
+  const TargetVector<no_def, 8> vec;
+  ASSERT_EQ(vec.size(), 0);
+  ASSERT_EQ(vec.capacity(), 0);
+  ASSERT_FALSE(vec.is_inline());
+}
+
+TEST(SmallVectorTest, ctor_size_inline) {
+  const TargetVector<safe, 16> vec(10, safe("inline"));
+  ASSERT_EQ(vec.size(), 10);
+  ASSERT_EQ(vec.capacity(), 16);
+  ASSERT_TRUE(vec.is_inline());
+  for (const safe &ob : vec) {
+    ASSERT_EQ(ob, safe("inline"));
+  }
+}
+
+TEST(SmallVectorTest, push_back_no_alloc) {
+  sp::pool_allocator<safe> al(0);
+  TargetVector<safe, 8, sp::pool_allocator<safe>> vec(al);
+
+  for (int i = 0; i < 8; ++i) {
+    vec.push_back(safe(std::to_string(i)));
+  }
+  ASSERT_TRUE(vec.is_inline());
+  ASSERT_EQ(al.allocd(), 0);
+  ASSERT_THROW(vec.push_back(safe("spilled")), std::bad_alloc);
+  ASSERT_EQ(vec.size(), 8);
+  ASSERT_EQ(vec.back(), safe("7"));
+}
+
+TEST(SmallVectorTest, spill_and_shrink) {
+  int64_t size = 37;
+  TargetVector<safe, 8> vec;
+
+  for (int64_t i = 0; i < size; ++i) {
+    vec.emplace_back(std::to_string(i));
+  }
+  ASSERT_FALSE(vec.is_inline());
+  ASSERT_GT(vec.capacity(), 8);
+
+  vec.erase(vec.begin() + 4, vec.end());
+  vec.shrink_to_fit();
+  ASSERT_TRUE(vec.is_inline());
+  ASSERT_EQ(vec.capacity(), 8);
+  ASSERT_EQ(vec.size(), 4);
+  for (int64_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(vec[i], safe(std::to_string(i)));
+  }
+}
+
+TEST(SmallVectorTest, ctor_copy) {
+  const TargetVector<safe, 8> vec1(5, safe("copied"));
+  const TargetVector<safe, 8> vec2(vec1);
+
+  ASSERT_TRUE(vec2.is_inline());
+  ASSERT_NE(vec1.data(), vec2.data());
+  ASSERT_EQ(vec1, vec2);
+  ASSERT_EQ(vec2.front().birth, constructed::kCopy);
+}
+
+TEST(SmallVectorTest, ctor_move_inline) {
+  TargetVector<safe, 8> vec1(5, safe("moved"));
+  const TargetVector<safe, 8> vec2(std::move(vec1));
+
+  ASSERT_TRUE(vec2.is_inline());
+  ASSERT_EQ(vec1.size(), 0);
+  ASSERT_EQ(vec2.size(), 5);
+  ASSERT_EQ(vec2.front(), safe("moved"));
+  ASSERT_EQ(vec2.front().birth, constructed::kMove);
+}
+
+TEST(SmallVectorTest, ctor_move_heap) {
+  TargetVector<safe, 4> vec1(20, safe("moved"));
+  safe *ptr = vec1.data();
+  const TargetVector<safe, 4> vec2(std::move(vec1));
+
+  ASSERT_FALSE(vec2.is_inline());
+  ASSERT_EQ(vec2.data(), ptr);
+  ASSERT_EQ(vec2.size(), 20);
+  ASSERT_EQ(vec1.size(), 0);
+}
+
+TEST(SmallVectorTest, assignment_move) {
+  TargetVector<safe, 4> vec1(3, safe("first"));
+  TargetVector<safe, 4> vec2(20, safe("second"));
+
+  vec1 = std::move(vec2);
+  ASSERT_EQ(vec1.size(), 20);
+  ASSERT_FALSE(vec1.is_inline());
+  ASSERT_EQ(vec1.back(), safe("second"));
+
+  TargetVector<safe, 4> vec3(2, safe("third"));
+  vec1 = std::move(vec3);
+  ASSERT_EQ(vec1.size(), 2);
+  ASSERT_TRUE(vec1.is_inline());
+  ASSERT_EQ(vec1.back(), safe("third"));
+}
+
+TEST(SmallVectorTest, assignment_move_inline) {
+  TargetVector<int, 8> vec1{1, 2, 3};
+  TargetVector<int, 8> vec2{4, 5, 6, 7};
+
+  vec1 = std::move(vec2);
+  ASSERT_EQ(vec1.size(), 4);
+  ASSERT_TRUE(vec1.is_inline());
+  ASSERT_EQ(vec1.back(), 7);
+}
+
+TEST(SmallVectorTest, swap) {
+  TargetVector<not_safe, 4> vec1(3, not_safe("inline"));
+  TargetVector<not_safe, 4> vec2(30, not_safe("heap"));
+  TargetVector<not_safe, 4> exp1(vec2);
+  TargetVector<not_safe, 4> exp2(vec1);
+
+  vec1.swap(vec2);
+  ASSERT_EQ(vec1, exp1);
+  ASSERT_EQ(vec2, exp2);
+  ASSERT_FALSE(vec1.is_inline());
+  ASSERT_TRUE(vec2.is_inline());
+
+  TargetVector<not_safe, 4> vec3(2, not_safe("left"));
+  TargetVector<not_safe, 4> vec4(4, not_safe("right"));
+  TargetVector<not_safe, 4> exp3(vec4);
+  TargetVector<not_safe, 4> exp4(vec3);
+
+  vec3.swap(vec4);
+  ASSERT_EQ(vec3, exp3);
+  ASSERT_EQ(vec4, exp4);
+  ASSERT_TRUE(vec3.is_inline());
+  ASSERT_TRUE(vec4.is_inline());
+}
+
+TEST(SmallVectorTest, assignment_copy_inline) {
+  TargetVector<not_safe, 4> vec1(2, not_safe("first"));
+  const TargetVector<not_safe, 4> vec2(3, not_safe("second"));
+
+  vec1 = vec2;
+  ASSERT_EQ(vec1, vec2);
+  ASSERT_TRUE(vec1.is_inline());
+}
+
+TEST(SmallVectorTest, resize_to_inline_capacity) {
+  TargetVector<std::string, 4> vec(3);
+
+  vec.resize(4);
+  ASSERT_EQ(vec.size(), 4);
+  ASSERT_TRUE(vec.is_inline());
+}
+
+TEST(SmallVectorTest, insert_erase_inline_not_safe) {
+  TargetVector<not_safe, 4> vec{not_safe("a"), not_safe("b"), not_safe("c")};
+
+  vec.erase(vec.begin());
+  ASSERT_TRUE(vec.is_inline());
+  vec.insert(vec.begin(), not_safe("inserted"));
+  ASSERT_TRUE(vec.is_inline());
+  vec.emplace(vec.begin() + 1, "emplaced");
+  ASSERT_TRUE(vec.is_inline());
+  vec.erase(vec.begin() + 2, vec.end());
+  vec.insert(vec.end(), 2, not_safe("filled"));
+  ASSERT_TRUE(vec.is_inline());
+
+  std::stringstream stream;
+  stream << vec;
+  ASSERT_EQ(stream.str(), "inserted emplaced filled filled");
+
+  vec.insert(vec.begin(), not_safe("spilled"));
+  ASSERT_FALSE(vec.is_inline());
+  ASSERT_EQ(vec.size(), 5);
+  ASSERT_EQ(vec.front(), not_safe("spilled"));
+}
+
+TEST(SmallVectorTest, insert_erase_inline) {
+  TargetVector<safe, 16> vec{safe("a"), safe("b"), safe("c")};
+
+  vec.insert(vec.begin() + 1, safe("inserted"));
+  vec.erase(vec.begin());
+  ASSERT_TRUE(vec.is_inline());
+
+  std::stringstream stream;
+  stream << vec;
+  ASSERT_EQ(stream.str(), "inserted b c");
+}
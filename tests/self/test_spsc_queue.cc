@@ -0,0 +1,104 @@
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/spsc_queue.h"
+#include "test_helpers.h"
+
+static_assert(sizeof(sp::spsc_queue<int>) >= 2 * sp::kCacheLineSize,
+              "Producer and consumer positions must not share cache line");
+
+TEST(SpscQueueTest, ctor) {
+  sp::spsc_queue<safe> queue(5);
+  ASSERT_EQ(queue.capacity(), 8);
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.size(), 0);
+  ASSERT_THROW(sp::spsc_queue<int>(0), std::length_error);
+}
+
+TEST(SpscQueueTest, push_front_pop) {
+  sp::spsc_queue<std::string> queue(4);
+  queue.push("a");
+  std::string b = "b";
+  queue.push(b);
+  ASSERT_TRUE(queue.try_emplace(3, 'c'));
+  ASSERT_TRUE(queue.try_push("d"));
+  ASSERT_FALSE(queue.try_push("e"));
+  ASSERT_EQ(queue.size(), 4);
+
+  ASSERT_EQ(queue.front(), "a");
+  queue.pop();
+  std::string out;
+  ASSERT_TRUE(queue.try_pop(out));
+  ASSERT_EQ(out, "b");
+  ASSERT_TRUE(queue.try_push("e"));
+  ASSERT_TRUE(queue.try_push("f"));
+  ASSERT_TRUE(queue.try_pop(out));
+  ASSERT_EQ(out, "ccc");
+  ASSERT_EQ(queue.size(), 3);
+}
+
+TEST(SpscQueueTest, batch) {
+  sp::spsc_queue<int> queue(8);
+  std::vector<int> from(12);
+  for (int i = 0; i < 12; ++i) {
+    from[i] = i;
+  }
+  auto rest = queue.try_push(from.begin(), from.end());
+  ASSERT_EQ(rest - from.begin(), 8);
+
+  std::vector<int> to;
+  ASSERT_EQ(queue.try_pop(std::back_inserter(to), 5), 5);
+  ASSERT_EQ(queue.try_push(rest, from.end()), from.end());
+  ASSERT_EQ(queue.try_pop(std::back_inserter(to), 100), 7);
+  ASSERT_EQ(to, from);
+  ASSERT_EQ(queue.try_pop(std::back_inserter(to), 100), 0);
+}
+
+TEST(SpscQueueTest, throwing_batch) {
+  sp::spsc_queue<throwing> queue(8);
+  std::vector<throwing> from(6);
+  throwing::count = 0;
+  ASSERT_THROW(queue.try_push(from.begin(), from.end()), std::runtime_error);
+  // four copies made it before the fifth threw
+  ASSERT_EQ(queue.size(), 4);
+}
+
+TEST(SpscQueueTest, destroys_rest) {
+  sp::spsc_queue<safe> queue(4);
+  queue.push(safe("a"));
+  queue.push(safe("b"));
+  queue.pop();
+  queue.push(safe("c"));
+}
+
+TEST(SpscQueueTest, threads) {
+  constexpr int kCount = 100000;
+  sp::spsc_queue<int> queue(64);
+  std::thread producer([&queue] {
+    for (int i = 0; i < kCount; ++i) {
+      if (i % 3) {
+        queue.push(i);
+      } else {
+        int batch[1] = {i};
+        while (queue.try_push(batch, batch + 1) == batch) {
+        }
+      }
+    }
+  });
+  int64_t sum = 0;
+  int expected = 0;
+  int value = 0;
+  while (expected < kCount) {
+    if (queue.try_pop(value)) {
+      ASSERT_EQ(value, expected);
+      sum += value;
+      ++expected;
+    }
+  }
+  producer.join();
+  ASSERT_EQ(sum, int64_t(kCount) * (kCount - 1) / 2);
+  ASSERT_TRUE(queue.empty());
+}
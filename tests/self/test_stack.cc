@@ -1,11 +1,12 @@
-#include <gmock/gmock.h>
-#include <gtest/gtest.h>
-
-#include "../s21_containers.h"
 #include <stack>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sp/stack.h"
+#include "sp/vector.h"
 
-TEST(top, test0) {
-  s21::stack<int> test;
+TEST(StackTest, top) {
+  sp::stack<int> test;
   test.push(1);
   test.push(2);
 
@@ -15,8 +16,8 @@ TEST(top, test0) {
   ASSERT_EQ(test.top(), testS.top());
 }
 
-TEST(pop, test0) {
-  s21::stack<int> test;
+TEST(StackTest, pop) {
+  sp::stack<int> test;
   test.push(1);
   test.push(2);
   test.push(3);
@@ -29,22 +30,22 @@ TEST(pop, test0) {
   ASSERT_EQ(test.top(), testS.top());
 }
 
-TEST(empty, test1) {
-  s21::stack<int> test;
+TEST(StackTest, empty) {
+  sp::stack<int> test;
   std::stack<int> testS;
   ASSERT_EQ(test.empty(), testS.empty());
 }
 
-TEST(size, test1) {
-  s21::stack<int> test;
+TEST(StackTest, size) {
+  sp::stack<int> test;
   std::stack<int> testS;
-  ASSERT_EQ(test.size(), testS.size());
+  ASSERT_EQ(test.size(), static_cast<int64_t>(testS.size()));
 }
 
-TEST(swap, test1) {
-  s21::stack<int> test;
+TEST(StackTest, swap) {
+  sp::stack<int> test;
   test.push(1);
-  s21::stack<int> other;
+  sp::stack<int> other;
   other.push(3);
   test.swap(other);
   std::stack<int> testS;
@@ -55,8 +56,24 @@ TEST(swap, test1) {
   ASSERT_EQ(test.top(), testS.top());
 }
 
-int main(int argc, char **argv) {
-  ::testing::InitGoogleTest(&argc, argv);
+TEST(StackTest, lifo_order) {
+  sp::stack<std::string> test{"a", "b"};
+  ASSERT_EQ(test.emplace(3, 'c'), "ccc");
+  for (int i = 0; i < 100; ++i) {
+    test.push(std::to_string(i));
+  }
+  for (int i = 99; i >= 0; --i) {
+    ASSERT_EQ(test.top(), std::to_string(i));
+    test.pop();
+  }
+  ASSERT_EQ(test.size(), 3);
+  ASSERT_EQ(test.top(), "ccc");
+}
 
-  return RUN_ALL_TESTS();
-}
\ No newline at end of file
+TEST(StackTest, vector_container) {
+  sp::stack<int, sp::vector<int>> test(sp::vector<int>{1, 2, 3});
+  test.push(4);
+  test.pop();
+  ASSERT_EQ(test.top(), 3);
+  ASSERT_EQ(test, (sp::stack<int, sp::vector<int>>{1, 2, 3}));
+}
@@ -1,19 +1,242 @@
-#include <gmock/gmock.h>
-#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
 
-#include "../containers/s21_red_black_tree.h"
+#include "gtest/gtest.h"
+#include "sp/red_black_tree.h"
+#include "test_helpers.h"
 
-TEST(RBTreeTest, insert_1) {
-  s21::RedBlackTree<int, int> tree;
-  tree.insert(3, 3);
-  tree.insert(1, 1);
-  tree.insert(5, 5);
-  s21::RedBlackTree<int, int> true_tree;
-  // Нужно придумать как сделать тесты...
+template <typename T, typename Al = std::allocator<T>, int64_t SlabSize = 0>
+using TargetTree =
+    sp::red_black_tree<T, T, sp::identity_key, std::less<T>, Al, SlabSize>;
+
+TEST(TreeTest, empty) {
+  TargetTree<int> tree;
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.size(), 0);
+  ASSERT_EQ(tree.begin(), tree.end());
+  ASSERT_TRUE(tree.integrity());
+}
+
+TEST(TreeTest, insert_ascending) {
+  TargetTree<int> tree;
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(tree.insert_unique(i).second);
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_EQ(tree.size(), 1000);
+  int expected = 0;
+  for (int val : tree) {
+    ASSERT_EQ(val, expected++);
+  }
+}
+
+TEST(TreeTest, insert_duplicate) {
+  TargetTree<int> tree;
+  auto first = tree.insert_unique(5);
+  auto second = tree.insert_unique(5);
+  ASSERT_TRUE(first.second);
+  ASSERT_FALSE(second.second);
+  ASSERT_EQ(first.first, second.first);
+  ASSERT_FALSE(tree.emplace_unique(5).second);
+  ASSERT_EQ(tree.size(), 1);
+}
+
+TEST(TreeTest, iterate_backwards) {
+  TargetTree<int> tree;
+  for (int i : {5, 1, 9, 3, 7}) {
+    tree.insert_unique(i);
+  }
+  std::vector<int> values;
+  for (auto pos = tree.end(); pos != tree.begin();) {
+    values.push_back(*--pos);
+  }
+  ASSERT_EQ(values, std::vector<int>({9, 7, 5, 3, 1}));
 }
 
-int main(int argc, char **argv) {
-  ::testing::InitGoogleTest(&argc, argv);
+TEST(TreeTest, random_insert_erase) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> values(0, 500);
+  TargetTree<int> tree;
+  std::set<int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    int val = values(gen);
+    if (gen() % 3) {
+      ASSERT_EQ(tree.insert_unique(val).second, expected.insert(val).second);
+    } else {
+      ASSERT_EQ(tree.erase_key(val), int64_t(expected.erase(val)));
+    }
+    if (i % 50 == 0) {
+      ASSERT_TRUE(tree.integrity());
+    }
+  }
+  ASSERT_TRUE(tree.integrity());
+  ASSERT_EQ(tree.size(), int64_t(expected.size()));
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(TreeTest, erase_all) {
+  TargetTree<int> tree;
+  for (int i = 0; i < 200; ++i) {
+    tree.insert_unique((i * 37) % 200);
+  }
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_EQ(tree.erase_key((i * 11) % 200), 1);
+    ASSERT_TRUE(tree.integrity());
+  }
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.begin(), tree.end());
+}
+
+TEST(TreeTest, erase_range) {
+  TargetTree<int> tree;
+  for (int i = 0; i < 100; ++i) {
+    tree.insert_unique(i);
+  }
+  auto pos = tree.erase(tree.lower_bound(10), tree.upper_bound(89));
+  ASSERT_EQ(*pos, 90);
+  ASSERT_EQ(tree.size(), 20);
+  ASSERT_TRUE(tree.integrity());
+
+  tree.erase(tree.begin(), tree.end());
+  ASSERT_TRUE(tree.empty());
+  ASSERT_TRUE(tree.integrity());
+}
+
+TEST(TreeTest, bounds) {
+  TargetTree<int> tree;
+  for (int i = 0; i < 10; ++i) {
+    tree.insert_unique(i * 10);
+  }
+  ASSERT_EQ(*tree.lower_bound(30), 30);
+  ASSERT_EQ(*tree.upper_bound(30), 40);
+  ASSERT_EQ(*tree.lower_bound(31), 40);
+  ASSERT_EQ(tree.lower_bound(91), tree.end());
+  ASSERT_EQ(tree.find(35), tree.end());
+  ASSERT_TRUE(tree.contains(90));
+}
 
-  return RUN_ALL_TESTS();
-}
\ No newline at end of file
+TEST(TreeTest, copy_move_swap) {
+  TargetTree<safe> tree1;
+  for (int i = 0; i < 50; ++i) {
+    tree1.insert_unique(safe(std::to_string(i)));
+  }
+  TargetTree<safe> tree2(tree1);
+  ASSERT_TRUE(tree2.integrity());
+  ASSERT_TRUE(std::equal(tree1.begin(), tree1.end(), tree2.begin(),
+                         tree2.end()));
+
+  TargetTree<safe> tree3(std::move(tree1));
+  ASSERT_TRUE(tree1.empty());
+  ASSERT_TRUE(tree1.integrity());
+  ASSERT_EQ(tree3.size(), 50);
+  ASSERT_TRUE(tree3.integrity());
+
+  TargetTree<safe> tree4;
+  tree4.swap(tree3);
+  ASSERT_TRUE(tree3.empty());
+  ASSERT_TRUE(tree3.integrity());
+  ASSERT_EQ(tree4.size(), 50);
+  ASSERT_TRUE(tree4.integrity());
+
+  tree1 = tree4;
+  tree3 = std::move(tree4);
+  ASSERT_EQ(tree1.size(), 50);
+  ASSERT_EQ(tree3.size(), 50);
+  ASSERT_TRUE(tree1.integrity());
+  ASSERT_TRUE(tree3.integrity());
+}
+
+TEST(TreeTest, copy_throwing) {
+  TargetTree<throwing> tree1;
+  for (int i = 0; i < 20; ++i) {
+    try {
+      tree1.insert_unique(throwing(std::to_string(i)));
+    } catch (const std::runtime_error&) {
+    }
+  }
+  ASSERT_TRUE(tree1.integrity());
+  ASSERT_THROW(TargetTree<throwing> tree2(tree1), std::runtime_error);
+}
+
+TEST(TreeTest, destroy_large) {
+  alloc_record record;
+  {
+    recording_allocator<int> al(&record);
+    TargetTree<int, recording_allocator<int>> tree(std::less<int>(), al);
+    for (int i = 0; i < 100000; ++i) {
+      tree.insert_unique(i);
+    }
+    tree.erase(tree.begin(), std::next(tree.begin(), 1000));
+    ASSERT_EQ(record.live, 99000);
+  }
+  ASSERT_EQ(record.live, 0);
+}
+
+TEST(TreeTest, clone_throwing_releases) {
+  alloc_record record;
+  recording_allocator<throwing> al(&record);
+  TargetTree<throwing, recording_allocator<throwing>> tree1(
+      std::less<throwing>(), al);
+  for (int i = 0; i < 20; ++i) {
+    try {
+      tree1.insert_unique(throwing(std::to_string(i)));
+    } catch (const std::runtime_error&) {
+    }
+  }
+  int64_t live = record.live;
+  ASSERT_THROW(auto tree2(tree1), std::runtime_error);
+  ASSERT_EQ(record.live, live);
+}
+
+TEST(TreeTest, slab_chunks) {
+  alloc_record record;
+  recording_allocator<int> al(&record);
+  TargetTree<int, recording_allocator<int>, 16> tree(std::less<int>(), al);
+  for (int i = 0; i < 100; ++i) {
+    tree.insert_unique(i);
+  }
+  ASSERT_EQ(record.calls, 7);
+  tree.erase(tree.begin(), tree.find(50));
+  for (int i = 100; i < 150; ++i) {
+    tree.insert_unique(i);
+  }
+  ASSERT_EQ(record.calls, 7);
+  ASSERT_EQ(tree.size(), 100);
+  ASSERT_TRUE(tree.integrity());
+  tree.clear();
+  ASSERT_EQ(record.live, 0);
+  ASSERT_TRUE(tree.integrity());
+  tree.insert_unique(1);
+  ASSERT_EQ(record.live, 1);
+}
+
+TEST(TreeTest, slab_destroys_values) {
+  alloc_record record;
+  {
+    recording_allocator<safe> al(&record);
+    TargetTree<safe, recording_allocator<safe>, 8> tree1(std::less<safe>(),
+                                                         al);
+    for (int i = 0; i < 50; ++i) {
+      tree1.insert_unique(safe(std::to_string(i)));
+    }
+    tree1.erase_key(safe("7"));
+    TargetTree<safe, recording_allocator<safe>, 8> tree2(tree1);
+    TargetTree<safe, recording_allocator<safe>, 8> tree3(std::move(tree1));
+    ASSERT_TRUE(tree1.empty());
+    ASSERT_EQ(tree2.size(), 49);
+    ASSERT_EQ(tree3.size(), 49);
+    tree1.swap(tree3);
+    ASSERT_TRUE(tree1.integrity());
+    ASSERT_TRUE(tree3.integrity());
+    tree2 = tree1;
+    ASSERT_TRUE(std::equal(tree1.begin(), tree1.end(), tree2.begin(),
+                           tree2.end()));
+  }
+  ASSERT_EQ(record.live, 0);
+}
@@ -0,0 +1,222 @@
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "sp/unordered_map.h"
+#include "test_helpers.h"
+
+template <typename K, typename T, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+using TargetMap = sp::unordered_map<K, T, Hash, KeyEqual>;
+
+// hashes strings and string views alike
+struct string_hash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view str) const {
+    return std::hash<std::string_view>()(str);
+  }
+};
+
+TEST(UnorderedMapTest, ctor_default) {
+  TargetMap<int, safe> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.size(), 0);
+  ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST(UnorderedMapTest, ctor_init_list) {
+  TargetMap<int, std::string> map{{3, "three"}, {1, "one"}, {2, "two"},
+                                  {1, "uno"}};
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_EQ(map.at(1), "one");
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_TRUE(map.integrity());
+}
+
+TEST(UnorderedMapTest, ctor_copy_move) {
+  TargetMap<std::string, safe> map1{{"a", safe("1")}, {"b", safe("2")}};
+  TargetMap<std::string, safe> map2(map1);
+  ASSERT_EQ(map1, map2);
+
+  TargetMap<std::string, safe> map3(std::move(map1));
+  ASSERT_TRUE(map1.empty());
+  ASSERT_EQ(map3, map2);
+
+  map1 = map3;
+  map3 = std::move(map2);
+  ASSERT_EQ(map1, map3);
+  ASSERT_TRUE(map1.integrity());
+}
+
+TEST(UnorderedMapTest, at) {
+  TargetMap<int, int> map{{1, 10}};
+  ASSERT_EQ(map.at(1), 10);
+  ASSERT_THROW(map.at(2), std::out_of_range);
+  const auto& cmap = map;
+  ASSERT_THROW(cmap.at(2), std::out_of_range);
+}
+
+TEST(UnorderedMapTest, subscript) {
+  TargetMap<std::string, int> map;
+  map["one"] = 1;
+  ++map["one"];
+  map["zero"];
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map["one"], 2);
+  ASSERT_EQ(map.at("zero"), 0);
+}
+
+TEST(UnorderedMapTest, insert) {
+  TargetMap<int, std::string> map;
+  auto result = map.insert({1, "one"});
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(result.first->second, "one");
+
+  result = map.insert({1, "uno"});
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, "one");
+
+  result = map.insert_or_assign(1, "uno");
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(map.at(1), "uno");
+}
+
+TEST(UnorderedMapTest, try_emplace_keeps_argument) {
+  TargetMap<int, std::string> map{{1, "one"}};
+  std::string value("moved");
+  ASSERT_FALSE(map.try_emplace(1, std::move(value)).second);
+  ASSERT_EQ(value, "moved");
+  ASSERT_TRUE(map.try_emplace(2, std::move(value)).second);
+  ASSERT_EQ(map.at(2), "moved");
+}
+
+TEST(UnorderedMapTest, emplace) {
+  TargetMap<int, std::string> map;
+  ASSERT_TRUE(map.emplace(1, "one").second);
+  ASSERT_FALSE(map.emplace(1, "uno").second);
+  ASSERT_EQ(map.at(1), "one");
+}
+
+TEST(UnorderedMapTest, erase) {
+  TargetMap<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  ASSERT_EQ(map.erase(50), 1);
+  ASSERT_EQ(map.erase(50), 0);
+  auto next = std::next(map.find(10));
+  ASSERT_EQ(map.erase(map.find(10)), next);
+  for (auto pos = map.begin(); pos != map.end();) {
+    pos = pos->first >= 60 ? map.erase(pos) : std::next(pos);
+  }
+  ASSERT_EQ(map.size(), 58);
+  ASSERT_TRUE(map.integrity());
+}
+
+TEST(UnorderedMapTest, lookup) {
+  TargetMap<int, int> map{{10, 1}, {20, 2}, {30, 3}};
+  ASSERT_EQ(map.count(20), 1);
+  ASSERT_EQ(map.count(25), 0);
+  ASSERT_TRUE(map.contains(30));
+  ASSERT_EQ(map.find(25), map.end());
+  auto range = map.equal_range(20);
+  ASSERT_EQ(range.first->first, 20);
+  ASSERT_EQ(std::next(range.first), range.second);
+  range = map.equal_range(25);
+  ASSERT_EQ(range.first, range.second);
+}
+
+TEST(UnorderedMapTest, heterogeneous_lookup) {
+  TargetMap<std::string, int, string_hash, std::equal_to<>> map{
+      {"alpha", 1}, {"beta", 2}};
+  std::string_view key("beta");
+  ASSERT_EQ(map.find(key)->second, 2);
+  ASSERT_TRUE(map.contains("alpha"));
+  ASSERT_EQ(map.count(std::string_view("gamma")), 0);
+  ASSERT_EQ(map.erase(key), 1);
+  ASSERT_EQ(map.size(), 1);
+}
+
+TEST(UnorderedMapTest, matches_std) {
+  TargetMap<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 503;
+    if (i % 4 == 3) {
+      ASSERT_EQ(map.erase(key), int64_t(expected.erase(key)));
+    } else {
+      map[key] += i;
+      expected[key] += i;
+    }
+  }
+  ASSERT_TRUE(map.integrity());
+  ASSERT_EQ(map.size(), int64_t(expected.size()));
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(map.at(key), value);
+  }
+}
+
+TEST(UnorderedMapTest, swap) {
+  TargetMap<int, int> map1{{1, 1}};
+  TargetMap<int, int> map2{{2, 2}, {3, 3}};
+  map1.swap(map2);
+  ASSERT_EQ(map1.size(), 2);
+  ASSERT_EQ(map2.begin()->first, 1);
+  ASSERT_TRUE(map1.contains(3));
+  ASSERT_TRUE(map1.integrity());
+  ASSERT_TRUE(map2.integrity());
+}
+
+TEST(UnorderedMapTest, string_keys) {
+  TargetMap<std::string, std::string> map;
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 5000; ++i) {
+    std::string key = "key number " + std::to_string((i * 7919) % 2003);
+    if (i % 5 == 4) {
+      ASSERT_EQ(map.erase(key), int64_t(expected.erase(key)));
+    } else {
+      map.insert_or_assign(key, std::to_string(i));
+      expected.insert_or_assign(key, std::to_string(i));
+    }
+  }
+  ASSERT_TRUE(map.integrity());
+  ASSERT_EQ(map.size(), int64_t(expected.size()));
+  for (const auto& [key, value] : map) {
+    ASSERT_EQ(value, expected.at(key));
+  }
+}
+
+TEST(UnorderedMapTest, buckets) {
+  TargetMap<int, int> map(100);
+  int64_t buckets = map.bucket_count();
+  ASSERT_GE(float(buckets) * map.max_load_factor(), 100.0f);
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  ASSERT_EQ(map.bucket_count(), buckets);
+  ASSERT_LE(map.load_factor(), map.max_load_factor());
+  map.reserve(1000);
+  ASSERT_GT(map.bucket_count(), buckets);
+  map.clear();
+  map.rehash(0);
+  ASSERT_EQ(map.bucket_count(), 0);
+  ASSERT_EQ(map.load_factor(), 0.0f);
+}
+
+TEST(UnorderedMapTest, equality_ignores_order) {
+  TargetMap<int, std::string> map1;
+  TargetMap<int, std::string> map2(1000);
+  for (int i = 0; i < 100; ++i) {
+    map1[i] = std::to_string(i);
+    map2[99 - i] = std::to_string(99 - i);
+  }
+  ASSERT_EQ(map1, map2);
+  map2[5] = "five";
+  ASSERT_NE(map1, map2);
+}
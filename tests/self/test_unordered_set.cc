@@ -0,0 +1,110 @@
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/unordered_set.h"
+#include "test_helpers.h"
+
+template <typename K, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+using TargetSet = sp::unordered_set<K, Hash, KeyEqual>;
+
+// hashes strings and string views alike
+struct string_hash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view str) const {
+    return std::hash<std::string_view>()(str);
+  }
+};
+
+TEST(UnorderedSetTest, ctor_default) {
+  TargetSet<std::string> set;
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.size(), 0);
+  ASSERT_EQ(set.begin(), set.end());
+}
+
+TEST(UnorderedSetTest, ctor_range) {
+  std::vector<int> from{5, 3, 5, 1, 3};
+  TargetSet<int> set(from.begin(), from.end());
+  ASSERT_EQ(set.size(), 3);
+  ASSERT_TRUE(set.contains(1));
+  ASSERT_TRUE(set.integrity());
+}
+
+TEST(UnorderedSetTest, ctor_copy_move) {
+  TargetSet<std::string> set1{"a", "b", "c"};
+  TargetSet<std::string> set2(set1);
+  ASSERT_EQ(set1, set2);
+
+  TargetSet<std::string> set3(std::move(set1));
+  ASSERT_TRUE(set1.empty());
+  ASSERT_EQ(set3, set2);
+
+  set1 = set3;
+  set3 = std::move(set2);
+  ASSERT_EQ(set1, set3);
+}
+
+TEST(UnorderedSetTest, insert) {
+  TargetSet<std::string> set;
+  ASSERT_TRUE(set.insert(std::string("one")).second);
+  auto result = set.insert(std::string("one"));
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(*result.first, "one");
+  ASSERT_TRUE(set.emplace(3, 't').second);
+  ASSERT_TRUE(set.contains("ttt"));
+  ASSERT_EQ(set.size(), 2);
+}
+
+TEST(UnorderedSetTest, erase) {
+  TargetSet<int> set{1, 2, 3, 4, 5};
+  ASSERT_EQ(set.erase(3), 1);
+  ASSERT_EQ(set.erase(3), 0);
+  auto next = std::next(set.begin());
+  ASSERT_EQ(set.erase(set.begin()), next);
+  set.erase(set.begin(), set.end());
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.integrity());
+}
+
+TEST(UnorderedSetTest, lookup) {
+  TargetSet<int> set{10, 20, 30};
+  ASSERT_EQ(set.count(20), 1);
+  ASSERT_FALSE(set.contains(25));
+  ASSERT_EQ(*set.find(30), 30);
+  ASSERT_EQ(set.find(40), set.end());
+  auto range = set.equal_range(20);
+  ASSERT_EQ(std::distance(range.first, range.second), 1);
+}
+
+TEST(UnorderedSetTest, heterogeneous_lookup) {
+  TargetSet<std::string, string_hash, std::equal_to<>> set{"alpha", "beta"};
+  ASSERT_TRUE(set.contains(std::string_view("beta")));
+  ASSERT_EQ(*set.find("alpha"), "alpha");
+  ASSERT_EQ(set.erase(std::string_view("alpha")), 1);
+  ASSERT_EQ(set.size(), 1);
+}
+
+TEST(UnorderedSetTest, matches_std) {
+  TargetSet<int> set;
+  std::set<int> expected;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 701;
+    if (i % 3 == 2) {
+      ASSERT_EQ(set.erase(key), int64_t(expected.erase(key)));
+    } else {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ASSERT_TRUE(set.integrity());
+  ASSERT_EQ(set.size(), int64_t(expected.size()));
+  for (int key : expected) {
+    ASSERT_TRUE(set.contains(key));
+  }
+}
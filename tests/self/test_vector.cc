@@ -1,12 +1,20 @@
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <list>
+#include <numeric>
 #include <random>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "sp/array.h"
+#include "sp/default_init_allocator.h"
 #include "sp/pool_allocator.h"
 #include "sp/vector.h"
 #include "test_helpers.h"
@@ -26,6 +34,20 @@ constexpr int loop = LOOP_COUNT;
 constexpr int loop = 15;
 #endif
 
+static_assert(!std::is_polymorphic<sp::vector<int>>::value,
+              "Vector must not carry vtable pointer");
+static_assert(sizeof(sp::vector<int>) == 3 * sizeof(void *),
+              "Vector with stateless allocator must be 3 words long");
+static_assert(sizeof(sp::array<sp::vector<int>, 4>) ==
+                  4 * sizeof(sp::vector<int>),
+              "Vectors must pack tightly");
+static_assert(std::contiguous_iterator<sp::vector<int>::iterator> &&
+                  std::contiguous_iterator<sp::vector<int>::const_iterator>,
+              "Vector iterators must be contiguous");
+static_assert(std::ranges::contiguous_range<sp::vector<int>> &&
+                  std::ranges::sized_range<const sp::vector<int>>,
+              "Vector must be contiguous sized range");
+
 // constexpr int constexpr_check(int val) {
 //   sp::vector<int> vec = {1, 2, 3, 4, 5};
 //   vec.emplace(vec.end(), 7);
@@ -1113,6 +1135,50 @@ TEST(VectorTest, resize_random) {
     }
   }
 }
+TEST(VectorTest, resize_for_overwrite) {
+  sp::vector<uint8_t> buf{1, 2, 3};
+
+  buf.resize_for_overwrite(1000);
+  ASSERT_EQ(buf.size(), 1000);
+  ASSERT_EQ(buf[0], 1);
+  ASSERT_EQ(buf[2], 3);
+  std::fill(buf.begin() + 3, buf.end(), 7);
+  buf.resize_for_overwrite(2);
+  ASSERT_EQ(buf, sp::vector<uint8_t>({1, 2}));
+  buf.resize_for_overwrite(500);
+  ASSERT_EQ(buf.capacity(), 1000);
+  ASSERT_EQ(buf.size(), 500);
+
+  // non trivial elements are still default constructed
+  sp::vector<safe> vec(int64_t(2), safe("value"));
+  vec.resize_for_overwrite(5);
+  ASSERT_EQ(vec[1], safe("value"));
+  for (int64_t i = 2; i < vec.size(); ++i) {
+    ASSERT_EQ(vec[i], safe());
+    ASSERT_EQ(vec[i].birth, constructed::kDef);
+  }
+}
+
+TEST(VectorTest, default_init_allocator) {
+  using allocator = sp::default_init_allocator<float>;
+  sp::vector<float, allocator> vec(int64_t(100));
+  ASSERT_EQ(vec.size(), 100);
+  std::fill(vec.begin(), vec.end(), 1.5f);
+
+  vec.resize(300);
+  vec.push_back(2.5f);
+  ASSERT_EQ(vec.size(), 301);
+  ASSERT_EQ(vec[99], 1.5f);
+  ASSERT_EQ(vec.back(), 2.5f);
+
+  sp::vector<float, allocator> copy(vec);
+  ASSERT_EQ(copy, vec);
+  vec.resize(50, 0.5f);
+  ASSERT_EQ(vec.size(), 50);
+  ASSERT_EQ(vec[49], 1.5f);
+  ASSERT_TRUE(vec.get_allocator() == allocator());
+}
+
 //==============================================================================
 // modifiers
 
@@ -1269,6 +1335,29 @@ TEST(VectorTest, insert_counted_no_realloc) {
   }
 }
 
+TEST(VectorTest, insert_counted_basic_no_realloc) {
+  sp::vector<basic_not_safe> vec(77);
+  basic_not_safe *ptr = vec.data();
+  vec.resize(25);
+
+  int64_t insert = 8;
+  int64_t count = 9;
+
+  auto pos = vec.insert(vec.begin() + insert, count, basic_not_safe("in"));
+
+  ASSERT_EQ(vec.size(), 25 + count);
+  ASSERT_EQ(vec.capacity(), 77);
+  ASSERT_EQ(vec.data(), ptr);
+  ASSERT_EQ(pos, vec.begin() + insert);
+  for (auto i = vec.begin(); i != vec.end(); ++i) {
+    if (i < pos || i >= pos + count) {
+      ASSERT_EQ(*i, basic_not_safe());
+    } else {
+      ASSERT_EQ(*i, basic_not_safe("in"));
+    }
+  }
+}
+
 TEST(VectorTest, insert_counted_throwing) {
   throwing::count = 0;
   int64_t size = 4;
@@ -1516,6 +1605,57 @@ TEST(VectorTest, erase_throwing) {
   }
 }
 
+TEST(VectorTest, erase_basic_no_realloc) {
+  int64_t size = uid(gen) + 1;
+  sp::pool_allocator<basic_not_safe> al(size);
+  sp::vector<basic_not_safe, sp::pool_allocator<basic_not_safe>> vec(size, al);
+  vec.back() = basic_not_safe("last");
+  basic_not_safe *ptr = vec.data();
+
+  auto pos = vec.erase(vec.begin());
+
+  ASSERT_EQ(pos, vec.begin());
+  ASSERT_EQ(vec.size(), size - 1);
+  ASSERT_EQ(vec.capacity(), size);
+  ASSERT_EQ(vec.data(), ptr);
+  ASSERT_EQ(al.allocd(), size);
+  if (size > 1) {
+    ASSERT_EQ(vec.back(), basic_not_safe("last"));
+  }
+}
+
+TEST(VectorTest, erase_range_basic_no_realloc) {
+  sp::vector<basic_not_safe> vec(10);
+  vec[5] = basic_not_safe("fifth");
+  basic_not_safe *ptr = vec.data();
+
+  auto pos = vec.erase(vec.begin() + 2, vec.begin() + 5);
+
+  ASSERT_EQ(pos, vec.begin() + 2);
+  ASSERT_EQ(*pos, basic_not_safe("fifth"));
+  ASSERT_EQ(vec.size(), 7);
+  ASSERT_EQ(vec.capacity(), 10);
+  ASSERT_EQ(vec.data(), ptr);
+  for (const basic_not_safe &ob : vec) {
+    ASSERT_EQ(ob.birth, constructed::kDef);
+  }
+}
+
+TEST(VectorTest, erase_basic_throwing) {
+  throwing::count = 0;
+  sp::vector<basic_throwing> vec(10);
+  basic_throwing *ptr = vec.data();
+
+  ASSERT_ANY_THROW(vec.erase(vec.begin() + 2, vec.begin() + 4));
+
+  ASSERT_EQ(vec.size(), 10);
+  ASSERT_EQ(vec.capacity(), 10);
+  ASSERT_EQ(vec.data(), ptr);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_NO_THROW(vec.at(i));
+  }
+}
+
 TEST(VectorTest, erase_to_empty) {
   int64_t size = uid(gen);
   sp::vector<safe> vec(size);
@@ -1744,6 +1884,68 @@ TEST(VectorTest, emplace_no_realloc) {
   ASSERT_EQ(vec.back().birth, constructed::kMove);
 }
 
+TEST(VectorTest, emplace_not_safe_keeps_capacity) {
+  sp::vector<not_safe> vec(54);
+  vec.resize(50);
+
+  for (int i = 0; i < 4; ++i) {
+    auto pos = vec.emplace(vec.begin() + 31, "inserted");
+    ASSERT_EQ(*pos, not_safe("inserted"));
+  }
+  ASSERT_EQ(vec.size(), 54);
+  ASSERT_EQ(vec.capacity(), 54);
+}
+
+TEST(VectorTest, emplace_basic_no_realloc) {
+  sp::pool_allocator<basic_not_safe> al(54);
+  sp::vector<basic_not_safe, sp::pool_allocator<basic_not_safe>> vec(54, al);
+  basic_not_safe *ptr = vec.data();
+  vec.resize(50);
+  vec.back() = basic_not_safe("last");
+
+  for (int i = 0; i < 4; ++i) {
+    auto pos = vec.emplace(vec.begin() + 31, "inserted");
+    ASSERT_EQ(pos, vec.begin() + 31);
+    ASSERT_EQ(*pos, basic_not_safe("inserted"));
+  }
+  ASSERT_EQ(vec.size(), 54);
+  ASSERT_EQ(vec.capacity(), 54);
+  ASSERT_EQ(vec.data(), ptr);
+  ASSERT_EQ(al.allocd(), 54);
+  ASSERT_EQ(vec.back(), basic_not_safe("last"));
+  for (int i = 31; i < 35; ++i) {
+    ASSERT_EQ(vec[i], basic_not_safe("inserted"));
+  }
+}
+
+TEST(VectorTest, emplace_basic_throwing) {
+  throwing::count = 0;
+  sp::vector<basic_throwing> vec(10);
+  basic_throwing *ptr = vec.data();
+  vec.resize(8);
+
+  ASSERT_ANY_THROW(vec.emplace(vec.begin(), "pushed"));
+
+  ASSERT_EQ(vec.size(), 8);
+  ASSERT_EQ(vec.capacity(), 10);
+  ASSERT_EQ(vec.data(), ptr);
+  for (auto i = 0; i < 8; ++i) {
+    ASSERT_NO_THROW(vec.at(i));
+  }
+}
+
+TEST(VectorTest, emplace_reserved_empty) {
+  sp::vector<safe> vec;
+  vec.reserve(10);
+
+  auto pos = vec.emplace(vec.begin(), "inserted");
+
+  ASSERT_EQ(pos, vec.begin());
+  ASSERT_EQ(vec.size(), 1);
+  ASSERT_EQ(vec.capacity(), 10);
+  ASSERT_EQ(vec.front(), safe("inserted"));
+}
+
 TEST(VectorTest, emplace_no_def) {
   sp::vector<no_def> vec;
   for (int i = 0; i < loop; ++i) {
@@ -1850,6 +2052,222 @@ TEST(VectorTest, emplace_back_throwing) {
   }
 }
 
+TEST(VectorTest, relocate_emplace_back) {
+  int64_t size = uid(gen);
+  sp::vector<relocatable> vec(size);
+
+  relocatable &val = vec.emplace_back(7);
+  ASSERT_EQ(val, relocatable(7));
+  ASSERT_EQ(val.birth, constructed::kParam);
+  for (int64_t i = 0; i < size; ++i) {
+    ASSERT_EQ(vec[i], relocatable());
+    ASSERT_EQ(vec[i].birth, constructed::kDef);
+  }
+}
+
+TEST(VectorTest, relocate_reserve) {
+  int64_t size = uid(gen);
+  sp::vector<relocatable> vec(size);
+
+  vec.reserve(size * 2);
+  ASSERT_EQ(vec.size(), size);
+  ASSERT_EQ(vec.capacity(), size * 2);
+  for (const relocatable &ob : vec) {
+    ASSERT_EQ(ob, relocatable());
+    ASSERT_EQ(ob.birth, constructed::kDef);
+  }
+}
+
+TEST(VectorTest, relocate_insert) {
+  sp::vector<relocatable> vec(54);
+  int64_t insert = 31;
+
+  auto pos = vec.insert(vec.begin() + insert, relocatable(7));
+
+  ASSERT_EQ(vec.size(), 55);
+  ASSERT_EQ(*pos, relocatable(7));
+  for (auto i = vec.begin(); i != vec.end(); ++i) {
+    if (i != pos) {
+      ASSERT_EQ(*i, relocatable());
+      ASSERT_EQ(i->birth, constructed::kDef);
+    }
+  }
+}
+
+TEST(VectorTest, bulk_copy) {
+  sp::vector<double> vec(1000);
+  ASSERT_TRUE(std::all_of(vec.begin(), vec.end(),
+                          [](double val) { return val == 0.0; }));
+  std::iota(vec.begin(), vec.end(), 0.0);
+
+  sp::vector<double> copy(vec);
+  ASSERT_EQ(copy, vec);
+  std::vector<double> stl(vec.begin(), vec.end());
+  sp::vector<double> from_stl(stl.begin(), stl.end());
+  ASSERT_EQ(from_stl, vec);
+
+  sp::vector<double> filled(int64_t(1000), 2.5);
+  ASSERT_TRUE(std::all_of(filled.begin(), filled.end(),
+                          [](double val) { return val == 2.5; }));
+  filled = vec;
+  ASSERT_EQ(filled, vec);
+}
+
+TEST(VectorTest, bulk_assign) {
+  sp::vector<int> vec(int64_t(100), 1);
+  vec.reserve(1000);
+
+  vec.assign(int64_t(500), 7);
+  ASSERT_EQ(vec.size(), 500);
+  ASSERT_EQ(vec.capacity(), 1000);
+  ASSERT_TRUE(std::all_of(vec.begin(), vec.end(),
+                          [](int val) { return val == 7; }));
+  vec.assign(int64_t(10), 0);
+  ASSERT_EQ(vec, sp::vector<int>(int64_t(10), 0));
+
+  sp::vector<int> source(700);
+  std::iota(source.begin(), source.end(), 0);
+  vec.assign(source.begin(), source.end());
+  ASSERT_EQ(vec, source);
+  vec.assign(vec.begin() + 200, vec.end());
+  ASSERT_EQ(vec.size(), 500);
+  ASSERT_EQ(vec.front(), 200);
+  ASSERT_EQ(vec.back(), 699);
+  vec.assign({1, 2, 3});
+  ASSERT_EQ(vec, sp::vector<int>({1, 2, 3}));
+}
+
+TEST(VectorTest, bulk_insert) {
+  sp::vector<int> vec{1, 2, 3, 4};
+  vec.reserve(16);
+  std::vector<int> source{5, 6, 7};
+
+  auto pos = vec.insert(vec.begin() + 1, source.begin(), source.end());
+  ASSERT_EQ(pos - vec.begin(), 1);
+  ASSERT_EQ(vec, sp::vector<int>({1, 5, 6, 7, 2, 3, 4}));
+  vec.insert(vec.end(), {8, 9});
+  ASSERT_EQ(vec, sp::vector<int>({1, 5, 6, 7, 2, 3, 4, 8, 9}));
+  vec.insert(vec.begin(), source.begin(), source.begin());
+  ASSERT_EQ(vec.size(), 9);
+  ASSERT_EQ(vec.capacity(), 16);
+
+  sp::vector<int> empty;
+  empty.insert(empty.begin(), source.begin(), source.end());
+  ASSERT_EQ(empty, sp::vector<int>({5, 6, 7}));
+}
+
+TEST(VectorTest, bulk_equal) {
+  sp::vector<int> vec1(int64_t(300), 7);
+  sp::vector<int> vec2(vec1);
+  ASSERT_EQ(vec1, vec2);
+  vec2[250] = 8;
+  ASSERT_NE(vec1, vec2);
+  ASSERT_EQ(sp::vector<int>(), sp::vector<int>());
+
+  // floats compare by value, not by bytes
+  sp::vector<float> floats1(int64_t(100), 0.0f);
+  sp::vector<float> floats2(int64_t(100), -0.0f);
+  ASSERT_EQ(floats1, floats2);
+  floats1[99] = floats2[99] = std::nanf("");
+  ASSERT_NE(floats1, floats2);
+}
+
+// Provides own construct, so vector may not copy bytewise
+int counted_constructs = 0;
+struct counting_allocator : std::allocator<int> {
+  template <typename U>
+  struct rebind {
+    using other = counting_allocator;
+  };
+  template <typename... Args>
+  void construct(int *ptr, Args &&...args) {
+    ++counted_constructs;
+    ::new (ptr) int(std::forward<Args>(args)...);
+  }
+};
+
+TEST(VectorTest, bulk_copy_custom_construct) {
+  sp::vector<int, counting_allocator> vec(int64_t(10), 1);
+  sp::vector<int, counting_allocator> copy(vec);
+  ASSERT_EQ(counted_constructs, 20);
+  ASSERT_EQ(copy, vec);
+}
+
+TEST(VectorTest, growth_one_and_half) {
+  sp::vector<int, std::allocator<int>, sp::one_and_half_growth> vec(10);
+
+  vec.push_back(1);
+  ASSERT_EQ(vec.capacity(), 15);
+  vec.insert(vec.begin(), int64_t(5), 0);
+  ASSERT_EQ(vec.capacity(), 22);
+  vec.assign(int64_t(40), 1);
+  ASSERT_EQ(vec.capacity(), 40);
+}
+
+TEST(VectorTest, growth_power_of_two) {
+  struct triple {
+    int a, b, c;
+  };
+  sp::vector<triple, std::allocator<triple>, sp::power_of_two_growth> vec;
+
+  for (int i = 0; i < loop * 10; ++i) {
+    vec.push_back({i, i, i});
+    uint64_t bytes = vec.capacity() * sizeof(triple);
+    ASSERT_GE(vec.capacity(), vec.size());
+    ASSERT_LT(std::bit_ceil(bytes) - bytes, sizeof(triple));
+  }
+  ASSERT_EQ(vec.back().a, loop * 10 - 1);
+}
+
+TEST(VectorTest, growth_capped) {
+  using policy = sp::capped_growth<64>;
+  sp::vector<int, std::allocator<int>, policy> vec(8);
+
+  vec.push_back(1);
+  ASSERT_EQ(vec.capacity(), 16);
+  vec.resize(16);
+  vec.push_back(1);
+  ASSERT_EQ(vec.capacity(), 32);
+  ASSERT_EQ(policy::grow(1000, 1001, sizeof(int)), 1016);
+  ASSERT_EQ(policy::grow(1000, 1100, sizeof(int)), 1100);
+}
+
+TEST(VectorTest, allocate_at_least) {
+  sp::vector<safe, rounding_allocator<safe>> vec(5);
+  ASSERT_EQ(vec.capacity(), 8);
+  safe *ptr = vec.data();
+
+  for (int i = 0; i < 3; ++i) {
+    vec.emplace_back("pushed");
+  }
+  ASSERT_EQ(vec.size(), 8);
+  ASSERT_EQ(vec.data(), ptr);
+
+  vec.emplace_back("pushed");
+  ASSERT_EQ(vec.capacity(), 16);
+  vec.shrink_to_fit();
+  ASSERT_EQ(vec.capacity(), 16);
+  vec.reserve(17);
+  ASSERT_EQ(vec.capacity(), 24);
+}
+
+TEST(VectorTest, ranges) {
+  sp::vector<int> vec{5, 3, 1, 4, 2};
+  ASSERT_EQ(std::to_address(vec.begin()), vec.data());
+  ASSERT_EQ(std::to_address(vec.cend()), vec.data() + vec.size());
+  std::ranges::sort(vec);
+  ASSERT_EQ(vec, sp::vector<int>({1, 2, 3, 4, 5}));
+
+  std::span<const int> view(vec);
+  ASSERT_EQ(view.data(), vec.data());
+  ASSERT_EQ(static_cast<int64_t>(view.size()), vec.size());
+
+  sp::vector<int> copy(vec.size());
+  std::ranges::copy(vec | std::views::reverse, copy.begin());
+  ASSERT_EQ(copy, sp::vector<int>({5, 4, 3, 2, 1}));
+  ASSERT_EQ(std::ranges::find(vec, 4) - vec.cbegin(), 3);
+}
+
 TEST(VectorTest, stream) {
   sp::vector<safe> vec{
       safe("Aileen"), safe("Anna"), safe("Louie"), safe("Noel"),
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sp/work_stealing_deque.h"
+#include "test_helpers.h"
+
+TEST(WorkStealingDequeTest, ctor) {
+  sp::work_stealing_deque<int> deque;
+  ASSERT_EQ(deque.capacity(), 32);
+  ASSERT_TRUE(deque.empty());
+  sp::work_stealing_deque<int*> pointers(5);
+  ASSERT_EQ(pointers.capacity(), 8);
+  ASSERT_THROW(sp::work_stealing_deque<int>(0), std::length_error);
+}
+
+TEST(WorkStealingDequeTest, pop_lifo_steal_fifo) {
+  sp::work_stealing_deque<int> deque(4);
+  for (int i = 0; i < 6; ++i) {
+    deque.push(i);
+  }
+  ASSERT_EQ(deque.size(), 6);
+  int value = -1;
+  ASSERT_TRUE(deque.pop(value));
+  ASSERT_EQ(value, 5);
+  ASSERT_TRUE(deque.steal(value));
+  ASSERT_EQ(value, 0);
+  ASSERT_TRUE(deque.steal(value));
+  ASSERT_EQ(value, 1);
+  ASSERT_TRUE(deque.pop(value));
+  ASSERT_EQ(value, 4);
+  ASSERT_TRUE(deque.pop(value));
+  ASSERT_EQ(value, 3);
+  ASSERT_TRUE(deque.pop(value));
+  ASSERT_EQ(value, 2);
+  ASSERT_FALSE(deque.pop(value));
+  ASSERT_FALSE(deque.steal(value));
+  ASSERT_EQ(value, 2);
+  ASSERT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, grow_wrapped) {
+  sp::work_stealing_deque<int> deque(4);
+  int value = 0;
+  for (int i = 0; i < 3; ++i) {
+    deque.push(i);
+  }
+  ASSERT_TRUE(deque.steal(value));
+  ASSERT_TRUE(deque.steal(value));
+  for (int i = 3; i < 20; ++i) {
+    deque.push(i);
+  }
+  ASSERT_EQ(deque.capacity(), 32);
+  for (int i = 2; i < 20; ++i) {
+    ASSERT_TRUE(deque.steal(value));
+    ASSERT_EQ(value, i);
+  }
+  deque.reserve(100);
+  ASSERT_EQ(deque.capacity(), 128);
+}
+
+TEST(WorkStealingDequeTest, allocator) {
+  alloc_record record;
+  {
+    recording_allocator<int*> al(&record);
+    sp::work_stealing_deque<int*, recording_allocator<int*>> deque(2, al);
+    int values[20] = {};
+    for (int& value : values) {
+      deque.push(&value);
+    }
+    ASSERT_EQ(deque.capacity(), 32);
+    // slots and header of five buffers, replaced ones are kept
+    ASSERT_EQ(record.live, 10);
+    int* taken = nullptr;
+    for (int& value : values) {
+      ASSERT_TRUE(deque.steal(taken));
+      ASSERT_EQ(taken, &value);
+    }
+  }
+  ASSERT_EQ(record.live, 0);
+}
+
+TEST(WorkStealingDequeTest, threads) {
+  constexpr int kThieves = 3;
+  constexpr int kCount = 50000;
+  sp::work_stealing_deque<int> deque(8);
+  std::atomic<bool> done = false;
+  std::vector<std::vector<int>> taken(kThieves + 1);
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&deque, &done, &taken, t] {
+      int value = 0;
+      while (!done.load() || !deque.empty()) {
+        if (deque.steal(value)) {
+          taken[t].push_back(value);
+        }
+      }
+    });
+  }
+  int value = 0;
+  for (int i = 0; i < kCount; ++i) {
+    deque.push(i);
+    if (i % 3 == 0 && deque.pop(value)) {
+      taken[kThieves].push_back(value);
+    }
+  }
+  while (deque.pop(value)) {
+    taken[kThieves].push_back(value);
+  }
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  std::vector<int> all;
+  for (auto& part : taken) {
+    all.insert(all.end(), part.begin(), part.end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(static_cast<int>(all.size()), kCount);
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(all[i], i);
+  }
+}
@@ -108,8 +108,7 @@ class throwing : public tclass<Full> {
     return os;
   }
 
-  static int count;
+  static inline int count = 0;
 };
-int throwing::count = 0;
 
 #endif  // SP_TESTS_STANDART_TEST_HELPERS_H_